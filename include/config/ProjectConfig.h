@@ -3,8 +3,21 @@
 #include <Arduino.h>
 
 #include "sensors/LightSensorPair.h"
+#include "sensors/AdcDmaSampler.h"
+#include "sensors/AdcCalibratedResponse.h"
+#include "sensors/LdrCalibrator.h"
+#include "sensors/LdrResponse.h"
+#include "sensors/MuxIo.h"
+#include "sensors/MuxScanner.h"
+#include "drivers/CurrentMonitor.h"
 #include "drivers/MotorDriver.h"
+#include "sensors/CurrentSource.h"
+#include "sensors/Ina219CurrentSource.h"
+#include "track/RelayAutoTuner.h"
+#include "track/SunAcquisition.h"
+#include "track/SunEphemeris.h"
 #include "track/TrackerController.h"
+#include "track/TrackingCoordinator.h"
 #include "track/TravelGuard.h"
 #include "sensors/Dht11Sensor.h"
 #include "display/DisplayManager.h"
@@ -16,55 +29,273 @@ namespace ProjectConfig {
 // LDR pins (analog inputs)
 static const int LDR_H_PIN_A = 33;
 static const int LDR_H_PIN_B = 35;
+// Mux channels used instead when LIGHT_SAMPLER_USE_MUX is set
+static const int LDR_H_MUX_CH_A = 0;
+static const int LDR_H_MUX_CH_B = 1;
+static const bool LIGHT_SAMPLER_USE_MUX = false;
 
 // Motor driver pins (H-bridge inputs)
 static const int MOTOR_H_IN1_PIN = 16;
 static const int MOTOR_H_IN2_PIN = 17;
+// An axis without both motor pins is not built (IdleTrackingUnit in main).
+static const bool AXIS_H_ENABLED = MOTOR_H_IN1_PIN >= 0 && MOTOR_H_IN2_PIN >= 0;
 
 // Timing for light tracking (ms)
 static const unsigned long READ_INTERVAL_MS = 3;
 static const unsigned long ACTION_INTERVAL_MS = 120;
 static const unsigned long MOTOR_UPDATE_INTERVAL_MS = 30;
+// true: the motor ramp runs in the LEDC fade engine (programmed on target,
+// kick and take-up changes); false: ledcWrite every MOTOR_UPDATE_INTERVAL_MS.
+// On IDF 4.4 a change during a fade lands when that fade ends.
+static const bool MOTOR_USE_HW_FADE = false;
 static const unsigned long AUTO_BLOCK_DEADBAND_HOLD_MS = 1500;
 static const unsigned long AUTO_BLOCK_DURATION_MS = 10000;
-
-// Diff thresholds (percent). Deadband stops the motor target (0 PWM).
-static const float DIFF_DEADBAND_H = 1.0f;
-static const float DIFF_PWM_THRESHOLD_H = 15.0f;
+// Predictive block: unblock when the diff drift fitted while holding still
+// would reach the deadband edge (times the margin).
+static const bool AUTO_BLOCK_PREDICTIVE = true;
+static constexpr float AUTO_BLOCK_MARGIN = 0.8f;
+static constexpr float AUTO_BLOCK_DRIFT_SIGMA = 2.0f;
+static const unsigned long AUTO_BLOCK_MIN_MS = 2000;
+static const unsigned long AUTO_BLOCK_MAX_MS = 120000;
+
+// Vector: H and V diffs form one error with a radial deadband; the minor axis
+// is time-proportioned over TRACKING_VECTOR_PERIOD_MS so both arrive together.
+static const TrackingCoordinator::Mode TRACKING_MODE = TrackingCoordinator::Mode::Independent;
+static const unsigned long TRACKING_VECTOR_PERIOD_MS = 300;
+
+// Block: new diff every ACTION_INTERVAL_MS. Sliding: running window of the
+// same length, new diff on every read (partial windows carry lower confidence).
+static const LightSensorPair::WindowMode LIGHT_WINDOW_MODE =
+    LightSensorPair::WindowMode::Block;
+
+// Per-channel level estimator over the window. Median/TrimmedMean ignore
+// isolated ADC spikes; window is capped at LightSensorPair::MAX_WINDOW_SAMPLES.
+static const LightSensorPair::Estimator LIGHT_ESTIMATOR =
+    LightSensorPair::Estimator::Mean;
+static const uint8_t LIGHT_TRIM_PERCENT = 20; // TrimmedMean, per side
+
+// Diff domain. Raw: ADC counts (low-light tiers below tuned for this).
+// Linear: ADC-linearized millivolts. Log: log-illuminance through the LDR
+// divider (LDR on the supply side), brightness-independent diff.
+static const int LDR_SUPPLY_MV = 3300;
+static const int LDR_GAMMA_MILLI = 700; // LDR R ~ E^-gamma
+static const uint32_t ADC_DEFAULT_VREF_MV = 1100;
+typedef LdrResponse::Tables<LDR_SUPPLY_MV, LDR_GAMMA_MILLI> LDR_TABLES;
+static const LightSensorPair::Response LIGHT_RESPONSE =
+    LightSensorPair::Response::Raw;
+static constexpr const uint16_t* LIGHT_RESPONSE_TABLE =
+    (LIGHT_RESPONSE == LightSensorPair::Response::Log) ? LDR_TABLES::LOG
+    : (LIGHT_RESPONSE == LightSensorPair::Response::Linear) ? LDR_TABLES::LINEAR
+    : nullptr;
+// Adaptive LDR polling: up to LIGHT_MAX_READ_INTERVAL_MS while the diff is
+// stable, back to READ_INTERVAL_MS on change or motor motion (polling only).
+static const unsigned long LIGHT_MAX_READ_INTERVAL_MS = 24;
+static constexpr float LIGHT_STABLE_DIFF_PERCENT = 0.5f;
+static const uint8_t LIGHT_STABLE_WINDOWS = 4;
+
+// Indoor LED/fluorescent ripple rejection (100/120 Hz, auto-detected). With it
+// on, ACTION_INTERVAL_MS can be shortened without the diff drifting.
+static const bool LIGHT_FLICKER_REJECTION = false;
+static constexpr float LIGHT_FLICKER_DETECT_RATIO = 0.01f; // ripple / level
+
+// Rebuild the table at boot from eFuse ADC calibration when available.
+static const bool LIGHT_RESPONSE_USE_EFUSE = true;
+
+static const AdcCalibratedResponse::Config LIGHT_RESPONSE_CAL_CFG = {
+    LIGHT_RESPONSE,
+    LDR_SUPPLY_MV,
+    LDR_GAMMA_MILLI,
+    ADC_DEFAULT_VREF_MV
+};
 
 // Low-light adaptive deadband (percent, based on max(avg_a, avg_b) ADC counts):
 // <500 => 5%, <200 => 20%, <100 => 100%.
 static const uint32_t LOW_LIGHT_LEVEL_1 = 500;
-static const float LOW_LIGHT_DEADBAND_1_PERCENT = 5.0f;
+static constexpr float LOW_LIGHT_DEADBAND_1_PERCENT = 5.0f;
 static const uint32_t LOW_LIGHT_LEVEL_2 = 200;
-static const float LOW_LIGHT_DEADBAND_2_PERCENT = 20.0f;
+static constexpr float LOW_LIGHT_DEADBAND_2_PERCENT = 20.0f;
 static const uint32_t LOW_LIGHT_LEVEL_3 = 100;
-static const float LOW_LIGHT_DEADBAND_3_PERCENT = 100.0f;
+static constexpr float LOW_LIGHT_DEADBAND_3_PERCENT = 100.0f;
+
+// LDR mismatch calibration: fitted while ACTIVE_BLOCKED (both LDRs on target),
+// stored in NVS and applied at boot.
+static const bool LDR_CALIBRATION_ENABLED = false;
+static const uint16_t LDR_CALIBRATION_MIN_WINDOWS = 20;
+static constexpr float LDR_CALIBRATION_MIN_SPREAD = 0.05f; // fraction of level
+static constexpr float LDR_CALIBRATION_MAX_GAIN_ERROR = 0.15f;
+// Diffuse, bright light only: both LDRs above the first low-light level and
+// a steady diff within the window.
+static const uint32_t LDR_CALIBRATION_MIN_LEVEL = LOW_LIGHT_LEVEL_1;
+static constexpr float LDR_CALIBRATION_MAX_DIFF_VAR = 0.25f; // percent^2
+
+static const LdrCalibrator::Config LDR_CALIBRATION_CFG_H = {
+    "ldrcal",
+    "h",
+    LIGHT_RESPONSE,
+    LDR_CALIBRATION_MIN_WINDOWS,
+    LDR_CALIBRATION_MIN_SPREAD,
+    LDR_CALIBRATION_MAX_GAIN_ERROR,
+    LDR_CALIBRATION_MIN_LEVEL,
+    LDR_CALIBRATION_MAX_DIFF_VAR
+};
+
+static const LdrCalibrator::Config LDR_CALIBRATION_CFG_V = {
+    "ldrcal",
+    "v",
+    LIGHT_RESPONSE,
+    LDR_CALIBRATION_MIN_WINDOWS,
+    LDR_CALIBRATION_MIN_SPREAD,
+    LDR_CALIBRATION_MAX_GAIN_ERROR,
+    LDR_CALIBRATION_MIN_LEVEL,
+    LDR_CALIBRATION_MAX_DIFF_VAR
+};
+
+// Diff thresholds (percent). Deadband stops the motor target (0 PWM).
+static constexpr float DIFF_DEADBAND_H = 1.0f;
+static constexpr float DIFF_PWM_THRESHOLD_H = 15.0f;
+
+// Deadband mode. Statistical replaces the tiers above with
+// max(DIFF_DEADBAND, k * sigma_diff / sqrt(n)) measured in every window.
+static const TrackerController::DeadbandMode DEADBAND_MODE =
+    TrackerController::DeadbandMode::Tiered;
+static constexpr float DEADBAND_SIGMA_K = 3.0f;
+
+// Control mode. Pid replaces the two-speed BangBang output; gains are per
+// axis below, the illuminance schedule is shared.
+static const TrackerController::ControlMode CONTROL_MODE =
+    TrackerController::ControlMode::BangBang;
+static const uint32_t PID_SCHEDULE_DARK_LEVEL = LOW_LIGHT_LEVEL_1;
+static const uint32_t PID_SCHEDULE_BRIGHT_LEVEL = 2000;
+static constexpr float PID_DARK_GAIN_SCALE = 0.5f;
+
+// Kalman offset estimator: controller acts on the filtered offset and its
+// uncertainty. Motor gain is the diff change rate (%/s) at full PWM, per axis.
+static const bool KALMAN_ENABLED = false;
+static constexpr float KALMAN_Q_OFFSET = 0.5f;   // %^2/s
+static constexpr float KALMAN_Q_DRIFT = 0.01f;   // (%/s)^2/s
+static constexpr float KALMAN_GATE_SIGMA = 6.0f;
+static constexpr float KALMAN_R_MIN = 0.01f;     // %^2
+static constexpr float KALMAN_SIGMA_K = 1.0f;
+static constexpr float KALMAN_MOTOR_GAIN_H = 8.0f;
+
+// Cloud/transient hold: freeze motion while the summed LDR level moves fast,
+// dips below its baseline or the diff variance jumps; resume on a fresh window.
+static const bool TRANSIENT_HOLD_ENABLED = false;
+static constexpr float TRANSIENT_MAX_LEVEL_RATE = 0.5f;  // fraction of level per s
+static constexpr float TRANSIENT_DIP_RATIO = 0.3f;
+static constexpr float TRANSIENT_VAR_RATIO = 9.0f;
+static constexpr float TRANSIENT_BASELINE_TAU_S = 60.0f;
+static const unsigned long TRANSIENT_SETTLE_MS = 2000;
+static const unsigned long TRANSIENT_MAX_HOLD_MS = 120000;
+
+static constexpr TransientDetector::Config TRANSIENT_CFG = {
+    TRANSIENT_HOLD_ENABLED,
+    TRANSIENT_MAX_LEVEL_RATE,
+    TRANSIENT_DIP_RATIO,
+    TRANSIENT_VAR_RATIO,
+    TRANSIENT_BASELINE_TAU_S,
+    TRANSIENT_SETTLE_MS,
+    TRANSIENT_MAX_HOLD_MS
+};
+
+// Gear backlash: slack crossed at BACKLASH_TAKEUP_NORM after each reversal,
+// per axis in motor-on ms (0 = none until learned). Learning compares the
+// diff response latency of reversing moves against same-direction moves.
+static const bool BACKLASH_LEARN_ENABLED = false;
+static constexpr float BACKLASH_TAKEUP_NORM = 0.8f;        // 0..1, near MOTOR_PWM_MIN_NORM
+static constexpr float BACKLASH_MIN_CHANGE_PERCENT = 0.5f; // Below the deadband
+static constexpr float BACKLASH_LEARN_RATE = 0.25f;
+static const unsigned long BACKLASH_MAX_MS = 3000;
+
+static constexpr BacklashEstimator::Config BACKLASH_CFG = {
+    BACKLASH_LEARN_ENABLED,
+    BACKLASH_MIN_CHANGE_PERCENT,
+    BACKLASH_LEARN_RATE,
+    BACKLASH_MAX_MS
+};
+
+// Hunting: HUNTING_MIN_REVERSALS target reversals within HUNTING_WINDOW_MS
+// widen that axis' deadband by a step that decays back over time.
+static const bool HUNTING_DETECT_ENABLED = false;
+static const unsigned long HUNTING_WINDOW_MS = 2000;
+static const uint8_t HUNTING_MIN_REVERSALS = 4;
+static constexpr float HUNTING_BOOST_STEP_PERCENT = 0.5f;
+static constexpr float HUNTING_MAX_BOOST_PERCENT = 5.0f;
+static constexpr float HUNTING_DECAY_PERCENT_PER_S = 0.02f;
+
+static constexpr HuntingDetector::Config HUNTING_CFG = {
+    HUNTING_DETECT_ENABLED,
+    HUNTING_WINDOW_MS,
+    HUNTING_MIN_REVERSALS,
+    HUNTING_BOOST_STEP_PERCENT,
+    HUNTING_MAX_BOOST_PERCENT,
+    HUNTING_DECAY_PERCENT_PER_S
+};
+
+// Relay auto-tune (serial "tune", or long press while ACTIVE_BLOCKED):
+// identifies each axis at MOTOR_PWM_MIN_NORM and replaces deadband, PWM
+// threshold, PID gains and motor smoothing. Results live in NVS and are
+// applied at boot.
+static const bool AUTOTUNE_ENABLED = false;
+static constexpr float AUTOTUNE_HYSTERESIS_PERCENT = 1.0f;
+static const uint8_t AUTOTUNE_CYCLES = 4;
+static const unsigned long AUTOTUNE_TIMEOUT_MS = 180000;
+
+static constexpr float PID_KP_H = 0.06f;  // norm per percent
+static constexpr float PID_KI_H = 0.02f;  // norm per percent*s
+static constexpr float PID_KD_H = 0.01f;  // norm per percent/s
+
+// Ephemeris feedforward: H follows the sun azimuth. Axis speed at
+// MOTOR_PWM_MIN_NORM_H, measured on the mount; 0 disables.
+static constexpr float FF_DEG_PER_S_AT_MIN_H = 0.0f;
+static const int FF_DIRECTION_H = +1; // Motor sign for increasing azimuth
 
 // PWM config (normalized min/max, 0..1)
 static const int MOTOR_PWM_FREQ_H = 20000;
 static const int MOTOR_PWM_RES_BITS_H = 8;
 static const int MOTOR_PWM_CH_IN1_H = 0;
 static const int MOTOR_PWM_CH_IN2_H = 1;
-static const float MOTOR_PWM_MIN_NORM_H = 0.8f; // 0..1
-static const float MOTOR_PWM_MAX_NORM_H = 0.99f; // 0..1
-static const float MOTOR_PWM_SMOOTH_H = 0.8f;   // 0..1 (0 = instant, 1 = very smooth)
-static const float MOTOR_PWM_KICK_NORM_H = 0.8f; // 0..1
+static constexpr float MOTOR_PWM_MIN_NORM_H = 0.8f; // 0..1
+static constexpr float MOTOR_PWM_MAX_NORM_H = 0.99f; // 0..1
+static constexpr float MOTOR_PWM_SMOOTH_H = 0.8f;   // 0..1 (0 = instant, 1 = very smooth)
+static constexpr float MOTOR_PWM_KICK_NORM_H = 0.8f; // 0..1
 static const unsigned long MOTOR_PWM_KICK_MS_H = 200;
+static const unsigned long MOTOR_BACKLASH_MS_H = 0; // Initial, see BACKLASH_*
+// Duty profile, see MotorDriver::Profile. Exponential follows
+// MOTOR_PWM_SMOOTH_H (and the autotuner's motor_smooth); the other profiles
+// ignore it and use the rates below, in duty (0..1) per second. The
+// start-torque step uses MOTOR_PWM_KICK_*_H.
+static const MotorDriver::Profile MOTOR_PROFILE_H = MotorDriver::Profile::Exponential;
+static constexpr float MOTOR_ACCEL_NORM_PER_S_H = 2.0f;
+static constexpr float MOTOR_DECEL_NORM_PER_S_H = 20.0f;
+static constexpr float MOTOR_JERK_NORM_PER_S2_H = 400.0f;
 
 // Logging toggle for H tracking
 static const bool LOG_H_ENABLED = true;
 
+// The axis configs are template arguments of main's StaticTrackingUnit, so
+// they are constexpr with external linkage. Only main.cpp includes this file.
+
 // Light sensor pair configuration (H)
-static const LightSensorPair::Config SENSOR_CFG_H = {
-    LDR_H_PIN_A,
-    LDR_H_PIN_B,
+extern constexpr LightSensorPair::Config SENSOR_CFG_H = {
+    LIGHT_SAMPLER_USE_MUX ? LDR_H_MUX_CH_A : LDR_H_PIN_A,
+    LIGHT_SAMPLER_USE_MUX ? LDR_H_MUX_CH_B : LDR_H_PIN_B,
     READ_INTERVAL_MS,
-    ACTION_INTERVAL_MS
+    ACTION_INTERVAL_MS,
+    LIGHT_WINDOW_MODE,
+    LIGHT_ESTIMATOR,
+    LIGHT_TRIM_PERCENT,
+    LIGHT_RESPONSE,
+    LIGHT_RESPONSE_TABLE,
+    LIGHT_MAX_READ_INTERVAL_MS,
+    LIGHT_STABLE_DIFF_PERCENT,
+    LIGHT_STABLE_WINDOWS,
+    LIGHT_FLICKER_REJECTION,
+    LIGHT_FLICKER_DETECT_RATIO
 };
 
 // Tracking controller configuration (H)
-static const TrackerController::Config TRACKER_CFG_H = {
+extern constexpr TrackerController::Config TRACKER_CFG_H = {
     DIFF_DEADBAND_H,
     DIFF_PWM_THRESHOLD_H,
     MOTOR_PWM_MIN_NORM_H,
@@ -74,11 +305,33 @@ static const TrackerController::Config TRACKER_CFG_H = {
     LOW_LIGHT_LEVEL_2,
     LOW_LIGHT_DEADBAND_2_PERCENT,
     LOW_LIGHT_LEVEL_3,
-    LOW_LIGHT_DEADBAND_3_PERCENT
+    LOW_LIGHT_DEADBAND_3_PERCENT,
+    DEADBAND_MODE,
+    DEADBAND_SIGMA_K,
+    CONTROL_MODE,
+    PID_KP_H,
+    PID_KI_H,
+    PID_KD_H,
+    PID_SCHEDULE_DARK_LEVEL,
+    PID_SCHEDULE_BRIGHT_LEVEL,
+    PID_DARK_GAIN_SCALE,
+    FF_DEG_PER_S_AT_MIN_H,
+    KALMAN_ENABLED,
+    {
+        KALMAN_MOTOR_GAIN_H,
+        KALMAN_Q_OFFSET,
+        KALMAN_Q_DRIFT,
+        KALMAN_GATE_SIGMA
+    },
+    KALMAN_R_MIN,
+    KALMAN_SIGMA_K,
+    TRANSIENT_CFG,
+    BACKLASH_CFG,
+    HUNTING_CFG
 };
 
 // Motor driver configuration (H)
-static const MotorDriver::Config MOTOR_CFG_H = {
+extern constexpr MotorDriver::Config MOTOR_CFG_H = {
     MOTOR_H_IN1_PIN,
     MOTOR_H_IN2_PIN,
     MOTOR_PWM_FREQ_H,
@@ -88,48 +341,93 @@ static const MotorDriver::Config MOTOR_CFG_H = {
     MOTOR_PWM_SMOOTH_H,
     MOTOR_UPDATE_INTERVAL_MS,
     MOTOR_PWM_KICK_NORM_H,
-    MOTOR_PWM_KICK_MS_H
+    MOTOR_PWM_KICK_MS_H,
+    BACKLASH_TAKEUP_NORM,
+    MOTOR_BACKLASH_MS_H,
+    MOTOR_PROFILE_H,
+    MOTOR_ACCEL_NORM_PER_S_H,
+    MOTOR_DECEL_NORM_PER_S_H,
+    MOTOR_JERK_NORM_PER_S2_H
+};
+
+static const RelayAutoTuner::Config AUTOTUNE_CFG_H = {
+    "autotune",
+    "h",
+    MOTOR_PWM_MIN_NORM_H,
+    AUTOTUNE_HYSTERESIS_PERCENT,
+    AUTOTUNE_CYCLES,
+    AUTOTUNE_TIMEOUT_MS,
+    MOTOR_UPDATE_INTERVAL_MS
 };
 
 //! ----- Tracking V axis (Vertical) -----
 // LDR pins (analog inputs) - set to H if you want to mirror for testing
 static const int LDR_V_PIN_A = 32;
 static const int LDR_V_PIN_B = 34;
+static const int LDR_V_MUX_CH_A = 2;
+static const int LDR_V_MUX_CH_B = 3;
 
 // Motor driver pins (H-bridge inputs)
 static const int MOTOR_V_IN1_PIN = -1;
 static const int MOTOR_V_IN2_PIN = -1;
+static const bool AXIS_V_ENABLED = MOTOR_V_IN1_PIN >= 0 && MOTOR_V_IN2_PIN >= 0;
 
 // Timing for light tracking uses global values above.
 
 // Diff thresholds (percent). Deadband stops the motor target (0 PWM).
-static const float DIFF_DEADBAND_V = 1.0f;
-static const float DIFF_PWM_THRESHOLD_V = 10.0f;
+static constexpr float DIFF_DEADBAND_V = 1.0f;
+static constexpr float DIFF_PWM_THRESHOLD_V = 10.0f;
+
+// PID gains (CONTROL_MODE == Pid)
+static constexpr float PID_KP_V = 0.09f;
+static constexpr float PID_KI_V = 0.02f;
+static constexpr float PID_KD_V = 0.01f;
+
+// Ephemeris feedforward: V follows the sun elevation.
+static constexpr float FF_DEG_PER_S_AT_MIN_V = 0.0f;
+static const int FF_DIRECTION_V = +1; // Motor sign for increasing elevation
+
+static constexpr float KALMAN_MOTOR_GAIN_V = 8.0f;
 
 // PWM config (normalized min/max, 0..1)
 static const int MOTOR_PWM_FREQ_V = 20000;
 static const int MOTOR_PWM_RES_BITS_V = 8;
 static const int MOTOR_PWM_CH_IN1_V = 2;
 static const int MOTOR_PWM_CH_IN2_V = 3;
-static const float MOTOR_PWM_MIN_NORM_V = 0.8f; // 0..1
-static const float MOTOR_PWM_MAX_NORM_V = 0.99f; // 0..1
-static const float MOTOR_PWM_SMOOTH_V = 0.8f;   // 0..1 (0 = instant, 1 = very smooth)
-static const float MOTOR_PWM_KICK_NORM_V = 0.8f; // 0..1
+static constexpr float MOTOR_PWM_MIN_NORM_V = 0.8f; // 0..1
+static constexpr float MOTOR_PWM_MAX_NORM_V = 0.99f; // 0..1
+static constexpr float MOTOR_PWM_SMOOTH_V = 0.8f;   // 0..1 (0 = instant, 1 = very smooth)
+static constexpr float MOTOR_PWM_KICK_NORM_V = 0.8f; // 0..1
 static const unsigned long MOTOR_PWM_KICK_MS_V = 200;
+static const unsigned long MOTOR_BACKLASH_MS_V = 0; // Initial, see BACKLASH_*
+static const MotorDriver::Profile MOTOR_PROFILE_V = MotorDriver::Profile::Exponential;
+static constexpr float MOTOR_ACCEL_NORM_PER_S_V = 2.0f;
+static constexpr float MOTOR_DECEL_NORM_PER_S_V = 20.0f;
+static constexpr float MOTOR_JERK_NORM_PER_S2_V = 400.0f;
 
 // Logging toggle for V tracking
 static const bool LOG_V_ENABLED = true;
 
 // Light sensor pair configuration (V)
-static const LightSensorPair::Config SENSOR_CFG_V = {
-    LDR_V_PIN_A,
-    LDR_V_PIN_B,
+extern constexpr LightSensorPair::Config SENSOR_CFG_V = {
+    LIGHT_SAMPLER_USE_MUX ? LDR_V_MUX_CH_A : LDR_V_PIN_A,
+    LIGHT_SAMPLER_USE_MUX ? LDR_V_MUX_CH_B : LDR_V_PIN_B,
     READ_INTERVAL_MS,
-    ACTION_INTERVAL_MS
+    ACTION_INTERVAL_MS,
+    LIGHT_WINDOW_MODE,
+    LIGHT_ESTIMATOR,
+    LIGHT_TRIM_PERCENT,
+    LIGHT_RESPONSE,
+    LIGHT_RESPONSE_TABLE,
+    LIGHT_MAX_READ_INTERVAL_MS,
+    LIGHT_STABLE_DIFF_PERCENT,
+    LIGHT_STABLE_WINDOWS,
+    LIGHT_FLICKER_REJECTION,
+    LIGHT_FLICKER_DETECT_RATIO
 };
 
 // Tracking controller configuration (V)
-static const TrackerController::Config TRACKER_CFG_V = {
+extern constexpr TrackerController::Config TRACKER_CFG_V = {
     DIFF_DEADBAND_V,
     DIFF_PWM_THRESHOLD_V,
     MOTOR_PWM_MIN_NORM_V,
@@ -139,11 +437,33 @@ static const TrackerController::Config TRACKER_CFG_V = {
     LOW_LIGHT_LEVEL_2,
     LOW_LIGHT_DEADBAND_2_PERCENT,
     LOW_LIGHT_LEVEL_3,
-    LOW_LIGHT_DEADBAND_3_PERCENT
+    LOW_LIGHT_DEADBAND_3_PERCENT,
+    DEADBAND_MODE,
+    DEADBAND_SIGMA_K,
+    CONTROL_MODE,
+    PID_KP_V,
+    PID_KI_V,
+    PID_KD_V,
+    PID_SCHEDULE_DARK_LEVEL,
+    PID_SCHEDULE_BRIGHT_LEVEL,
+    PID_DARK_GAIN_SCALE,
+    FF_DEG_PER_S_AT_MIN_V,
+    KALMAN_ENABLED,
+    {
+        KALMAN_MOTOR_GAIN_V,
+        KALMAN_Q_OFFSET,
+        KALMAN_Q_DRIFT,
+        KALMAN_GATE_SIGMA
+    },
+    KALMAN_R_MIN,
+    KALMAN_SIGMA_K,
+    TRANSIENT_CFG,
+    BACKLASH_CFG,
+    HUNTING_CFG
 };
 
 // Motor driver configuration (V)
-static const MotorDriver::Config MOTOR_CFG_V = {
+extern constexpr MotorDriver::Config MOTOR_CFG_V = {
     MOTOR_V_IN1_PIN,
     MOTOR_V_IN2_PIN,
     MOTOR_PWM_FREQ_V,
@@ -153,7 +473,74 @@ static const MotorDriver::Config MOTOR_CFG_V = {
     MOTOR_PWM_SMOOTH_V,
     MOTOR_UPDATE_INTERVAL_MS,
     MOTOR_PWM_KICK_NORM_V,
-    MOTOR_PWM_KICK_MS_V
+    MOTOR_PWM_KICK_MS_V,
+    BACKLASH_TAKEUP_NORM,
+    MOTOR_BACKLASH_MS_V,
+    MOTOR_PROFILE_V,
+    MOTOR_ACCEL_NORM_PER_S_V,
+    MOTOR_DECEL_NORM_PER_S_V,
+    MOTOR_JERK_NORM_PER_S2_V
+};
+
+static const RelayAutoTuner::Config AUTOTUNE_CFG_V = {
+    "autotune",
+    "v",
+    MOTOR_PWM_MIN_NORM_V,
+    AUTOTUNE_HYSTERESIS_PERCENT,
+    AUTOTUNE_CYCLES,
+    AUTOTUNE_TIMEOUT_MS,
+    MOTOR_UPDATE_INTERVAL_MS
+};
+
+//! ----- LDR acquisition (shared by H and V) -----
+// true: scan all LDR pins through the I2S/ADC DMA engine at a fixed hardware
+// rate. false: poll analogRead() every READ_INTERVAL_MS from loop().
+static const bool LIGHT_SAMPLER_USE_DMA = false;
+static const uint32_t LIGHT_SAMPLER_RATE_HZ = 4000; // Total, split across pins
+static const int LIGHT_SAMPLER_DMA_BUF_COUNT = 8;
+static const int LIGHT_SAMPLER_DMA_BUF_LEN = 256;
+
+static const AdcDmaSampler::Config LIGHT_SAMPLER_CFG = {
+    {LDR_H_PIN_A, LDR_H_PIN_B, LDR_V_PIN_A, LDR_V_PIN_B},
+    LIGHT_SAMPLER_RATE_HZ,
+    LIGHT_SAMPLER_DMA_BUF_COUNT,
+    LIGHT_SAMPLER_DMA_BUF_LEN
+};
+
+// External 8/16-channel analog mux (CD74HC4067 / 4051). Takes precedence
+// over DMA; pairs then address mux channels (LDR_x_MUX_CH_y).
+static const int MUX_PIN_S0 = 25;
+static const int MUX_PIN_S1 = 26;
+static const int MUX_PIN_S2 = 14;
+static const int MUX_PIN_S3 = 12;
+static const int MUX_PIN_SIG = 36;
+static const uint16_t MUX_SETTLE_US = 20;
+static const uint32_t MUX_FRAME_RATE_HZ = 500;
+
+static const GpioMuxIo::Config MUX_IO_CFG = {
+    {MUX_PIN_S0, MUX_PIN_S1, MUX_PIN_S2, MUX_PIN_S3},
+    MUX_PIN_SIG
+};
+
+static const MuxScanner::Config MUX_SCANNER_CFG = {
+    (uint16_t)((1U << LDR_H_MUX_CH_A) | (1U << LDR_H_MUX_CH_B) |
+               (1U << LDR_V_MUX_CH_A) | (1U << LDR_V_MUX_CH_B)),
+    MUX_SETTLE_US,
+    MUX_FRAME_RATE_HZ
+};
+
+//! ----- Sun ephemeris (feedforward) -----
+// Site and RTC: set the clock over serial with "time=<unix seconds UTC>";
+// the ESP32 RTC keeps it through deep sleep.
+static const bool SUN_FEEDFORWARD_ENABLED = false;
+static constexpr float SITE_LATITUDE_DEG = 40.4168f;
+static constexpr float SITE_LONGITUDE_DEG = -3.7038f;
+static const unsigned long SUN_FEEDFORWARD_UPDATE_MS = 1000;
+static constexpr float SUN_MIN_ELEVATION_DEG = 0.0f; // No feedforward below this
+
+static const SunEphemeris::Config SUN_EPHEMERIS_CFG = {
+    SITE_LATITUDE_DEG,
+    SITE_LONGITUDE_DEG
 };
 
 //! ----- Deep sleep config -----
@@ -168,9 +555,9 @@ static const int TFT_PIN_BLK = 27;
 static const bool TFT_BLK_ACTIVE_HIGH = true;
 static const int TFT_PIN_CS = -1; 
 static const unsigned long TFT_REFRESH_INTERVAL_MS = 30;
-static const float DISPLAY_DEADBAND_PERCENT =
+static constexpr float DISPLAY_DEADBAND_PERCENT =
     (DIFF_DEADBAND_H > DIFF_DEADBAND_V) ? DIFF_DEADBAND_H : DIFF_DEADBAND_V;
-static const float DISPLAY_PWM_THRESHOLD_PERCENT =
+static constexpr float DISPLAY_PWM_THRESHOLD_PERCENT =
     (DIFF_PWM_THRESHOLD_H > DIFF_PWM_THRESHOLD_V) ? DIFF_PWM_THRESHOLD_H : DIFF_PWM_THRESHOLD_V;
 
 // Display configuration
@@ -183,8 +570,8 @@ static const DisplayManager::Config DISPLAY_CFG = {
 };
 
 // Battery (mock for now)
-static const float BATTERY_PERCENT_MOCK = 80.0f;
-static const float SOLAR_PERCENT_MOCK = 45.0f;
+static constexpr float BATTERY_PERCENT_MOCK = 80.0f;
+static constexpr float SOLAR_PERCENT_MOCK = 45.0f;
 static const bool SOLAR_CHARGING_MOCK = true;
 
 //! ----- DHT11 config -----
@@ -218,6 +605,81 @@ static const TouchButton::Config TOUCH_BUTTON_CFG = {
     TOUCH_BUTTON_LONG_PRESS_MS
 };
 
+//! ----- Motor current sensing (optional, per axis) -----
+// Shunt + amplifier on an ADC1 pin, or an INA219 on I2C in the motor supply.
+// A stall cuts the drive in that direction; on V it also stands in for the
+// endstop being driven toward (TRAVEL_GUARD_*).
+static const bool CURRENT_SENSE_ENABLED_H = false;
+static const bool CURRENT_SENSE_ENABLED_V = false;
+static const bool CURRENT_SENSE_USE_INA219 = false;
+
+static const int CURRENT_SHUNT_PIN_H = 39;
+static const int CURRENT_SHUNT_PIN_V = 36;
+static constexpr float CURRENT_SHUNT_OHMS = 0.1f;
+static constexpr float CURRENT_SHUNT_GAIN = 10.0f;
+static constexpr float CURRENT_SHUNT_ZERO_MV = 0.0f;
+static const uint8_t CURRENT_INA219_ADDR_H = 0x40;
+static const uint8_t CURRENT_INA219_ADDR_V = 0x41;
+static const uint16_t CURRENT_INA219_CONFIG = 0x399F;
+
+// Measured on the mount: locked-rotor current at full duty.
+static constexpr float CURRENT_STALL_AMPS = 2.0f;
+static constexpr float CURRENT_STALL_RATIO = 0.8f;
+static const unsigned long CURRENT_STALL_MS = 300; // > start-up surge
+static constexpr float CURRENT_LIMIT_AMPS = 1.5f;      // 0 disables
+static constexpr float CURRENT_LIMIT_RECOVER_PER_S = 0.5f;
+static constexpr float CURRENT_SUPPLY_VOLTS = 12.0f;
+static constexpr float CURRENT_FILTER_ALPHA = 0.5f;
+
+static const ShuntAdcCurrentSource::Config CURRENT_SHUNT_CFG_H = {
+    CURRENT_SHUNT_PIN_H,
+    CURRENT_SHUNT_OHMS,
+    CURRENT_SHUNT_GAIN,
+    CURRENT_SHUNT_ZERO_MV
+};
+
+static const ShuntAdcCurrentSource::Config CURRENT_SHUNT_CFG_V = {
+    CURRENT_SHUNT_PIN_V,
+    CURRENT_SHUNT_OHMS,
+    CURRENT_SHUNT_GAIN,
+    CURRENT_SHUNT_ZERO_MV
+};
+
+static const Ina219CurrentSource::Config CURRENT_INA219_CFG_H = {
+    CURRENT_INA219_ADDR_H,
+    CURRENT_SHUNT_OHMS,
+    CURRENT_INA219_CONFIG
+};
+
+static const Ina219CurrentSource::Config CURRENT_INA219_CFG_V = {
+    CURRENT_INA219_ADDR_V,
+    CURRENT_SHUNT_OHMS,
+    CURRENT_INA219_CONFIG
+};
+
+static const CurrentMonitor::Config CURRENT_MONITOR_CFG = {
+    CURRENT_STALL_AMPS,
+    CURRENT_STALL_RATIO,
+    CURRENT_STALL_MS,
+    CURRENT_LIMIT_AMPS,
+    CURRENT_LIMIT_RECOVER_PER_S,
+    CURRENT_SUPPLY_VOLTS,
+    CURRENT_FILTER_ALPHA
+};
+
+// Shunts are read with analogReadMilliVolts(). The DMA light sampler owns
+// ADC1 (GPIO 32..39) while it runs, and with the mux MUX_PIN_SIG carries the
+// LDRs; use CURRENT_SENSE_USE_INA219 with either.
+constexpr bool shuntConflicts(bool enabled, int pin) {
+    return enabled && !CURRENT_SENSE_USE_INA219 &&
+           (LIGHT_SAMPLER_USE_MUX ? (pin == MUX_PIN_SIG)
+                                  : (LIGHT_SAMPLER_USE_DMA && pin >= 32 && pin <= 39));
+}
+static_assert(!shuntConflicts(CURRENT_SENSE_ENABLED_H, CURRENT_SHUNT_PIN_H),
+              "CURRENT_SHUNT_PIN_H is in use by the light sampler");
+static_assert(!shuntConflicts(CURRENT_SENSE_ENABLED_V, CURRENT_SHUNT_PIN_V),
+              "CURRENT_SHUNT_PIN_V is in use by the light sampler");
+
 //! ----- Travel guard (NC endstops) -----
 // NC switches with pull-up: pressed/open circuit -> HIGH on input.
 static const int TRAVEL_GUARD_PIN_1 = 5;
@@ -225,7 +687,7 @@ static const int TRAVEL_GUARD_PIN_2 = 22;
 static const bool TRAVEL_GUARD_ACTIVE_HIGH = true;
 static const bool TRAVEL_GUARD_USE_PULLUP = true;
 static const unsigned long TRAVEL_GUARD_DEBOUNCE_MS = 25;
-static const float TRAVEL_GUARD_SWEEP_NORM = MOTOR_PWM_MAX_NORM_V;
+static constexpr float TRAVEL_GUARD_SWEEP_NORM = MOTOR_PWM_MAX_NORM_V;
 static const int TRAVEL_GUARD_DIR_FROM_PIN_1 = +1; // When pin 1 is hit, move towards pin 2
 static const int TRAVEL_GUARD_DIR_FROM_PIN_2 = -1; // When pin 2 is hit, move towards pin 1
 
@@ -240,6 +702,35 @@ static const TravelGuard::Config TRAVEL_GUARD_CFG = {
     TRAVEL_GUARD_DIR_FROM_PIN_2
 };
 
+// Sun acquisition (V): when the LDRs stay dark for SUN_ACQUISITION_LOST_MS
+// (and the ephemeris, if the clock is set, says the sun is up), drive to
+// pin 1, let the TravelGuard sweep cross the travel, return to the brightest
+// point. Serial "acquire" starts a search by hand.
+static const bool SUN_ACQUISITION_ENABLED = false;
+static constexpr float SUN_ACQUISITION_SEEK_NORM = MOTOR_PWM_MAX_NORM_V;
+static const uint32_t SUN_ACQUISITION_LOST_LEVEL = LOW_LIGHT_LEVEL_2;
+static const unsigned long SUN_ACQUISITION_LOST_MS = 60000;
+static const unsigned long SUN_ACQUISITION_RETRY_MS = 900000;
+static const uint32_t SUN_ACQUISITION_MIN_PEAK_LEVEL = LOW_LIGHT_LEVEL_1;
+static const unsigned long SUN_ACQUISITION_TIMEOUT_MS = 120000;
+
+static const SunAcquisition::Config SUN_ACQUISITION_CFG = {
+    SUN_ACQUISITION_ENABLED,
+    SUN_ACQUISITION_SEEK_NORM,
+    -TRAVEL_GUARD_DIR_FROM_PIN_1,
+    SUN_ACQUISITION_LOST_LEVEL,
+    SUN_ACQUISITION_LOST_MS,
+    SUN_ACQUISITION_RETRY_MS,
+    SUN_ACQUISITION_MIN_PEAK_LEVEL,
+    SUN_ACQUISITION_TIMEOUT_MS
+};
+
+//! ----- Diagnostics -----
+// Print CPU cycles per TrackingUnit tick (last / max since the previous line).
+// Compare builds with and without -DSATELLITE_FIXED_POINT=1.
+static const bool LOG_TICK_CYCLES_ENABLED = false;
+static const unsigned long LOG_TICK_CYCLES_INTERVAL_MS = 5000;
+
 } // namespace ProjectConfig
 
 
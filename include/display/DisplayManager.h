@@ -131,6 +131,11 @@ public:
         }
     }
 
+    void setReadIntervalMs(unsigned long interval_ms) {
+        read_interval_ms_ = interval_ms;
+        dirty_ = true;
+    }
+
     void setBlocked(bool blocked) {
         blocked_ = blocked;
         dirty_ = true;
@@ -244,6 +249,7 @@ private:
         drawPwmGauges(8, 94, 38, 14);
         drawActiveIndicator(200, 88);
         drawBlockedIndicator(200, 110);
+        drawReadIntervalIndicator(200, 132);
         drawEnvBlock(10, 200);
         force_full_redraw_ = false;
     }
@@ -464,6 +470,27 @@ private:
         last_blocked_ = blocked_;
     }
 
+    void drawReadIntervalIndicator(int x, int y) {
+        if (!force_full_redraw_ && read_interval_ms_ == last_read_interval_ms_) {
+            return;
+        }
+
+        const int size = 18;
+        const uint16_t bg = colPanel();
+        const uint16_t color = colTextDim();
+
+        char label[4];
+        snprintf(label, sizeof(label), "%lu", min(read_interval_ms_, 999UL));
+        tft_.fillRect(x, y, size, size, bg);
+        tft_.drawRect(x, y, size, size, colLine());
+        tft_.setTextDatum(MC_DATUM);
+        tft_.setTextColor(color, bg);
+        tft_.drawString(label, x + size / 2, y + size / 2, 1);
+        tft_.setTextDatum(TL_DATUM);
+
+        last_read_interval_ms_ = read_interval_ms_;
+    }
+
     void drawEnvBlock(int x, int y) {
         if (!force_full_redraw_ &&
             temp_c_ == last_temp_c_ &&
@@ -672,6 +699,8 @@ private:
     bool last_blocked_ = false;
     bool active_ = false;
     bool last_active_ = false;
+    unsigned long read_interval_ms_ = 0;
+    unsigned long last_read_interval_ms_ = 0xFFFFFFFFUL;
     float battery_percent_ = 60.0f;
     float last_battery_percent_ = -1.0f;
     unsigned long last_tick_ms_ = 0;
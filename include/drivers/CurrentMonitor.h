@@ -0,0 +1,146 @@
+#pragma once
+
+#include "util/Platform.h"
+
+#include "sensors/CurrentSource.h"
+
+// Motor current per axis, sampled by MotorDriver once per update right after
+// the duty is written, so each reading belongs to a known duty.
+//
+// Stall: the motor current stays at or above stall_ratio of the locked-rotor
+// current for the applied duty (duty x stall_amps) for stall_ms. Back-EMF
+// keeps a turning motor well below that, so the test holds at any duty and
+// under the current limit. stall_ms must outlast the start-up surge. A stall
+// latches with the drive direction until MotorDriver sees a target that does
+// not push the same way.
+// Limit: above limit_amps the duty cap drops in proportion, then recovers at
+// limit_recover_per_s.
+// Energy: supply volts x supply current, integrated per move (non-zero duty
+// to zero duty).
+class CurrentMonitor {
+public:
+    struct Config {
+        float stall_amps;  // Locked rotor at full duty
+        float stall_ratio; // 0 disables stall detection
+        unsigned long stall_ms;
+        float limit_amps;  // 0 disables the limit
+        float limit_recover_per_s;
+        float supply_volts;
+        float filter_alpha; // Per sample, 1 = raw
+    };
+
+    CurrentMonitor(const Config& cfg, CurrentSource& source)
+        : cfg_(cfg),
+          source_(source) {}
+
+    void begin() { source_.begin(); }
+
+    void sample(unsigned long now_ms, float applied_norm) {
+        const float dt_s = (last_ms_ != 0) ? ((float)(now_ms - last_ms_) / 1000.0f) : 0.0f;
+        last_ms_ = now_ms;
+        const float duty = fabsf(applied_norm);
+        const int sign = (applied_norm > 0.0f) - (applied_norm < 0.0f);
+
+        if (sign == 0) {
+            endMove();
+            amps_ = 0.0f;
+            stall_since_ms_ = 0;
+            recoverCap(dt_s);
+            return;
+        }
+
+        float reading = 0.0f;
+        if (!source_.read(reading)) {
+            return;
+        }
+        reads_++;
+        // Below a few percent duty the averaged reading says little about the
+        // winding current; take it as is.
+        const bool averaged = source_.averagesPwm();
+        const float motor = (averaged && duty > MIN_DIVIDE_DUTY) ? (reading / duty) : reading;
+        const float supply = averaged ? reading : (reading * duty);
+        const float alpha = constrain(cfg_.filter_alpha, 0.0f, 1.0f);
+        amps_ = moving_ ? (amps_ + (alpha * (motor - amps_))) : motor;
+        moving_ = true;
+        move_joules_ += cfg_.supply_volts * supply * dt_s;
+        move_peak_amps_ = max(move_peak_amps_, amps_);
+
+        if (cfg_.limit_amps > 0.0f && amps_ > cfg_.limit_amps) {
+            cap_ = min(cap_, duty * (cfg_.limit_amps / amps_));
+            limited_samples_++;
+        } else {
+            recoverCap(dt_s);
+        }
+
+        const bool stalled_now = cfg_.stall_ratio > 0.0f && cfg_.stall_amps > 0.0f &&
+                                 amps_ >= (cfg_.stall_ratio * duty * cfg_.stall_amps);
+        if (!stalled_now || sign != stall_dir_) {
+            stall_since_ms_ = 0;
+            stall_dir_ = sign;
+        }
+        if (!stalled_now) {
+            return;
+        }
+        if (stall_since_ms_ == 0) {
+            stall_since_ms_ = max(now_ms, 1UL);
+        } else if (stall_sign_ == 0 && (now_ms - stall_since_ms_) >= cfg_.stall_ms) {
+            stall_sign_ = sign;
+            stalls_++;
+        }
+    }
+
+    // Largest duty magnitude MotorDriver may apply (1 without limiting).
+    float dutyCap() const { return cap_; }
+    // Drive direction of a latched stall, 0 when none.
+    int stallSign() const { return stall_sign_; }
+    void clearStall() {
+        stall_sign_ = 0;
+        stall_since_ms_ = 0;
+    }
+
+    float amps() const { return amps_; }
+    float moveJoules() const { return move_joules_; }
+    float lastMoveJoules() const { return last_move_joules_; }
+    float lastMovePeakAmps() const { return last_move_peak_amps_; }
+    uint32_t moves() const { return moves_; }
+    uint32_t stalls() const { return stalls_; }
+    uint32_t limitedSamples() const { return limited_samples_; }
+    uint32_t reads() const { return reads_; }
+
+private:
+    static constexpr float MIN_DIVIDE_DUTY = 0.05f;
+
+    void endMove() {
+        if (!moving_) {
+            return;
+        }
+        moving_ = false;
+        last_move_joules_ = move_joules_;
+        last_move_peak_amps_ = move_peak_amps_;
+        move_joules_ = 0.0f;
+        move_peak_amps_ = 0.0f;
+        moves_++;
+    }
+
+    void recoverCap(float dt_s) {
+        cap_ = min(cap_ + (cfg_.limit_recover_per_s * dt_s), 1.0f);
+    }
+
+    Config cfg_;
+    CurrentSource& source_;
+    unsigned long last_ms_ = 0;
+    float amps_ = 0.0f;
+    float cap_ = 1.0f;
+    bool moving_ = false;
+    float move_joules_ = 0.0f;
+    float move_peak_amps_ = 0.0f;
+    float last_move_joules_ = 0.0f;
+    float last_move_peak_amps_ = 0.0f;
+    unsigned long stall_since_ms_ = 0;
+    int stall_dir_ = 0;
+    int stall_sign_ = 0;
+    uint32_t moves_ = 0;
+    uint32_t stalls_ = 0;
+    uint32_t limited_samples_ = 0;
+    uint32_t reads_ = 0;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdint.h>
+
+// When the fade last started on each LEDC channel ends, and the one call held
+// back until then. A call made while the channel fades replaces any held one;
+// a call issued once the fade has ended drops it.
+class FadeSchedule {
+public:
+    static const uint8_t CHANNEL_COUNT = 16;
+
+    bool busy(uint8_t channel, unsigned long now_ms) const {
+        const Channel& ch = channels_[channel];
+        return ch.fade_ms > 0 && (now_ms - ch.start_ms) < ch.fade_ms;
+    }
+
+    // Fading, or a call held for the fade's end.
+    bool pending(uint8_t channel, unsigned long now_ms) const {
+        return channels_[channel].held || busy(channel, now_ms);
+    }
+
+    void issued(uint8_t channel, unsigned long now_ms, uint32_t fade_ms) {
+        Channel& ch = channels_[channel];
+        ch.start_ms = now_ms;
+        ch.fade_ms = fade_ms;
+        ch.held = false;
+    }
+
+    void hold(uint8_t channel, uint32_t duty, uint32_t fade_ms) {
+        Channel& ch = channels_[channel];
+        ch.held = true;
+        ch.held_duty = duty;
+        ch.held_fade_ms = fade_ms;
+        holds_++;
+    }
+
+    // The first held call whose channel has finished fading, removed.
+    bool takeDue(unsigned long now_ms, uint8_t* channel, uint32_t* duty, uint32_t* fade_ms) {
+        for (uint8_t i = 0; i < CHANNEL_COUNT; ++i) {
+            Channel& ch = channels_[i];
+            if (ch.held && !busy(i, now_ms)) {
+                ch.held = false;
+                *channel = i;
+                *duty = ch.held_duty;
+                *fade_ms = ch.held_fade_ms;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t holds() const { return holds_; }
+
+private:
+    struct Channel {
+        unsigned long start_ms = 0;
+        uint32_t fade_ms = 0;
+        bool held = false;
+        uint32_t held_duty = 0;
+        uint32_t held_fade_ms = 0;
+    };
+
+    Channel channels_[CHANNEL_COUNT];
+    uint32_t holds_ = 0;
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <Arduino.h>
+#include <driver/ledc.h>
+
+#include "drivers/FadeSchedule.h"
+#include "drivers/PwmOutput.h"
+
+// LEDC channels driven through the IDF fade engine: fade() programs the
+// ramp and returns, the hardware steps the duty on its own. Channels keep
+// the Arduino 2 numbering (0-7 high-speed group, 8-15 low-speed group), so
+// ledcSetup/ledcAttachPin still configure timer and pin.
+//
+// On IDF 4.4 every duty or fade call waits for a fade still running on the
+// channel, and there is no call to stop one. A call made during a fade is
+// held instead and issued from tick() once the fade has ended, so loop()
+// never waits; a zero duty lands when it would have after the IDF wait.
+class LedcFadePwmOutput : public PwmOutput {
+public:
+    // Fades end a step or two after the requested time.
+    static const uint32_t FADE_MARGIN_MS = 2;
+
+    void setup(uint8_t channel, uint32_t freq_hz, uint8_t res_bits, int pin) override {
+        ledcSetup(channel, freq_hz, res_bits);
+        if (pin >= 0) {
+            ledcAttachPin(pin, channel);
+        }
+        if (!fade_installed_) {
+            fade_installed_ = ledc_fade_func_install(0) == ESP_OK;
+        }
+    }
+
+    void write(uint8_t channel, uint32_t duty) override {
+        if (!fade_installed_ || channel >= FadeSchedule::CHANNEL_COUNT) {
+            ledcWrite(channel, duty);
+            return;
+        }
+        const unsigned long now_ms = millis();
+        if (schedule_.busy(channel, now_ms)) {
+            schedule_.hold(channel, duty, 0);
+            return;
+        }
+        ledc_set_duty_and_update(speedMode(channel), channelNum(channel), duty, 0);
+        schedule_.issued(channel, now_ms, 0);
+    }
+
+    void fade(uint8_t channel, uint32_t duty, uint32_t ms) override {
+        if (!fade_installed_ || ms == 0 || channel >= FadeSchedule::CHANNEL_COUNT) {
+            write(channel, duty);
+            return;
+        }
+        const unsigned long now_ms = millis();
+        if (schedule_.busy(channel, now_ms)) {
+            schedule_.hold(channel, duty, ms);
+            return;
+        }
+        ledc_set_fade_with_time(speedMode(channel), channelNum(channel), duty, (int)ms);
+        ledc_fade_start(speedMode(channel), channelNum(channel), LEDC_FADE_NO_WAIT);
+        schedule_.issued(channel, now_ms, ms + FADE_MARGIN_MS);
+    }
+
+    void tick(unsigned long now_ms) override {
+        uint8_t channel;
+        uint32_t duty;
+        uint32_t ms;
+        while (schedule_.takeDue(now_ms, &channel, &duty, &ms)) {
+            fade(channel, duty, ms);
+        }
+    }
+
+    bool hasFade() const override { return fade_installed_; }
+
+    bool isFading(uint8_t channel) const override {
+        return fade_installed_ && channel < FadeSchedule::CHANNEL_COUNT &&
+               schedule_.pending(channel, millis());
+    }
+
+    // Calls made during a running fade and issued after it.
+    uint32_t heldCalls() const { return schedule_.holds(); }
+
+private:
+    static ledc_mode_t speedMode(uint8_t channel) {
+        return (channel < 8) ? LEDC_HIGH_SPEED_MODE : LEDC_LOW_SPEED_MODE;
+    }
+
+    static ledc_channel_t channelNum(uint8_t channel) {
+        return (ledc_channel_t)(channel % 8);
+    }
+
+    bool fade_installed_ = false;
+    FadeSchedule schedule_;
+};
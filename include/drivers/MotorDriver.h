@@ -1,9 +1,31 @@
 #pragma once
 
-#include <Arduino.h>
+#include "util/Platform.h"
 
-class MotorDriver {
+#include "drivers/CurrentMonitor.h"
+#include "drivers/PwmOutput.h"
+#include "util/ConfigRef.h"
+#include "util/FixedPoint.h"
+
+// Types every BasicMotorDriver shares, whatever its config.
+class MotorDriverTypes {
 public:
+    // Exponential: IIR toward the target once per update (smooth), with the
+    // kick overdrive on starts and reversals.
+    // Trapezoidal: the duty moves at accel_norm_per_s while its magnitude
+    // grows and decel_norm_per_s while it shrinks, scaled by the real time
+    // between updates. SCurve: the same limits reached through
+    // jerk_norm_per_s2, easing into the target.
+    // In both profiles the kick becomes a start-torque phase: from
+    // standstill the duty steps to kick_norm for kick_duration_ms and the
+    // profile carries on from there. A reversal decelerates to standstill
+    // first. A new target mid-move continues from the current duty and rate.
+    enum class Profile {
+        Exponential,
+        Trapezoidal,
+        SCurve
+    };
+
     struct Config {
         int in1_pin;
         int in2_pin;
@@ -15,125 +37,179 @@ public:
         unsigned long update_interval_ms;
         float kick_norm; // 0..1
         unsigned long kick_duration_ms;
+        // Gear backlash: after a reversal the slack is crossed at takeup_norm
+        // for backlash_ms of motor-on time before the normal output (and the
+        // kick, now against the load) resumes. 0 disables.
+        float backlash_takeup_norm; // 0..1
+        unsigned long backlash_ms;
+        Profile profile;
+        float accel_norm_per_s;
+        float decel_norm_per_s;
+        float jerk_norm_per_s2;
     };
 
-    explicit MotorDriver(const Config& cfg)
-        : cfg_(cfg) {
-        pwm_range_ = (1UL << cfg_.pwm_res_bits) - 1UL;
+};
+
+// One H-bridge axis. The config comes from the constructor (MotorDriver) or
+// is a constexpr object named as C, see ConfigRef.
+template <const MotorDriverTypes::Config* C = nullptr>
+class BasicMotorDriver : public MotorDriverTypes {
+public:
+    // Without an output the driver writes through the Arduino LEDC calls.
+    // With a fade-capable output the ramp is programmed into the peripheral
+    // once per change of target, kick or take-up; the filter keeps running
+    // as the model of the applied duty but does not write.
+    // With a current monitor the duty is capped by its limit and cut while a
+    // stall is latched in the target's direction.
+    explicit BasicMotorDriver(const Config& cfg,
+                         PwmOutput* output = nullptr,
+                         CurrentMonitor* current = nullptr)
+        : cfg_(cfg),
+          output_((output != nullptr) ? output : &ledc_output_),
+          current_(current) {
+        pwm_range_ = (1UL << cfg.pwm_res_bits) - 1UL;
+        setSmooth(cfg.smooth);
+        kick_ = fromFloat(constrain(cfg.kick_norm, 0.0f, 1.0f));
+        takeup_ = fromFloat(constrain(cfg.backlash_takeup_norm, 0.0f, 1.0f));
+        backlash_ms_ = cfg.backlash_ms;
+        accel_rate_ = rateFromFloat(fabsf(cfg.accel_norm_per_s));
+        decel_rate_ = rateFromFloat(fabsf(cfg.decel_norm_per_s));
+        jerk_rate_ = rateFromFloat(cfg.jerk_norm_per_s2);
     }
 
     void begin() {
-        ledcSetup(cfg_.pwm_channel_in1, cfg_.pwm_freq, cfg_.pwm_res_bits);
-        ledcSetup(cfg_.pwm_channel_in2, cfg_.pwm_freq, cfg_.pwm_res_bits);
-        if (cfg_.in1_pin >= 0) {
-            ledcAttachPin(cfg_.in1_pin, cfg_.pwm_channel_in1);
-            has_in1_ = true;
-            ledcWrite(cfg_.pwm_channel_in1, 0);
-        }
-        if (cfg_.in2_pin >= 0) {
-            ledcAttachPin(cfg_.in2_pin, cfg_.pwm_channel_in2);
-            has_in2_ = true;
-            ledcWrite(cfg_.pwm_channel_in2, 0);
+        output_->setup(cfg().pwm_channel_in1, cfg().pwm_freq, cfg().pwm_res_bits, cfg().in1_pin);
+        output_->setup(cfg().pwm_channel_in2, cfg().pwm_freq, cfg().pwm_res_bits, cfg().in2_pin);
+        fade_ = output_->hasFade();
+        writeChannel(0, 0, true);
+        writeChannel(1, 0, true);
+        if (current_ != nullptr) {
+            current_->begin();
         }
     }
 
     void setTargetNormalized(float signed_norm) {
-        const float next = constrain(signed_norm, -1.0f, 1.0f);
-        if (next == 0.0f) {
-            target_norm_ = 0.0f;
-            last_target_sign_ = 0;
-            return;
-        }
+        setTarget(fromFloat(constrain(signed_norm, -1.0f, 1.0f)));
+    }
 
-        const int next_sign = (next > 0.0f) ? 1 : -1;
-        if (last_target_sign_ != 0 && next_sign != last_target_sign_) {
-            kick_pending_ = true;
-        } else if (target_norm_ == 0.0f) {
-            kick_pending_ = true;
-        }
+    void setTargetQ15(int32_t signed_q15) {
+        setTarget(fromQ15(Q15::saturate(signed_q15)));
+    }
 
-        last_target_sign_ = next_sign;
-        target_norm_ = next;
+    void setSmooth(float smooth) {
+        const float s = constrain(smooth, 0.0f, 1.0f);
+        alpha_ = fromFloat(1.0f - s);
+        // Hardware ramp: the filter's time constant, 3 tau to the target.
+        const float dt_ms = (float)max(cfg().update_interval_ms, 1UL);
+        ramp_tau_ms_ = (s > 0.0f && s < 1.0f) ? (-dt_ms / logf(s)) : 0.0f;
     }
 
+    // A restart in the direction last driven within ms of the stop skips the
+    // kick and the start torque: time-proportioned drive (vector mode) pulses
+    // an axis that is still turning. 0 kicks on every start.
+    void setKickHoldoffMs(unsigned long ms) { kick_holdoff_ms_ = ms; }
+
     void setEnabled(bool enabled) {
         if (enabled_ == enabled) {
             return;
         }
         enabled_ = enabled;
         if (!enabled_) {
-            filtered_norm_ = 0.0f;
-            last_applied_norm_ = 0.0f;
+            filtered_ = 0;
+            last_applied_ = 0;
             last_pwm_raw_ = 0;
             kick_pending_ = false;
             kick_active_until_ms_ = 0;
-            if (has_in1_) {
-                ledcWrite(cfg_.pwm_channel_in1, 0);
-            }
-            if (has_in2_) {
-                ledcWrite(cfg_.pwm_channel_in2, 0);
-            }
-        } else if (target_norm_ != 0.0f) {
+            takeup_active_ = false;
+            profile_rate_ = 0;
+            start_until_ms_ = 0;
+            writeChannel(0, 0, true);
+            writeChannel(1, 0, true);
+            hw_sign_ = 0;
+        } else if (target_ != 0) {
             kick_pending_ = true;
         }
     }
 
     void tick(unsigned long now_ms) {
+        output_->tick(now_ms);
         if (!enabled_) {
             return;
         }
-        if (cfg_.update_interval_ms > 0 &&
-            (now_ms - last_update_ms_) < cfg_.update_interval_ms) {
+        if (cfg().update_interval_ms > 0 &&
+            (now_ms - last_update_ms_) < cfg().update_interval_ms) {
             return;
         }
+        const unsigned long elapsed_ms = (last_update_ms_ != 0) ? (now_ms - last_update_ms_) : 0;
+        if (last_pwm_raw_ != 0) {
+            motor_on_ms_ += elapsed_ms;
+            duty_q15_ms_ += (uint64_t)elapsed_ms * (uint32_t)toQ15(absNorm(last_applied_));
+        }
         last_update_ms_ = now_ms;
 
-        if (kick_pending_ && target_norm_ != 0.0f) {
-            kick_active_until_ms_ = now_ms + cfg_.kick_duration_ms;
-            kick_pending_ = false;
+        // The slack is only crossed while driving; a stop keeps what is left.
+        const bool was_taking_up = takeup_active_;
+        if (takeup_active_) {
+            takeup_remaining_ms_ -= min(elapsed_ms, takeup_remaining_ms_);
+        }
+        takeup_active_ = target_ != 0 && takeup_remaining_ms_ > 0 && takeup_ > 0;
+        if (takeup_active_) {
+            const Norm mag = min(takeup_, absNorm(target_));
+            filtered_ = (target_ > 0) ? mag : -mag;
         }
 
-        const float smooth = constrain(cfg_.smooth, 0.0f, 1.0f);
-        const float alpha = 1.0f - smooth;
-        filtered_norm_ += (target_norm_ - filtered_norm_) * alpha;
-
-        float applied_norm = filtered_norm_;
-        if (cfg_.kick_duration_ms > 0 && now_ms < kick_active_until_ms_) {
-            const float kick = constrain(cfg_.kick_norm, 0.0f, 1.0f);
-            if (kick > 0.0f) {
-                const float sign = (target_norm_ >= 0.0f) ? 1.0f : -1.0f;
-                applied_norm = sign * max(kick, fabsf(filtered_norm_));
+        bool stepped = false;
+        if (cfg().profile != Profile::Exponential) {
+            stepped = profileTick(now_ms, elapsed_ms, was_taking_up && !takeup_active_);
+        } else {
+            if (kick_pending_ && target_ != 0 && !takeup_active_) {
+                kick_active_until_ms_ = now_ms + cfg().kick_duration_ms;
+                kick_pending_ = false;
             }
+            filtered_ += filterStep(target_ - filtered_);
         }
 
-        const float mag = fabsf(applied_norm);
-        last_pwm_raw_ = (uint32_t)constrain(
-            (int)lroundf(mag * (float)pwm_range_), 0, (int)pwm_range_);
+        Norm applied = filtered_;
 
-        if (applied_norm > 0.0f) {
-            if (has_in1_) {
-                ledcWrite(cfg_.pwm_channel_in1, last_pwm_raw_);
-            }
-            if (has_in2_) {
-                ledcWrite(cfg_.pwm_channel_in2, 0);
-            }
-        } else if (applied_norm < 0.0f) {
-            if (has_in1_) {
-                ledcWrite(cfg_.pwm_channel_in1, 0);
-            }
-            if (has_in2_) {
-                ledcWrite(cfg_.pwm_channel_in2, last_pwm_raw_);
-            }
+        if (takeup_active_) {
+            applied = (target_ > 0) ? takeup_ : -takeup_;
+            stepped = true;
+        } else if (cfg().profile == Profile::Exponential && cfg().kick_duration_ms > 0 &&
+                   now_ms < kick_active_until_ms_ && kick_ > 0) {
+            const Norm mag = max(kick_, absNorm(filtered_));
+            applied = (target_ >= 0) ? mag : -mag;
+            stepped = true;
+        }
+        if (current_ != nullptr) {
+            const Norm unlimited = applied;
+            applied = limitByCurrent(applied);
+            stepped = stepped || (applied != unlimited);
+        }
+
+        last_pwm_raw_ = toDuty(absNorm(applied));
+
+        const uint32_t start_cycles = Platform::cycleCount();
+        const uint32_t start_writes = output_writes_;
+        if (fade_) {
+            driveFaded(applied, stepped);
+        } else if (applied > 0) {
+            writeChannel(0, last_pwm_raw_, true);
+            writeChannel(1, 0, true);
+        } else if (applied < 0) {
+            writeChannel(0, 0, true);
+            writeChannel(1, last_pwm_raw_, true);
         } else {
-            if (has_in1_) {
-                ledcWrite(cfg_.pwm_channel_in1, 0);
-            }
-            if (has_in2_) {
-                ledcWrite(cfg_.pwm_channel_in2, 0);
-            }
+            writeChannel(0, 0, true);
+            writeChannel(1, 0, true);
+        }
+        if (output_writes_ != start_writes) {
+            output_cycles_ += Platform::cycleCount() - start_cycles;
         }
 
-        last_applied_norm_ = applied_norm;
+        last_applied_ = applied;
+        if (current_ != nullptr) {
+            current_->sample(now_ms, toFloat(applied));
+        }
     }
 
     uint32_t normToRaw(float norm) const {
@@ -141,22 +217,339 @@ public:
         return (uint32_t)lroundf(n * (float)pwm_range_);
     }
 
-    float getFilteredNorm() const { return filtered_norm_; }
-    float getAppliedNorm() const { return last_applied_norm_; }
+    float getFilteredNorm() const { return toFloat(filtered_); }
+    float getAppliedNorm() const { return toFloat(last_applied_); }
+    int32_t getAppliedQ15() const { return toQ15(last_applied_); }
+    bool isDriving() const { return last_applied_ != 0; }
+    bool isEnabled() const { return enabled_; }
+    // Direction changes (even across a stop) and time spent with a non-zero duty.
+    uint32_t reversalCount() const { return reversals_; }
+    uint32_t motorOnMs() const { return motor_on_ms_; }
+    // Integral of |applied norm| over time (ms at full duty): an energy proxy.
+    uint32_t motorDutyMs() const { return (uint32_t)(duty_q15_ms_ >> 15); }
     uint32_t getAppliedPwmRaw() const { return last_pwm_raw_; }
 
+    // Slack in motor-on ms at the take-up norm; applies from the next reversal.
+    void setBacklashMs(uint32_t ms) { backlash_ms_ = ms; }
+    uint32_t backlashMs() const { return backlash_ms_; }
+    bool isTakingUpBacklash() const { return takeup_active_; }
+
+    // PWM peripheral calls (writes and fade programs) and the CPU cycles
+    // spent in them.
+    uint32_t outputWrites() const { return output_writes_; }
+    uint32_t outputCycles() const { return output_cycles_; }
+    bool usesHardwareFade() const { return fade_; }
+
+    // Drive direction of a latched stall, 0 when none or without a monitor.
+    int stallSign() const { return (current_ != nullptr) ? current_->stallSign() : 0; }
+    const CurrentMonitor* currentMonitor() const { return current_; }
+
 private:
-    Config cfg_;
+    // Internal representation of a signed normalized value: float, or Q15 in
+    // the fixed-point build. Conversions happen at the API edges only.
+#if SATELLITE_FIXED_POINT
+    typedef int32_t Norm;
+
+    static Norm fromFloat(float v) { return Q15::fromFloat(v); }
+    static Norm fromQ15(int32_t q) { return q; }
+    static float toFloat(Norm v) { return Q15::toFloat(v); }
+    static int32_t toQ15(Norm v) { return v; }
+    static Norm absNorm(Norm v) { return Q15::magnitude(v); }
+
+    Norm filterStep(Norm error) const {
+        const Norm step = Q15::mul(error, alpha_);
+        // Never stall short of the target on rounding (e.g. motor never idle).
+        if (step == 0 && error != 0 && alpha_ != 0) {
+            return (error > 0) ? 1 : -1;
+        }
+        return step;
+    }
+
+    uint32_t toDuty(Norm mag) const {
+        const uint32_t duty =
+            (uint32_t)((((uint64_t)mag * pwm_range_) + (Q15::ONE / 2)) >> 15);
+        return min(duty, pwm_range_);
+    }
+
+    // Profile rates are Q15 per second (per second squared for jerk) and may
+    // exceed 1.0, so they are not saturated.
+    static Norm rateFromFloat(float rate) {
+        return (Norm)lroundf(min(max(rate, 0.0f), 60000.0f) * (float)Q15::ONE);
+    }
+
+    // rate * ms / 1000, rounded.
+    static Norm perInterval(Norm rate, unsigned long ms) {
+        const int64_t scaled = (int64_t)rate * (int64_t)ms;
+        return (Norm)((scaled + ((scaled >= 0) ? 500 : -500)) / 1000);
+    }
+
+    // Distance covered while the jerk limit brings rate to zero.
+    Norm stopDistance(Norm rate) const {
+        const int64_t d = ((int64_t)rate * rate) / (2 * (int64_t)jerk_rate_);
+        return (Norm)min(d, (int64_t)INT32_MAX);
+    }
+#else
+    typedef float Norm;
+
+    static Norm fromFloat(float v) { return v; }
+    static Norm fromQ15(int32_t q) { return Q15::toFloat(q); }
+    static float toFloat(Norm v) { return v; }
+    static int32_t toQ15(Norm v) { return Q15::fromFloat(v); }
+    static Norm absNorm(Norm v) { return fabsf(v); }
+
+    Norm filterStep(Norm error) const { return error * alpha_; }
+
+    uint32_t toDuty(Norm mag) const {
+        return (uint32_t)constrain(
+            (int)lroundf(mag * (float)pwm_range_), 0, (int)pwm_range_);
+    }
+
+    static Norm rateFromFloat(float rate) { return max(rate, 0.0f); }
+
+    static Norm perInterval(Norm rate, unsigned long ms) {
+        return rate * ((float)ms / 1000.0f);
+    }
+
+    Norm stopDistance(Norm rate) const { return (rate * rate) / (2.0f * jerk_rate_); }
+#endif
+
+    static int signOf(Norm v) { return (v > 0) - (v < 0); }
+
+    // Channel 0 is in1 (positive drive), 1 is in2. Unforced writes skip a
+    // duty the channel already has or is fading to.
+    void writeChannel(int index, uint32_t duty, bool force, uint32_t fade_ms = 0) {
+        if (((index == 0) ? cfg().in1_pin : cfg().in2_pin) < 0) {
+            return;
+        }
+        if (!force && duty == channel_duty_[index]) {
+            return;
+        }
+        const uint8_t channel = (index == 0) ? cfg().pwm_channel_in1 : cfg().pwm_channel_in2;
+        if (fade_ms > 0) {
+            output_->fade(channel, duty, fade_ms);
+        } else {
+            output_->write(channel, duty);
+        }
+        channel_duty_[index] = duty;
+        output_writes_++;
+    }
+
+    // Kick and take-up levels are written as steps. Toward the target the
+    // driven input is faded down first on a reversal (the filter model says
+    // when it crosses zero), then the new input fades up. An input is only
+    // driven once the other has finished fading down.
+    void driveFaded(Norm applied, bool stepped) {
+        const int drive_index = (signOf(applied) > 0) ? 0 : 1;
+        if (stepped) {
+            writeChannel(1 - drive_index, 0, false);
+            if (last_pwm_raw_ == 0 || !inputFading(1 - drive_index)) {
+                writeChannel(drive_index, last_pwm_raw_, false);
+                hw_sign_ = signOf(applied);
+            }
+            return;
+        }
+
+        const int goal_sign = signOf(target_);
+        if (hw_sign_ != 0 && goal_sign != hw_sign_) {
+            if (signOf(applied) == hw_sign_) {
+                const float x = toFloat(absNorm(applied));
+                const float y = toFloat(absNorm(target_));
+                float down_ms = (y > 0.0f) ? (ramp_tau_ms_ * logf(1.0f + (x / y)))
+                                           : (RAMP_TAUS * ramp_tau_ms_);
+                if (cfg().profile != Profile::Exponential) {
+                    down_ms = rampMs(x, fabsf(cfg().decel_norm_per_s));
+                }
+                writeChannel((hw_sign_ > 0) ? 0 : 1, 0, false, fadeMs(down_ms));
+                return;
+            }
+            writeChannel((hw_sign_ > 0) ? 0 : 1, 0, false);
+            hw_sign_ = 0;
+        }
+        if (goal_sign == 0) {
+            return;
+        }
+        const int index = (goal_sign > 0) ? 0 : 1;
+        if (hw_sign_ != goal_sign && inputFading(1 - index)) {
+            return;
+        }
+        float up_ms = RAMP_TAUS * ramp_tau_ms_;
+        if (cfg().profile != Profile::Exponential) {
+            // Linear is the trapezoid's own shape; the S-curve rounds its ends.
+            const float from = toFloat(absNorm(applied));
+            const float to = toFloat(absNorm(target_));
+            up_ms = rampMs(fabsf(to - from),
+                           fabsf((to >= from) ? cfg().accel_norm_per_s : cfg().decel_norm_per_s));
+        }
+        writeChannel(1 - index, 0, false);
+        writeChannel(index, toDuty(absNorm(target_)), false, fadeMs(up_ms));
+        hw_sign_ = goal_sign;
+    }
+
+    bool inputFading(int index) const {
+        return output_->isFading((index == 0) ? cfg().pwm_channel_in1 : cfg().pwm_channel_in2);
+    }
+
+    Norm limitByCurrent(Norm applied) {
+        const int stall = current_->stallSign();
+        if (stall != 0 && signOf(target_) != stall) {
+            current_->clearStall();
+        } else if (stall != 0) {
+            // Restart from standstill (start torque) once released.
+            filtered_ = 0;
+            profile_rate_ = 0;
+            start_until_ms_ = 0;
+            return 0;
+        }
+        const Norm cap = fromFloat(current_->dutyCap());
+        if (absNorm(applied) <= cap) {
+            return applied;
+        }
+        return (applied > 0) ? cap : -cap;
+    }
+
+    static float rampMs(float delta, float rate) {
+        return (rate > 0.0f) ? ((delta / rate) * 1000.0f) : 0.0f;
+    }
+
+    // One step per motor update, in Norm (Q15 in the fixed build). Returns
+    // true while the start-torque step is held. The take-up leaves the duty
+    // at takeup_norm, not standstill, so its end starts the step explicitly.
+    bool profileTick(unsigned long now_ms, unsigned long elapsed_ms, bool takeup_done) {
+        kick_pending_ = false;
+        const Norm v = filtered_;
+        const int target_sign = signOf(target_);
+
+        if (start_until_ms_ != 0) {
+            if (now_ms < start_until_ms_ && target_sign == signOf(v)) {
+                return true;
+            }
+            start_until_ms_ = 0;
+        }
+        if ((v == 0 || takeup_done) && target_sign != 0 && !resume_ && kick_ > 0 &&
+            cfg().kick_duration_ms > 0) {
+            filtered_ = (target_sign > 0) ? kick_ : -kick_;
+            profile_rate_ = 0;
+            start_until_ms_ = max(now_ms + cfg().kick_duration_ms, 1UL);
+            return true;
+        }
+
+        const Norm error = target_ - v;
+        if (error == 0 || elapsed_ms == 0) {
+            return false;
+        }
+        // Toward standstill first on a reversal: v -> 0 uses the decel limit.
+        const bool growing = (v == 0) || ((v > 0) == (error > 0));
+        const Norm limit = growing ? accel_rate_ : decel_rate_;
+        const Norm goal = (signOf(v) * target_sign < 0) ? 0 : target_;
+        const Norm remaining = goal - v;
+        const bool up = remaining > 0;
+
+        Norm rate = up ? limit : -limit;
+        if (cfg().profile == Profile::SCurve && jerk_rate_ > 0) {
+            // Ease off once the rate could only just be brought to zero in
+            // the distance left.
+            const bool same_way = (profile_rate_ > 0) == up;
+            const Norm wanted =
+                (same_way && stopDistance(profile_rate_) >= absNorm(remaining)) ? 0 : rate;
+            const Norm step = perInterval(jerk_rate_, elapsed_ms);
+            rate = (wanted > profile_rate_) ? min(profile_rate_ + step, wanted)
+                                            : max(profile_rate_ - step, wanted);
+            if (up ? (rate <= 0) : (rate >= 0)) {
+                // Never stall short of the goal.
+                rate = up ? min(step, limit) : -min(step, limit);
+            }
+        }
+
+        Norm next = v + perInterval(rate, elapsed_ms);
+        if ((up && next >= goal) || (!up && next <= goal)) {
+            next = goal;
+            rate = 0;
+        }
+        profile_rate_ = rate;
+        filtered_ = next;
+        return false;
+    }
+
+    static uint32_t fadeMs(float ms) { return (ms > 0.0f) ? (uint32_t)lroundf(ms) : 0; }
+
+    void setTarget(Norm next) {
+        if (next == 0) {
+            // A stop ends the kick: it must not outlast a short command.
+            if (target_ != 0) {
+                stop_ms_ = last_update_ms_;
+            }
+            target_ = 0;
+            last_target_sign_ = 0;
+            kick_active_until_ms_ = 0;
+            return;
+        }
+
+        const int next_sign = (next > 0) ? 1 : -1;
+        if (last_target_sign_ != 0 && next_sign != last_target_sign_) {
+            kick_pending_ = true;
+            resume_ = false;
+        } else if (target_ == 0) {
+            resume_ = kick_holdoff_ms_ > 0 && next_sign == last_drive_sign_ &&
+                      (last_update_ms_ - stop_ms_) < kick_holdoff_ms_;
+            kick_pending_ = !resume_;
+        }
+
+        if (last_drive_sign_ != 0 && next_sign != last_drive_sign_) {
+            reversals_++;
+            // Reversing mid take-up only has to cross back what was crossed.
+            const uint32_t crossed = (backlash_ms_ > takeup_remaining_ms_)
+                ? (backlash_ms_ - takeup_remaining_ms_)
+                : 0;
+            takeup_remaining_ms_ = (takeup_remaining_ms_ > 0) ? crossed : backlash_ms_;
+        }
+        last_drive_sign_ = next_sign;
+        last_target_sign_ = next_sign;
+        target_ = next;
+    }
+
+    static constexpr float RAMP_TAUS = 3.0f;
+
+    const Config& cfg() const { return cfg_.get(); }
+
+    ConfigRef<Config, C> cfg_;
+    LedcPwmOutput ledc_output_;
+    PwmOutput* output_;
+    CurrentMonitor* current_;
+    bool fade_ = false;
+    float ramp_tau_ms_ = 0.0f;
+    unsigned long start_until_ms_ = 0;
+    uint32_t channel_duty_[2] = {0, 0};
+    int hw_sign_ = 0;
+    uint32_t output_writes_ = 0;
+    uint32_t output_cycles_ = 0;
     unsigned long last_update_ms_ = 0;
     uint32_t pwm_range_ = 255;
-    float target_norm_ = 0.0f;
-    float filtered_norm_ = 0.0f;
-    float last_applied_norm_ = 0.0f;
+    Norm alpha_ = 0;
+    Norm kick_ = 0;
+    Norm takeup_ = 0;
+    Norm target_ = 0;
+    Norm filtered_ = 0;
+    Norm last_applied_ = 0;
+    // Profiles only: duty rate (per s) and its limits.
+    Norm profile_rate_ = 0;
+    Norm accel_rate_ = 0;
+    Norm decel_rate_ = 0;
+    Norm jerk_rate_ = 0;
     uint32_t last_pwm_raw_ = 0;
+    int last_drive_sign_ = 0; // Survives stops, unlike last_target_sign_
+    uint32_t reversals_ = 0;
+    uint32_t motor_on_ms_ = 0;
+    uint64_t duty_q15_ms_ = 0; // Q15 duty * ms
+    uint32_t backlash_ms_ = 0;
+    unsigned long takeup_remaining_ms_ = 0;
+    bool takeup_active_ = false;
     bool kick_pending_ = false;
     unsigned long kick_active_until_ms_ = 0;
+    unsigned long kick_holdoff_ms_ = 0;
+    unsigned long stop_ms_ = 0;
+    bool resume_ = false;
     int last_target_sign_ = 0;
-    bool has_in1_ = false;
-    bool has_in2_ = false;
     bool enabled_ = true;
 };
+
+typedef BasicMotorDriver<> MotorDriver;
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "util/Platform.h"
+
+// Output stage for MotorDriver, one PWM channel per H-bridge input. A fade
+// backend runs a linear duty ramp without the CPU; outputs without a fade
+// engine just write the end duty. tick() runs every MotorDriver tick, for
+// outputs that hold calls made during a fade and issue them later.
+class PwmOutput {
+public:
+    virtual ~PwmOutput() {}
+
+    virtual void setup(uint8_t channel, uint32_t freq_hz, uint8_t res_bits, int pin) = 0;
+    virtual void write(uint8_t channel, uint32_t duty) = 0;
+    virtual void fade(uint8_t channel, uint32_t duty, uint32_t ms) {
+        (void)ms;
+        write(channel, duty);
+    }
+    virtual void tick(unsigned long now_ms) { (void)now_ms; }
+    virtual bool hasFade() const { return false; }
+    // A fade still runs on the channel or a call waits for it to end.
+    virtual bool isFading(uint8_t channel) const {
+        (void)channel;
+        return false;
+    }
+};
+
+// Arduino LEDC calls; MotorDriver's default.
+class LedcPwmOutput : public PwmOutput {
+public:
+    void setup(uint8_t channel, uint32_t freq_hz, uint8_t res_bits, int pin) override {
+        ledcSetup(channel, freq_hz, res_bits);
+        if (pin >= 0) {
+            ledcAttachPin(pin, channel);
+        }
+    }
+
+    void write(uint8_t channel, uint32_t duty) override { ledcWrite(channel, duty); }
+};
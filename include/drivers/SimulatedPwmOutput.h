@@ -0,0 +1,116 @@
+#pragma once
+
+#include "util/Platform.h"
+
+#include "drivers/FadeSchedule.h"
+#include "drivers/PwmOutput.h"
+
+// Host-side stand-in for a fade-capable PWM peripheral on IDF 4.4. Fades are
+// linear in millis() from the duty at the time of the call, and a call made
+// during a fade waits for it to end: the host clock jumps and blockedMs()
+// counts it. With holds_calls such a call is held and issued from tick()
+// instead, as LedcFadePwmOutput does.
+class SimulatedPwmOutput : public PwmOutput {
+public:
+    static const uint8_t CHANNEL_COUNT = FadeSchedule::CHANNEL_COUNT;
+
+    explicit SimulatedPwmOutput(bool has_fade, bool holds_calls = true)
+        : has_fade_(has_fade),
+          holds_calls_(holds_calls) {}
+
+    void setup(uint8_t channel, uint32_t freq_hz, uint8_t res_bits, int pin) override {
+        (void)channel;
+        (void)freq_hz;
+        (void)res_bits;
+        (void)pin;
+    }
+
+    void write(uint8_t channel, uint32_t duty) override { fade(channel, duty, 0); }
+
+    void fade(uint8_t channel, uint32_t duty, uint32_t ms) override {
+        if (channel >= CHANNEL_COUNT) {
+            return;
+        }
+        if (!has_fade_) {
+            ms = 0;
+        }
+        const unsigned long now_ms = millis();
+        if (has_fade_ && holds_calls_ && schedule_.busy(channel, now_ms)) {
+            schedule_.hold(channel, duty, ms);
+            return;
+        }
+        Channel& ch = channels_[channel];
+        waitForFade(ch);
+        const unsigned long start_ms = millis();
+        ch.from = dutyAt(ch, start_ms);
+        ch.to = duty;
+        ch.start_ms = start_ms;
+        ch.fade_ms = ms;
+        schedule_.issued(channel, start_ms, ms);
+        if (ms > 0) {
+            fades_++;
+        } else {
+            writes_++;
+        }
+    }
+
+    void tick(unsigned long now_ms) override {
+        uint8_t channel;
+        uint32_t duty;
+        uint32_t ms;
+        while (schedule_.takeDue(now_ms, &channel, &duty, &ms)) {
+            fade(channel, duty, ms);
+        }
+    }
+
+    bool hasFade() const override { return has_fade_; }
+
+    bool isFading(uint8_t channel) const override {
+        return holds_calls_ && channel < CHANNEL_COUNT && schedule_.pending(channel, millis());
+    }
+
+    uint32_t duty(uint8_t channel) const {
+        return (channel < CHANNEL_COUNT) ? dutyAt(channels_[channel], millis()) : 0;
+    }
+
+    uint32_t writes() const { return writes_; }
+    uint32_t fades() const { return fades_; }
+    uint32_t heldCalls() const { return schedule_.holds(); }
+    // Time spent inside write()/fade() waiting for a running fade.
+    unsigned long blockedMs() const { return blocked_ms_; }
+
+private:
+    struct Channel {
+        uint32_t from = 0;
+        uint32_t to = 0;
+        unsigned long start_ms = 0;
+        uint32_t fade_ms = 0;
+    };
+
+    void waitForFade(const Channel& ch) {
+        const unsigned long elapsed = millis() - ch.start_ms;
+        if (ch.fade_ms == 0 || elapsed >= ch.fade_ms) {
+            return;
+        }
+        const unsigned long wait_ms = ch.fade_ms - elapsed;
+        HostPlatform::advanceMicros(wait_ms * 1000UL);
+        blocked_ms_ += wait_ms;
+    }
+
+    static uint32_t dutyAt(const Channel& ch, unsigned long now_ms) {
+        const unsigned long elapsed = now_ms - ch.start_ms;
+        if (ch.fade_ms == 0 || elapsed >= ch.fade_ms) {
+            return ch.to;
+        }
+        const int64_t delta = (int64_t)ch.to - (int64_t)ch.from;
+        return (uint32_t)((int64_t)ch.from + ((delta * (int64_t)elapsed) / (int64_t)ch.fade_ms));
+    }
+
+    bool has_fade_;
+    bool holds_calls_;
+    Channel channels_[CHANNEL_COUNT];
+    FadeSchedule schedule_;
+    uint32_t writes_ = 0;
+    uint32_t fades_ = 0;
+    unsigned long blocked_ms_ = 0;
+};
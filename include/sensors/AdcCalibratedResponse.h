@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_adc_cal.h>
+
+#include "sensors/LdrResponse.h"
+#include "sensors/LightSensorPair.h"
+
+// Runtime variant of the LdrResponse tables: counts are converted with this
+// chip's eFuse ADC calibration (Two Point or Vref) instead of the generic fit.
+// Built once at boot into RAM; chips without eFuse data keep the flash table.
+class AdcCalibratedResponse {
+public:
+    struct Config {
+        LightSensorPair::Response response;
+        int supply_mv;
+        int gamma_milli;
+        uint32_t default_vref_mv;
+    };
+
+    explicit AdcCalibratedResponse(const Config& cfg)
+        : cfg_(cfg) {}
+
+    bool begin() {
+        ready_ = false;
+        if (cfg_.response == LightSensorPair::Response::Raw) {
+            return false;
+        }
+        if (esp_adc_cal_check_efuse(ESP_ADC_CAL_VAL_EFUSE_TP) != ESP_OK &&
+            esp_adc_cal_check_efuse(ESP_ADC_CAL_VAL_EFUSE_VREF) != ESP_OK) {
+            return false;
+        }
+
+        esp_adc_cal_characteristics_t chars;
+        esp_adc_cal_characterize(
+            ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, cfg_.default_vref_mv, &chars);
+
+        const double supply_mv = (double)cfg_.supply_mv;
+        const double gamma = (double)cfg_.gamma_milli / 1000.0;
+        for (size_t raw = 0; raw < LdrResponse::TABLE_SIZE; ++raw) {
+            const double mv = (double)esp_adc_cal_raw_to_voltage((uint32_t)raw, &chars);
+            table_[raw] = (cfg_.response == LightSensorPair::Response::Log)
+                ? LdrResponse::logFromMv(mv, supply_mv, gamma)
+                : LdrResponse::linearFromMv(mv);
+        }
+        ready_ = true;
+        return true;
+    }
+
+    const uint16_t* table() const { return ready_ ? table_ : nullptr; }
+
+private:
+    Config cfg_;
+    uint16_t table_[LdrResponse::TABLE_SIZE];
+    bool ready_ = false;
+};
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <Arduino.h>
+#include <driver/adc.h>
+#include <driver/i2s.h>
+#include <soc/syscon_struct.h>
+
+#include "sensors/LightSampleSource.h"
+#include "sensors/ScanFrameRings.h"
+
+// Continuous ADC1 scan through the I2S0 DMA engine. The SAR controller walks
+// the configured pins at a fixed hardware rate, so readings keep accumulating
+// in DMA memory while loop() is busy (e.g. during a full display redraw).
+// readPairs() drains DMA into per-pin rings and hands out (a, b) pairs taken
+// from the same scan pass.
+class AdcDmaSampler : public LightSampleSource {
+public:
+    static const size_t MAX_PINS = 4;
+    static const size_t RING_CAPACITY = 256;
+
+    struct Config {
+        int pins[MAX_PINS];       // ADC1 GPIOs (32..39), -1 = unused
+        uint32_t sample_rate_hz;  // Total conversions per second, shared by all pins
+        int dma_buf_count;
+        int dma_buf_len;          // Samples per DMA buffer
+    };
+
+    explicit AdcDmaSampler(const Config& cfg)
+        : cfg_(cfg) {}
+
+    void begin() override {
+        pin_count_ = 0;
+        rings_.reset();
+        for (size_t i = 0; i < 8; ++i) {
+            channel_slot_[i] = -1;
+        }
+        for (size_t i = 0; i < MAX_PINS; ++i) {
+            const int channel = adc1ChannelForPin(cfg_.pins[i]);
+            if (channel < 0 || channel_slot_[channel] >= 0) {
+                continue;
+            }
+            slot_pins_[pin_count_] = cfg_.pins[i];
+            channel_slot_[channel] = (int)pin_count_;
+            adc1_config_channel_atten((adc1_channel_t)channel, ADC_ATTEN_DB_11);
+            pin_count_++;
+        }
+        if (pin_count_ == 0) {
+            return;
+        }
+
+        i2s_config_t i2s_cfg = {};
+        i2s_cfg.mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX | I2S_MODE_ADC_BUILT_IN);
+        i2s_cfg.sample_rate = cfg_.sample_rate_hz;
+        i2s_cfg.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
+        i2s_cfg.channel_format = I2S_CHANNEL_FMT_ONLY_LEFT;
+        i2s_cfg.communication_format = I2S_COMM_FORMAT_STAND_I2S;
+        i2s_cfg.intr_alloc_flags = 0;
+        i2s_cfg.dma_buf_count = cfg_.dma_buf_count;
+        i2s_cfg.dma_buf_len = cfg_.dma_buf_len;
+        i2s_cfg.use_apll = false;
+        if (i2s_driver_install(I2S_NUM_0, &i2s_cfg, 0, nullptr) != ESP_OK) {
+            return;
+        }
+
+        i2s_set_adc_mode(ADC_UNIT_1, (adc1_channel_t)adc1ChannelForPin(slot_pins_[0]));
+        i2s_adc_enable(I2S_NUM_0);
+
+        // i2s_adc_enable() programs a single-entry pattern; replace it with the
+        // full scan. One byte per entry: channel[7:4] | 12 bit[3:2] | 11 dB[1:0].
+        uint32_t pattern = 0;
+        for (size_t i = 0; i < pin_count_; ++i) {
+            const uint32_t entry =
+                ((uint32_t)adc1ChannelForPin(slot_pins_[i]) << 4) | 0x0FU;
+            pattern |= entry << (24 - (8 * i));
+        }
+        SYSCON.saradc_ctrl.sar1_patt_len = pin_count_ - 1;
+        SYSCON.saradc_sar1_patt_tab[0] = pattern;
+
+        running_ = true;
+    }
+
+    uint32_t sampleRateHz() const override {
+        return (pin_count_ > 0) ? (cfg_.sample_rate_hz / pin_count_) : 0;
+    }
+
+    size_t readPairs(int input_a,
+                     int input_b,
+                     uint16_t* out_a,
+                     uint16_t* out_b,
+                     size_t max_pairs) override {
+        if (!running_) {
+            return 0;
+        }
+        drain();
+
+        const int slot_a = slotForPin(input_a);
+        const int slot_b = slotForPin(input_b);
+        if (slot_a < 0 || slot_b < 0) {
+            return 0;
+        }
+        return rings_.popPairs((size_t)slot_a, (size_t)slot_b, out_a, out_b, max_pairs);
+    }
+
+    uint32_t overruns() const { return rings_.overruns(); }
+    uint32_t resyncs() const { return rings_.resyncs(); }
+
+private:
+    static int adc1ChannelForPin(int pin) {
+        switch (pin) {
+        case 36: return 0;
+        case 37: return 1;
+        case 38: return 2;
+        case 39: return 3;
+        case 32: return 4;
+        case 33: return 5;
+        case 34: return 6;
+        case 35: return 7;
+        default: return -1;
+        }
+    }
+
+    int slotForPin(int pin) const {
+        const int channel = adc1ChannelForPin(pin);
+        return (channel < 0) ? -1 : channel_slot_[channel];
+    }
+
+    void drain() {
+        uint16_t words[64];
+        size_t bytes_read = 0;
+        while (i2s_read(I2S_NUM_0, words, sizeof(words), &bytes_read, 0) == ESP_OK &&
+               bytes_read > 0) {
+            const size_t n = bytes_read / sizeof(words[0]);
+            for (size_t i = 0; i < n; ++i) {
+                // DMA word: channel[15:12] | value[11:0]
+                const int channel = (words[i] >> 12) & 0x07;
+                const int slot = channel_slot_[channel];
+                if (slot >= 0) {
+                    rings_.push((size_t)slot, (uint16_t)(words[i] & 0x0FFF));
+                }
+            }
+            if (bytes_read < sizeof(words)) {
+                break;
+            }
+        }
+    }
+
+    Config cfg_;
+    int slot_pins_[MAX_PINS] = {-1, -1, -1, -1};
+    ScanFrameRings<MAX_PINS, RING_CAPACITY> rings_;
+    int channel_slot_[8] = {-1, -1, -1, -1, -1, -1, -1, -1};
+    size_t pin_count_ = 0;
+    bool running_ = false;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "util/Platform.h"
+
+// Motor current input for CurrentMonitor. read() returns the magnitude in
+// amps; false means no new value (bus error, conversion not ready).
+class CurrentSource {
+public:
+    virtual ~CurrentSource() {}
+
+    virtual void begin() {}
+    virtual bool read(float& amps) = 0;
+    // True when the reading is the mean over the PWM period (RC-filtered
+    // shunt, supply-side monitor): duty x motor current.
+    virtual bool averagesPwm() const { return true; }
+};
+
+// Low-side shunt through an RC filter and an amplifier into an ADC1 pin.
+class ShuntAdcCurrentSource : public CurrentSource {
+public:
+    struct Config {
+        int adc_pin;
+        float shunt_ohms;
+        float amp_gain;
+        float zero_mv; // Amplifier output at 0 A
+    };
+
+    explicit ShuntAdcCurrentSource(const Config& cfg)
+        : cfg_(cfg) {}
+
+    void begin() override {
+        if (cfg_.adc_pin >= 0) {
+            pinMode(cfg_.adc_pin, INPUT);
+        }
+    }
+
+    bool read(float& amps) override {
+        if (cfg_.adc_pin < 0 || cfg_.shunt_ohms <= 0.0f || cfg_.amp_gain <= 0.0f) {
+            return false;
+        }
+        const float mv = (float)analogReadMilliVolts(cfg_.adc_pin) - cfg_.zero_mv;
+        amps = max(mv, 0.0f) / (1000.0f * cfg_.amp_gain * cfg_.shunt_ohms);
+        return true;
+    }
+
+private:
+    Config cfg_;
+};
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+// Mains-flicker rejection for one window of paired reads. For each candidate
+// ripple (100 Hz / 120 Hz, i.e. 50 / 60 Hz mains) it least-squares fits
+//   x(t) = dc + c * cos(wt) + s * sin(wt)
+// on the real read timestamps, so the ripple cancels even when the read
+// interval aliases it and the window is not a whole number of periods.
+// Constant memory: running sums only, solved once per window.
+class FlickerFilter {
+public:
+    static const uint8_t CANDIDATE_COUNT = 2;
+
+    struct Result {
+        uint8_t ripple_hz = 0; // 0 when no ripple above threshold
+        float dc_a = 0.0f;
+        float dc_b = 0.0f;
+        float ripple_ratio = 0.0f; // Ripple amplitude / dc of the detected candidate
+    };
+
+    void clear() {
+        for (uint8_t k = 0; k < CANDIDATE_COUNT; ++k) {
+            fits_[k] = Fit();
+        }
+    }
+
+    void add(uint32_t t_us, float a, float b) {
+        // 50 ms holds 5 periods at 100 Hz and 6 at 120 Hz: phase stays exact
+        // while the argument stays small enough for float.
+        const float t_s = (float)(t_us % 50000UL) * 1.0e-6f;
+        for (uint8_t k = 0; k < CANDIDATE_COUNT; ++k) {
+            const float w = 6.28318531f * (float)candidateHz(k);
+            const float c = cosf(w * t_s);
+            const float s = sinf(w * t_s);
+            Fit& f = fits_[k];
+            f.n += 1.0f;
+            f.sc += c;
+            f.ss += s;
+            f.scc += c * c;
+            f.sss += s * s;
+            f.scs += c * s;
+            f.xa += a;
+            f.xac += a * c;
+            f.xas += a * s;
+            f.xb += b;
+            f.xbc += b * c;
+            f.xbs += b * s;
+        }
+    }
+
+    // Picks the candidate with the strongest ripple; below min_ripple_ratio the
+    // caller should keep its plain mean (fitting noise only adds variance).
+    Result solve(float min_ripple_ratio) const {
+        Result best;
+        float best_amp = 0.0f;
+        for (uint8_t k = 0; k < CANDIDATE_COUNT; ++k) {
+            const Fit& f = fits_[k];
+            float dc_a, c_a, s_a, dc_b, c_b, s_b;
+            if (!solveChannel(f, f.xa, f.xac, f.xas, dc_a, c_a, s_a) ||
+                !solveChannel(f, f.xb, f.xbc, f.xbs, dc_b, c_b, s_b)) {
+                continue;
+            }
+            const float dc = fabsf(dc_a) + fabsf(dc_b);
+            if (dc <= 0.0f) {
+                continue;
+            }
+            const float amp = sqrtf((c_a * c_a) + (s_a * s_a)) +
+                              sqrtf((c_b * c_b) + (s_b * s_b));
+            const float ratio = amp / dc;
+            if (ratio >= min_ripple_ratio && amp > best_amp) {
+                best_amp = amp;
+                best.ripple_hz = candidateHz(k);
+                best.dc_a = dc_a;
+                best.dc_b = dc_b;
+                best.ripple_ratio = ratio;
+            }
+        }
+        return best;
+    }
+
+    static uint8_t candidateHz(uint8_t k) { return (k == 0) ? 100 : 120; }
+
+private:
+    struct Fit {
+        float n = 0.0f;
+        float sc = 0.0f;
+        float ss = 0.0f;
+        float scc = 0.0f;
+        float sss = 0.0f;
+        float scs = 0.0f;
+        float xa = 0.0f;
+        float xac = 0.0f;
+        float xas = 0.0f;
+        float xb = 0.0f;
+        float xbc = 0.0f;
+        float xbs = 0.0f;
+    };
+
+    static float det3(float a, float b, float c,
+                      float d, float e, float f,
+                      float g, float h, float i) {
+        return (a * ((e * i) - (f * h))) -
+               (b * ((d * i) - (f * g))) +
+               (c * ((d * h) - (e * g)));
+    }
+
+    // Normal equations of the 3-parameter fit, solved by Cramer's rule.
+    static bool solveChannel(const Fit& f, float x, float xc, float xs,
+                             float& dc, float& c, float& s) {
+        if (f.n < 4.0f) {
+            return false;
+        }
+        const float det = det3(f.n, f.sc, f.ss,
+                               f.sc, f.scc, f.scs,
+                               f.ss, f.scs, f.sss);
+        // Reads bunched at one phase leave the ripple unobservable.
+        if (fabsf(det) < 1.0e-3f * f.n * f.n * f.n) {
+            return false;
+        }
+        dc = det3(x, f.sc, f.ss,
+                  xc, f.scc, f.scs,
+                  xs, f.scs, f.sss) / det;
+        c = det3(f.n, x, f.ss,
+                 f.sc, xc, f.scs,
+                 f.ss, xs, f.sss) / det;
+        s = det3(f.n, f.sc, x,
+                 f.sc, f.scc, xc,
+                 f.ss, f.scs, xs) / det;
+        return true;
+    }
+
+    Fit fits_[CANDIDATE_COUNT];
+};
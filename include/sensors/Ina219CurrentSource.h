@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#include "sensors/CurrentSource.h"
+
+// INA219-class monitor on I2C, in the motor supply line. Only the shunt
+// voltage register is read; the part averages over its conversion time,
+// far longer than a PWM period.
+class Ina219CurrentSource : public CurrentSource {
+public:
+    struct Config {
+        uint8_t address;
+        float shunt_ohms;
+        uint16_t config_reg; // e.g. 0x399F: 32 V, +/-320 mV, 12-bit, continuous
+    };
+
+    explicit Ina219CurrentSource(const Config& cfg)
+        : cfg_(cfg) {}
+
+    void begin() override {
+        Wire.begin();
+        Wire.beginTransmission(cfg_.address);
+        Wire.write(REG_CONFIG);
+        Wire.write((uint8_t)(cfg_.config_reg >> 8));
+        Wire.write((uint8_t)(cfg_.config_reg & 0xFF));
+        present_ = Wire.endTransmission() == 0;
+    }
+
+    bool read(float& amps) override {
+        if (!present_ || cfg_.shunt_ohms <= 0.0f) {
+            return false;
+        }
+        Wire.beginTransmission(cfg_.address);
+        Wire.write(REG_SHUNT_VOLTAGE);
+        if (Wire.endTransmission(false) != 0 || Wire.requestFrom(cfg_.address, (uint8_t)2) != 2) {
+            return false;
+        }
+        const uint8_t hi = (uint8_t)Wire.read();
+        const uint8_t lo = (uint8_t)Wire.read();
+        const int16_t raw = (int16_t)(((uint16_t)hi << 8) | lo);
+        amps = fabsf((float)raw * SHUNT_LSB_V) / cfg_.shunt_ohms;
+        return true;
+    }
+
+    bool isPresent() const { return present_; }
+
+private:
+    static const uint8_t REG_CONFIG = 0x00;
+    static const uint8_t REG_SHUNT_VOLTAGE = 0x01;
+    static constexpr float SHUNT_LSB_V = 10e-6f;
+
+    Config cfg_;
+    bool present_ = false;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+
+// Exact integer counterpart of RunningStats for the fixed-point build: plain
+// sums and sums of squares, so remove() never drifts. Mean and variance are
+// only evaluated once per window.
+class IntegerStats {
+public:
+    void clear() {
+        count_ = 0;
+        sum_ = 0;
+        sum_sq_ = 0;
+    }
+
+    void add(int32_t x) {
+        count_++;
+        sum_ += x;
+        sum_sq_ += (int64_t)x * x;
+    }
+
+    void remove(int32_t x) {
+        if (count_ <= 1) {
+            clear();
+            return;
+        }
+        count_--;
+        sum_ -= x;
+        sum_sq_ -= (int64_t)x * x;
+    }
+
+    uint32_t count() const { return count_; }
+    float mean() const { return (count_ > 0) ? ((float)sum_ / (float)count_) : 0.0f; }
+
+    // Sample variance (n - 1), truncated; 0 until two values are in.
+    uint64_t varianceInt() const {
+        if (count_ < 2) {
+            return 0;
+        }
+        const int64_t n = (int64_t)count_;
+        const int64_t num = (n * sum_sq_) - (sum_ * sum_);
+        return (num > 0) ? (uint64_t)(num / (n * (n - 1))) : 0;
+    }
+
+    float variance() const { return (float)varianceInt(); }
+
+private:
+    uint32_t count_ = 0;
+    int64_t sum_ = 0;
+    int64_t sum_sq_ = 0;
+};
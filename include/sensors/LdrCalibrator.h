@@ -0,0 +1,146 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <math.h>
+
+#include "sensors/LdrResponse.h"
+#include "sensors/LightSensorPair.h"
+
+// Online gain/offset match of LDR B onto LDR A. While both sensors see the
+// same light (tracker blocked on target), every completed window gives a pair
+// (level_b_uncal, level_a); a least-squares line through them is the
+// correction LightSensorPair::setCalibration() applies once per window.
+// Only windows in bright, diffuse light are used: in dim light the LDRs'
+// mismatch is dominated by noise, and with a direct beam a slight pointing
+// error shows up as a gain error.
+// Coefficients are kept in NVS together with the response domain they were
+// fitted in, so a domain change at build time invalidates them.
+class LdrCalibrator {
+public:
+    struct Config {
+        const char* nvs_namespace;
+        const char* nvs_prefix;     // Per axis, keeps keys unique in the namespace
+        LightSensorPair::Response response;
+        uint16_t min_windows;       // Pairs needed before finish() accepts a fit
+        // Light must move this much (std-dev, as a fraction of the level) for
+        // gain and offset to be separable; below it only one is fitted.
+        float min_spread;
+        float max_gain_error;       // Reject fits with |gain - 1| above this
+        uint32_t min_level;         // Both raw window averages at least this (ADC counts)
+        float max_diff_var;         // Per-read diff variance (percent^2) above this: not diffuse
+    };
+
+    explicit LdrCalibrator(const Config& cfg)
+        : cfg_(cfg) {}
+
+    void start() {
+        collecting_ = true;
+        count_ = 0;
+        rejected_ = 0;
+        mean_x_ = 0.0f;
+        mean_y_ = 0.0f;
+        cxx_ = 0.0f;
+        cxy_ = 0.0f;
+    }
+
+    void cancel() { collecting_ = false; }
+    bool isCollecting() const { return collecting_; }
+    uint16_t windowCount() const { return count_; }
+    uint16_t rejectedCount() const { return rejected_; }
+
+    // One completed window: levels in the response domain, raw averages and
+    // the window's diff variance for the diffuse-light check.
+    void add(float level_a, float level_b_uncal, uint32_t avg_a, uint32_t avg_b, float var_diff) {
+        if (!collecting_ || count_ == 0xFFFF) {
+            return;
+        }
+        if (avg_a < cfg_.min_level || avg_b < cfg_.min_level || var_diff > cfg_.max_diff_var) {
+            if (rejected_ < 0xFFFF) {
+                rejected_++;
+            }
+            return;
+        }
+        // Co-moment update (Welford), stable for large levels in float.
+        count_++;
+        const float dx = level_b_uncal - mean_x_;
+        mean_x_ += dx / (float)count_;
+        mean_y_ += (level_a - mean_y_) / (float)count_;
+        cxx_ += dx * (level_b_uncal - mean_x_);
+        cxy_ += dx * (level_a - mean_y_);
+    }
+
+    // Ends collection; true with a plausible fit in gain/offset.
+    bool finish(float& gain, float& offset) {
+        if (!collecting_) {
+            return false;
+        }
+        collecting_ = false;
+        if (count_ < cfg_.min_windows || mean_x_ <= 0.0f) {
+            return false;
+        }
+
+        const bool log_domain = (cfg_.response == LightSensorPair::Response::Log);
+        const float std_x = sqrtf(cxx_ / (float)count_);
+        const float spread = log_domain
+            ? (std_x / (float)LdrResponse::LOG_SCALE)
+            : (std_x / mean_x_);
+
+        if (spread >= cfg_.min_spread) {
+            gain = cxy_ / cxx_;
+            offset = mean_y_ - (gain * mean_x_);
+        } else if (log_domain) {
+            // A gain mismatch is a constant offset in log-illuminance.
+            gain = 1.0f;
+            offset = mean_y_ - mean_x_;
+        } else {
+            gain = mean_y_ / mean_x_;
+            offset = 0.0f;
+        }
+        return fabsf(gain - 1.0f) <= cfg_.max_gain_error;
+    }
+
+    bool load(float& gain, float& offset) {
+        Preferences prefs;
+        if (!prefs.begin(cfg_.nvs_namespace, true)) {
+            return false;
+        }
+        char key[16];
+        bool ok = prefs.getUChar(makeKey(key, 'r'), 0xFF) == (uint8_t)cfg_.response;
+        if (ok) {
+            gain = prefs.getFloat(makeKey(key, 'g'), 1.0f);
+            offset = prefs.getFloat(makeKey(key, 'o'), 0.0f);
+            ok = (gain > 0.0f) && (fabsf(gain - 1.0f) <= cfg_.max_gain_error);
+        }
+        prefs.end();
+        return ok;
+    }
+
+    bool save(float gain, float offset) {
+        Preferences prefs;
+        if (!prefs.begin(cfg_.nvs_namespace, false)) {
+            return false;
+        }
+        char key[16];
+        prefs.putFloat(makeKey(key, 'g'), gain);
+        prefs.putFloat(makeKey(key, 'o'), offset);
+        prefs.putUChar(makeKey(key, 'r'), (uint8_t)cfg_.response);
+        prefs.end();
+        return true;
+    }
+
+private:
+    const char* makeKey(char* key, char suffix) const {
+        snprintf(key, 16, "%s_%c", cfg_.nvs_prefix, suffix);
+        return key;
+    }
+
+    Config cfg_;
+    bool collecting_ = false;
+    uint16_t count_ = 0;
+    uint16_t rejected_ = 0;
+    float mean_x_ = 0.0f;
+    float mean_y_ = 0.0f;
+    float cxx_ = 0.0f;
+    float cxy_ = 0.0f;
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Count -> light-domain lookup tables for LightSensorPair, generated at compile
+// time (C++11 constexpr) so a read costs a single flash lookup.
+//
+// LDR wiring: LDR from supply to the ADC pin, fixed resistor to GND, so more
+// light means more counts. With R_ldr ~ E^-gamma the fixed resistor cancels:
+//   ln(E) = ln(V / (Vsupply - V)) / gamma + const
+namespace LdrResponse {
+
+static const size_t TABLE_SIZE = 4096;
+
+// Log domain: natural-log units scaled by LOG_SCALE, offset to stay unsigned.
+static const int32_t LOG_SCALE = 1024;
+static const int32_t LOG_OFFSET = 8192;
+constexpr double MIN_DIVIDER_MV = 20.0;
+
+// ESP32 ADC1 at 11 dB, 12 bit: 4th-order fit of counts to volts. Corrects the
+// dead zone near 0 and the compression above ~2.5 V.
+constexpr double adcCountToMv(double count) {
+    return (count <= 0.0)
+        ? 0.0
+        : 1000.0 * ((((-0.000000000000016 * count
+                       + 0.000000000118171) * count
+                      - 0.000000301211691) * count
+                     + 0.001109019271794) * count
+                    + 0.034143524634089);
+}
+
+constexpr double lnSeries(double y2, double term, int k) {
+    return (k > 41) ? 0.0 : (term / k) + lnSeries(y2, term * y2, k + 2);
+}
+
+// ln(x) for x > 0: halve/double into [0.5, 2], then the atanh series.
+constexpr double ln(double x) {
+    return (x > 2.0)
+        ? ln(x * 0.5) + 0.69314718055994531
+        : (x < 0.5)
+            ? ln(x * 2.0) - 0.69314718055994531
+            : 2.0 * lnSeries(((x - 1.0) / (x + 1.0)) * ((x - 1.0) / (x + 1.0)),
+                             (x - 1.0) / (x + 1.0),
+                             1);
+}
+
+constexpr double clampMv(double mv, double supply_mv) {
+    return (mv < MIN_DIVIDER_MV)
+        ? MIN_DIVIDER_MV
+        : (mv > supply_mv - MIN_DIVIDER_MV) ? (supply_mv - MIN_DIVIDER_MV) : mv;
+}
+
+constexpr uint16_t roundToU16(double v) {
+    return (v <= 0.0) ? 0 : (v >= 65535.0) ? 65535 : (uint16_t)(v + 0.5);
+}
+
+constexpr uint16_t linearFromMv(double mv) {
+    return roundToU16(mv);
+}
+
+constexpr uint16_t logFromMv(double mv, double supply_mv, double gamma) {
+    return roundToU16(
+        (double)LOG_OFFSET +
+        ((double)LOG_SCALE *
+         ln(clampMv(mv, supply_mv) / (supply_mv - clampMv(mv, supply_mv))) / gamma));
+}
+
+template <size_t... I>
+struct IndexList {};
+
+template <class A, class B>
+struct ConcatIndex;
+
+template <size_t... A, size_t... B>
+struct ConcatIndex<IndexList<A...>, IndexList<B...> > {
+    typedef IndexList<A..., (sizeof...(A) + B)...> type;
+};
+
+template <size_t N>
+struct MakeIndexList {
+    typedef typename ConcatIndex<typename MakeIndexList<N / 2>::type,
+                                 typename MakeIndexList<N - (N / 2)>::type>::type type;
+};
+
+template <>
+struct MakeIndexList<0> {
+    typedef IndexList<> type;
+};
+
+template <>
+struct MakeIndexList<1> {
+    typedef IndexList<0> type;
+};
+
+template <class Map, class List>
+struct TableBuilder;
+
+template <class Map, size_t... I>
+struct TableBuilder<Map, IndexList<I...> > {
+    static constexpr uint16_t values[sizeof...(I)] = {Map::at(I)...};
+};
+
+template <class Map, size_t... I>
+constexpr uint16_t TableBuilder<Map, IndexList<I...> >::values[sizeof...(I)];
+
+struct LinearMap {
+    static constexpr uint16_t at(size_t count) {
+        return linearFromMv(adcCountToMv((double)count));
+    }
+};
+
+template <int SupplyMv, int GammaMilli>
+struct LogMap {
+    static constexpr uint16_t at(size_t count) {
+        return logFromMv(adcCountToMv((double)count),
+                         (double)SupplyMv,
+                         (double)GammaMilli / 1000.0);
+    }
+};
+
+// LINEAR: corrected millivolts. LOG: scaled log-illuminance.
+template <int SupplyMv, int GammaMilli>
+struct Tables {
+    static constexpr const uint16_t* LINEAR =
+        TableBuilder<LinearMap, MakeIndexList<TABLE_SIZE>::type>::values;
+    static constexpr const uint16_t* LOG =
+        TableBuilder<LogMap<SupplyMv, GammaMilli>, MakeIndexList<TABLE_SIZE>::type>::values;
+};
+
+} // namespace LdrResponse
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Acquisition backend for LightSensorPair. A source delivers raw 12-bit
+// readings as (a, b) pairs for the requested inputs, in acquisition order.
+class LightSampleSource {
+public:
+    virtual ~LightSampleSource() {}
+
+    virtual void begin() {}
+
+    // Per-channel sample rate delivered by the source.
+    virtual uint32_t sampleRateHz() const = 0;
+
+    // Copies up to max_pairs pending readings of input_a/input_b into out_a/out_b.
+    // Returns the number of pairs copied; 0 when nothing is pending.
+    virtual size_t readPairs(int input_a,
+                             int input_b,
+                             uint16_t* out_a,
+                             uint16_t* out_b,
+                             size_t max_pairs) = 0;
+};
@@ -1,61 +1,190 @@
 #pragma once
 
-#include <Arduino.h>
+#include "util/Platform.h"
 
-class LightSensorPair {
+#include "sensors/FlickerFilter.h"
+#include "sensors/IntegerStats.h"
+#include "sensors/LdrResponse.h"
+#include "sensors/LightSampleSource.h"
+#include "sensors/OrderStatSet.h"
+#include "sensors/RunningStats.h"
+#include "util/ConfigRef.h"
+#include "util/FixedPoint.h"
+
+// Types every BasicLightSensorPair shares, whatever its config.
+class LightSensorPairTypes {
 public:
+    // Block: emit once per action window, then reset the sums.
+    // Sliding: keep running sums over the last window and emit on every read.
+    enum class WindowMode {
+        Block,
+        Sliding
+    };
+
+    // Per-channel level estimator. Median and TrimmedMean reject single-read
+    // spikes (e.g. motor PWM coupling) and cap the window at MAX_WINDOW_SAMPLES.
+    enum class Estimator {
+        Mean,
+        Median,
+        TrimmedMean
+    };
+
+    // Domain the diff is computed in. Raw: ADC counts. Linear: corrected
+    // millivolts. Log: log-illuminance, where the diff is 50 * ln(Ea / Eb) and
+    // the same angular error reads the same in bright and dim light.
+    enum class Response {
+        Raw,
+        Linear,
+        Log
+    };
+
+    static const size_t MAX_WINDOW_SAMPLES = 128;
+
     struct Config {
         int pin_a;
         int pin_b;
         unsigned long read_interval_ms;
         unsigned long action_interval_ms;
+        WindowMode window_mode;
+        Estimator estimator;
+        uint8_t trim_percent; // TrimmedMean: percent dropped from each end
+        Response response;
+        const uint16_t* response_table; // 4096 entries (LdrResponse), nullptr for Raw
+        // Adaptive polling: the read interval doubles (up to max) after
+        // stable_windows windows whose diff moved <= stable_diff_percent, and
+        // snaps back to read_interval_ms on a larger move or motor activity.
+        // max <= read_interval_ms disables it. Ignored with a sample source.
+        unsigned long max_read_interval_ms;
+        float stable_diff_percent;
+        uint8_t stable_windows;
+        // Mains flicker: fit out 100/120 Hz ripple on read timestamps (Block
+        // windows, Mean estimator). Detected when ripple/level >= the ratio.
+        bool flicker_rejection;
+        float flicker_detect_ratio;
     };
 
+    // Fixed-point build: Sliding emissions between completed windows only
+    // refresh the integer fields, diff_percent and the counts; levels,
+    // variances and confidence are those of the last completed window.
     struct Sample {
         float diff_percent = 0.0f;
+        int32_t diff_q15 = 0;        // Same diff in Q15, full scale = 100 %
         uint32_t avg_a = 0;
         uint32_t avg_b = 0;
+        float level_a = 0.0f;        // Window level in the response domain
+        float level_b = 0.0f;        // Calibrated onto channel A (see setCalibration)
+        float level_b_uncal = 0.0f;  // level_b before gain/offset correction
+        uint16_t sample_count = 0;   // Reads averaged into this sample
+        uint16_t window_size = 0;    // Reads in a full window
+        float confidence = 0.0f;     // sample_count / window_size
+        bool window_complete = false; // A full window elapsed since the last one
+        uint16_t read_interval_ms = 0; // Poll interval in effect (0 with a source)
+        // Per-read variance within the window (response domain; diff in percent^2)
+        float var_a = 0.0f;
+        float var_b = 0.0f;
+        float var_diff = 0.0f;
+        uint32_t var_diff_q30 = 0;   // var_diff in Q15^2
+        uint8_t flicker_hz = 0;      // Ripple removed from this window, 0 = none
     };
 
-    explicit LightSensorPair(const Config& cfg)
-        : cfg_(cfg) {}
+};
+
+// Two LDRs read as one pair. The config comes from the constructor
+// (LightSensorPair) or is a constexpr object named as C, see ConfigRef.
+template <const LightSensorPairTypes::Config* C = nullptr>
+class BasicLightSensorPair : public LightSensorPairTypes {
+public:
+    // Without a source the pair polls analogRead() every read_interval_ms.
+    // With a source, tick() drains whatever frames are pending and the window
+    // length follows the source's sample rate instead of read_interval_ms.
+    // The rate is read here and again in begin(), not per tick.
+    explicit BasicLightSensorPair(const Config& cfg, LightSampleSource* source = nullptr)
+        : cfg_(cfg),
+          source_(source),
+          table_(cfg.response_table),
+          read_interval_ms_(cfg.read_interval_ms) {
+        if (isRobust()) {
+            order_ = new OrderPair();
+        }
+        cacheSourceRate();
+    }
+
+    ~BasicLightSensorPair() { delete order_; }
+
+    BasicLightSensorPair(const BasicLightSensorPair&) = delete;
+    BasicLightSensorPair& operator=(const BasicLightSensorPair&) = delete;
+
+    // Call after the source's own begin(): a scanner reports its rate only
+    // once it runs.
+    void begin() { cacheSourceRate(); }
+
+    // Replaces the compile-time table, e.g. with one built from eFuse ADC
+    // calibration at boot. Must map counts into the configured response domain.
+    void setResponseTable(const uint16_t* table) {
+        table_ = table;
+        restartWindow();
+    }
+
+    // Per-LDR mismatch: level_b is mapped onto channel A as gain * b + offset
+    // (response domain). Applied once per window, not per read.
+    void setCalibration(float gain_b, float offset_b) {
+        cal_gain_b_ = (gain_b > 0.0f) ? gain_b : 1.0f;
+        cal_offset_b_ = offset_b;
+    }
+
+    float calibrationGain() const { return cal_gain_b_; }
+    float calibrationOffset() const { return cal_offset_b_; }
 
     void tick(unsigned long now_ms) {
-        if (now_ms - last_read_ms_ < cfg_.read_interval_ms) {
+        if (source_ != nullptr) {
+            drainSource();
             return;
         }
-        last_read_ms_ = now_ms;
 
-        const int value_a = analogRead(cfg_.pin_a);
-        const int value_b = analogRead(cfg_.pin_b);
+        if (now_ms - last_read_ms_ < read_interval_ms_) {
+            return;
+        }
+        last_read_ms_ = now_ms;
 
-        sum_a_ += (uint32_t)value_a;
-        sum_b_ += (uint32_t)value_b;
-        sample_count_++;
+        const int value_a = analogRead(cfg().pin_a);
+        const int value_b = analogRead(cfg().pin_b);
+        reads_++;
+        if (cfg().read_interval_ms > 0) {
+            reads_skipped_ += (read_interval_ms_ / cfg().read_interval_ms) - 1;
+        }
+        addReading((uint32_t)value_a, (uint32_t)value_b, (uint32_t)micros());
+    }
 
-        const unsigned int samples_per_action =
-            (cfg_.read_interval_ms > 0)
-                ? (unsigned int)max(1UL, cfg_.action_interval_ms / cfg_.read_interval_ms)
-                : 1U;
-
-        if (sample_count_ >= samples_per_action) {
-            const uint32_t total_sum = sum_a_ + sum_b_;
-            float diff = 0.0f;
-            if (total_sum > 0) {
-                diff = ((float)((int32_t)sum_a_ - (int32_t)sum_b_) /
-                        (float)total_sum) * 100.0f;
-            }
-            diff = constrain(diff, -100.0f, 100.0f);
+    // Motor motion means the diff is about to change: sample at full rate.
+    void setMotorActive(bool active) {
+        motor_active_ = active;
+        if (active && read_interval_ms_ != cfg().read_interval_ms) {
+            read_interval_ms_ = cfg().read_interval_ms;
+            stable_count_ = 0;
+            updateWindowSamples();
+        }
+    }
 
-            last_sample_.diff_percent = diff;
-            last_sample_.avg_a = sum_a_ / sample_count_;
-            last_sample_.avg_b = sum_b_ / sample_count_;
+    unsigned long currentReadIntervalMs() const { return read_interval_ms_; }
+    uint32_t readCount() const { return reads_; }
+    // Reads avoided compared with polling every read_interval_ms.
+    uint32_t readsSkipped() const { return reads_skipped_; }
 
-            sum_a_ = 0;
-            sum_b_ = 0;
-            sample_count_ = 0;
-            new_sample_ = true;
+    // Drops the current window, e.g. after a wake-up or a transient.
+    void restartWindow() {
+        sum_a_ = 0;
+        sum_b_ = 0;
+        level_sum_a_ = 0;
+        level_sum_b_ = 0;
+        sample_count_ = 0;
+        ring_head_ = 0;
+        reads_since_complete_ = 0;
+        if (isRobust()) {
+            order_->a.clear();
+            order_->b.clear();
         }
+        clearStats();
+        flicker_.clear();
     }
 
     bool consumeSample(Sample& out) {
@@ -68,11 +197,425 @@ public:
     }
 
 private:
-    Config cfg_;
+    static const size_t FRAME_PAIRS = 32;
+
+    const Config& cfg() const { return cfg_.get(); }
+
+    struct OrderPair {
+        OrderStatSet a;
+        OrderStatSet b;
+    };
+
+    void drainSource() {
+        uint16_t frame_a[FRAME_PAIRS];
+        uint16_t frame_b[FRAME_PAIRS];
+        size_t n = 0;
+        while ((n = source_->readPairs(
+                    cfg().pin_a, cfg().pin_b, frame_a, frame_b, FRAME_PAIRS)) > 0) {
+            reduceFrame(frame_a, frame_b, n);
+        }
+    }
+
+    // Frames are evenly spaced at the source rate; timestamps are synthesized.
+    void reduceFrame(const uint16_t* frame_a, const uint16_t* frame_b, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            frame_time_us_ += source_step_us_;
+            addReading(frame_a[i], frame_b[i], frame_time_us_);
+        }
+    }
+
+    unsigned int samplesPerAction() const {
+        if (source_ != nullptr) {
+            const uint32_t per_action =
+                (uint32_t)((cfg().action_interval_ms * source_rate_hz_) / 1000UL);
+            return (unsigned int)max((uint32_t)1, per_action);
+        }
+        return (read_interval_ms_ > 0)
+            ? (unsigned int)max(1UL, cfg().action_interval_ms / read_interval_ms_)
+            : 1U;
+    }
+
+    void cacheSourceRate() {
+        source_rate_hz_ = (source_ != nullptr) ? source_->sampleRateHz() : 0;
+        source_step_us_ = (source_rate_hz_ > 0) ? (1000000UL / source_rate_hz_) : 0;
+        updateWindowSamples();
+    }
+
+    bool isAdaptive() const {
+        return source_ == nullptr && cfg().max_read_interval_ms > cfg().read_interval_ms;
+    }
+
+    void adaptReadInterval(float diff) {
+        const float change = fabsf(diff - last_window_diff_);
+        last_window_diff_ = diff;
+
+        if (motor_active_ || change > fabsf(cfg().stable_diff_percent)) {
+            read_interval_ms_ = cfg().read_interval_ms;
+            stable_count_ = 0;
+            updateWindowSamples();
+            return;
+        }
+
+        stable_count_++;
+        if (stable_count_ >= max((uint8_t)1, cfg().stable_windows)) {
+            stable_count_ = 0;
+            read_interval_ms_ = min(max(read_interval_ms_, 1UL) * 2UL,
+                                    cfg().max_read_interval_ms);
+            updateWindowSamples();
+        }
+    }
+
+    uint32_t mapValue(uint16_t raw) const {
+        return (table_ != nullptr) ? table_[raw & 0x0FFF] : raw;
+    }
+
+    bool isRobust() const { return cfg().estimator != Estimator::Mean; }
+
+    bool usesFlickerFilter() const {
+        return cfg().flicker_rejection && !isRobust() && cfg().window_mode == WindowMode::Block;
+    }
+
+    // Reads per window change only with the read interval (or the source
+    // rate), so the division is not redone for every read.
+    void updateWindowSamples() {
+        const unsigned int samples = samplesPerAction();
+        window_samples_ = (cfg().window_mode == WindowMode::Sliding || isRobust())
+            ? min(samples, (unsigned int)MAX_WINDOW_SAMPLES)
+            : samples;
+    }
+
+    unsigned int windowSamples() const { return window_samples_; }
+
+    void addReading(uint32_t value_a, uint32_t value_b, uint32_t t_us) {
+        if (cfg().window_mode == WindowMode::Sliding) {
+            addSlidingReading((uint16_t)value_a, (uint16_t)value_b);
+            return;
+        }
+
+        const uint32_t level_a = mapValue((uint16_t)value_a);
+        const uint32_t level_b = mapValue((uint16_t)value_b);
+        sum_a_ += value_a;
+        sum_b_ += value_b;
+        sample_count_++;
+        if (isRobust()) {
+            order_->a.insert((uint16_t)value_a);
+            order_->b.insert((uint16_t)value_b);
+        } else if (table_ != nullptr) {
+            level_sum_a_ += level_a;
+            level_sum_b_ += level_b;
+        }
+        addStats(level_a, level_b);
+        if (usesFlickerFilter()) {
+            flicker_.add(t_us, (float)level_a, (float)level_b);
+        }
+
+        if (sample_count_ >= windowSamples()) {
+            publish(sample_count_, sample_count_, true);
+            sum_a_ = 0;
+            sum_b_ = 0;
+            level_sum_a_ = 0;
+            level_sum_b_ = 0;
+            sample_count_ = 0;
+            if (isRobust()) {
+                order_->a.clear();
+                order_->b.clear();
+            }
+            clearStats();
+            flicker_.clear();
+        }
+    }
+
+    // O(1) per read for Mean (O(log range) for robust estimators): the oldest
+    // reading leaves the window as the new one enters.
+    void addSlidingReading(uint16_t value_a, uint16_t value_b) {
+        const unsigned int window = windowSamples();
+        const bool robust = isRobust();
+
+        while (sample_count_ >= window) {
+            const size_t oldest =
+                (ring_head_ + MAX_WINDOW_SAMPLES - sample_count_) % MAX_WINDOW_SAMPLES;
+            const uint32_t old_level_a = mapValue(ring_a_[oldest]);
+            const uint32_t old_level_b = mapValue(ring_b_[oldest]);
+            sum_a_ -= ring_a_[oldest];
+            sum_b_ -= ring_b_[oldest];
+            if (robust) {
+                order_->a.erase(ring_a_[oldest]);
+                order_->b.erase(ring_b_[oldest]);
+            } else if (table_ != nullptr) {
+                level_sum_a_ -= old_level_a;
+                level_sum_b_ -= old_level_b;
+            }
+            removeStats(old_level_a, old_level_b);
+            sample_count_--;
+        }
+
+        const uint32_t level_a = mapValue(value_a);
+        const uint32_t level_b = mapValue(value_b);
+        ring_a_[ring_head_] = value_a;
+        ring_b_[ring_head_] = value_b;
+        ring_head_ = (ring_head_ + 1) % MAX_WINDOW_SAMPLES;
+        sum_a_ += value_a;
+        sum_b_ += value_b;
+        sample_count_++;
+        if (robust) {
+            order_->a.insert(value_a);
+            order_->b.insert(value_b);
+        } else if (table_ != nullptr) {
+            level_sum_a_ += level_a;
+            level_sum_b_ += level_b;
+        }
+        addStats(level_a, level_b);
+
+        reads_since_complete_++;
+        const bool complete = reads_since_complete_ >= window;
+        if (complete) {
+            reads_since_complete_ = 0;
+        }
+        publish(sample_count_, window, complete);
+        if (complete) {
+            rebuildStats();
+        }
+    }
+
+    void clearStats() {
+        stats_a_.clear();
+        stats_b_.clear();
+        stats_diff_.clear();
+    }
+
+#if SATELLITE_FIXED_POINT
+    void addStats(uint32_t level_a, uint32_t level_b) {
+        stats_a_.add((int32_t)level_a);
+        stats_b_.add((int32_t)level_b);
+        stats_diff_.add(domainDiffQ15(level_a, level_b, 1));
+    }
+
+    void removeStats(uint32_t level_a, uint32_t level_b) {
+        stats_a_.remove((int32_t)level_a);
+        stats_b_.remove((int32_t)level_b);
+        stats_diff_.remove(domainDiffQ15(level_a, level_b, 1));
+    }
+#else
+    void addStats(uint32_t level_a, uint32_t level_b) {
+        stats_a_.add((float)level_a);
+        stats_b_.add((float)level_b);
+        stats_diff_.add(domainDiff((float)level_a, (float)level_b));
+    }
+
+    void removeStats(uint32_t level_a, uint32_t level_b) {
+        stats_a_.remove((float)level_a);
+        stats_b_.remove((float)level_b);
+        stats_diff_.remove(domainDiff((float)level_a, (float)level_b));
+    }
+#endif
+
+    // Sliding mode: re-add the window once per window so remove() drift stays
+    // bounded. Integer sums are exact and never need it.
+    void rebuildStats() {
+        if (SATELLITE_FIXED_POINT) {
+            return;
+        }
+        clearStats();
+        for (unsigned int i = sample_count_; i > 0; --i) {
+            const size_t idx = (ring_head_ + MAX_WINDOW_SAMPLES - i) % MAX_WINDOW_SAMPLES;
+            addStats(mapValue(ring_a_[idx]), mapValue(ring_b_[idx]));
+        }
+    }
+
+    uint32_t robustLevel(const OrderStatSet& order) const {
+        if (cfg().estimator == Estimator::Median) {
+            return order.median();
+        }
+        const size_t trim = (order.size() * min(cfg().trim_percent, (uint8_t)49)) / 100U;
+        return order.trimmedMean(trim);
+    }
+
+    float domainDiff(float level_a, float level_b) const {
+        if (cfg().response == Response::Log) {
+            return ((level_a - level_b) / (float)LdrResponse::LOG_SCALE) * 50.0f;
+        }
+        const float total = level_a + level_b;
+        return (total > 0.0f) ? ((level_a - level_b) / total) * 100.0f : 0.0f;
+    }
+
+    // Q15 diff of level sums over n reads, without dividing by n for ratios.
+    int32_t domainDiffQ15(uint32_t sum_a, uint32_t sum_b, uint32_t n) const {
+        const int32_t delta = (int32_t)sum_a - (int32_t)sum_b;
+        if (cfg().response == Response::Log) {
+            // 50 % per LOG_SCALE, i.e. Q15 half scale per LOG_SCALE.
+            return Q15::divRound((int64_t)delta * (Q15::ONE / 2),
+                                 (int64_t)LdrResponse::LOG_SCALE * max(n, (uint32_t)1));
+        }
+        return Q15::ratio(delta, (int32_t)(sum_a + sum_b));
+    }
+
+    bool isCalibrated() const { return cal_gain_b_ != 1.0f || cal_offset_b_ != 0.0f; }
+
+    void publish(unsigned int count, unsigned int window, bool complete) {
+#if SATELLITE_FIXED_POINT
+        // Sliding reads between completed windows: integer fields only.
+        if (!complete && !isCalibrated()) {
+            publishPartialQ15(count, window);
+            return;
+        }
+#endif
+        // Robust levels are taken on raw counts and mapped once (the tables
+        // are monotonic); the mean maps every read.
+        uint32_t avg_a = 0;
+        uint32_t avg_b = 0;
+        float level_a = 0.0f;
+        float level_b = 0.0f;
+        if (isRobust()) {
+            avg_a = robustLevel(order_->a);
+            avg_b = robustLevel(order_->b);
+            level_a = (float)mapValue((uint16_t)avg_a);
+            level_b = (float)mapValue((uint16_t)avg_b);
+        } else {
+            avg_a = sum_a_ / count;
+            avg_b = sum_b_ / count;
+            level_a = (float)((table_ != nullptr) ? level_sum_a_ : sum_a_) / (float)count;
+            level_b = (float)((table_ != nullptr) ? level_sum_b_ : sum_b_) / (float)count;
+        }
+
+        uint8_t flicker_hz = 0;
+        if (usesFlickerFilter()) {
+            const FlickerFilter::Result fit = flicker_.solve(cfg().flicker_detect_ratio);
+            if (fit.ripple_hz != 0) {
+                flicker_hz = fit.ripple_hz;
+                level_a = max(fit.dc_a, 0.0f);
+                level_b = max(fit.dc_b, 0.0f);
+            }
+        }
+
+        const float level_b_uncal = level_b;
+        level_b = max((cal_gain_b_ * level_b) + cal_offset_b_, 0.0f);
+
+        // Fixed-point build: the control diff comes straight from the integer
+        // sums; the float fit / calibration paths convert their result.
+        float diff = 0.0f;
+        int32_t diff_q15 = 0;
+        if (SATELLITE_FIXED_POINT && flicker_hz == 0 && !isCalibrated()) {
+            if (isRobust()) {
+                diff_q15 = domainDiffQ15(
+                    mapValue((uint16_t)avg_a), mapValue((uint16_t)avg_b), 1);
+            } else if (table_ != nullptr) {
+                diff_q15 = domainDiffQ15(level_sum_a_, level_sum_b_, count);
+            } else {
+                diff_q15 = domainDiffQ15(sum_a_, sum_b_, count);
+            }
+            diff = Q15::toPercent(diff_q15);
+        } else {
+            diff = constrain(domainDiff(level_a, level_b), -100.0f, 100.0f);
+            diff_q15 = Q15::fromPercent(diff);
+        }
+
+        // A completed window may still be waiting for the consumer; keep its flag.
+        const bool pending_complete = new_sample_ && last_sample_.window_complete;
+
+        last_sample_.diff_percent = diff;
+        last_sample_.diff_q15 = diff_q15;
+        last_sample_.avg_a = avg_a;
+        last_sample_.avg_b = avg_b;
+        last_sample_.level_a = level_a;
+        last_sample_.level_b = level_b;
+        last_sample_.level_b_uncal = level_b_uncal;
+        last_sample_.sample_count = (uint16_t)min(count, 0xFFFFU);
+        last_sample_.window_size = (uint16_t)min(window, 0xFFFFU);
+        last_sample_.confidence = (window > 0) ? ((float)count / (float)window) : 1.0f;
+        last_sample_.window_complete = complete || pending_complete;
+        last_sample_.var_a = stats_a_.variance();
+        last_sample_.var_b = stats_b_.variance() * cal_gain_b_ * cal_gain_b_;
+#if SATELLITE_FIXED_POINT
+        const uint64_t var_q30 = stats_diff_.varianceInt();
+        last_sample_.var_diff_q30 = (uint32_t)min(var_q30, (uint64_t)0xFFFFFFFFUL);
+        last_sample_.var_diff =
+            (float)var_q30 * Q15::PERCENT_PER_LSB * Q15::PERCENT_PER_LSB;
+#else
+        last_sample_.var_diff = stats_diff_.variance();
+        last_sample_.var_diff_q30 = (uint32_t)min(
+            last_sample_.var_diff / (Q15::PERCENT_PER_LSB * Q15::PERCENT_PER_LSB),
+            4294967040.0f);
+#endif
+        last_sample_.flicker_hz = flicker_hz;
+        if (complete && isAdaptive()) {
+            adaptReadInterval(diff);
+        }
+        last_sample_.read_interval_ms =
+            (source_ != nullptr) ? 0 : (uint16_t)min(read_interval_ms_, 0xFFFFUL);
+        new_sample_ = true;
+    }
+
+#if SATELLITE_FIXED_POINT
+    // The control fields of publish() from the integer sums; the float
+    // levels and variances keep the last completed window's values.
+    void publishPartialQ15(unsigned int count, unsigned int window) {
+        uint32_t avg_a = 0;
+        uint32_t avg_b = 0;
+        int32_t diff_q15 = 0;
+        if (isRobust()) {
+            avg_a = robustLevel(order_->a);
+            avg_b = robustLevel(order_->b);
+            diff_q15 = domainDiffQ15(mapValue((uint16_t)avg_a), mapValue((uint16_t)avg_b), 1);
+        } else {
+            avg_a = sum_a_ / count;
+            avg_b = sum_b_ / count;
+            diff_q15 = (table_ != nullptr) ? domainDiffQ15(level_sum_a_, level_sum_b_, count)
+                                           : domainDiffQ15(sum_a_, sum_b_, count);
+        }
+        const bool pending_complete = new_sample_ && last_sample_.window_complete;
+        last_sample_.diff_q15 = diff_q15;
+        last_sample_.diff_percent = Q15::toPercent(diff_q15);
+        last_sample_.avg_a = avg_a;
+        last_sample_.avg_b = avg_b;
+        last_sample_.sample_count = (uint16_t)min(count, 0xFFFFU);
+        last_sample_.window_size = (uint16_t)min(window, 0xFFFFU);
+        last_sample_.window_complete = pending_complete;
+        last_sample_.var_diff_q30 =
+            (uint32_t)min(stats_diff_.varianceInt(), (uint64_t)0xFFFFFFFFUL);
+        new_sample_ = true;
+    }
+#endif
+
+    ConfigRef<Config, C> cfg_;
+    LightSampleSource* source_ = nullptr;
+    uint32_t source_rate_hz_ = 0;
+    uint32_t source_step_us_ = 0;
+    const uint16_t* table_ = nullptr;
     unsigned long last_read_ms_ = 0;
+    unsigned long read_interval_ms_ = 0;
+    unsigned int window_samples_ = 1;
+    bool motor_active_ = false;
+    uint8_t stable_count_ = 0;
+    float last_window_diff_ = 0.0f;
+    float cal_gain_b_ = 1.0f;
+    float cal_offset_b_ = 0.0f;
+    uint32_t reads_ = 0;
+    uint32_t reads_skipped_ = 0;
     uint32_t sum_a_ = 0;
     uint32_t sum_b_ = 0;
+    uint32_t level_sum_a_ = 0;
+    uint32_t level_sum_b_ = 0;
     unsigned int sample_count_ = 0;
+    uint16_t ring_a_[MAX_WINDOW_SAMPLES];
+    uint16_t ring_b_[MAX_WINDOW_SAMPLES];
+    size_t ring_head_ = 0;
+    unsigned int reads_since_complete_ = 0;
+    // Both channels' window order statistics (8 KB), only for a robust
+    // estimator.
+    OrderPair* order_ = nullptr;
+#if SATELLITE_FIXED_POINT
+    IntegerStats stats_a_;
+    IntegerStats stats_b_;
+    IntegerStats stats_diff_; // Q15
+#else
+    RunningStats stats_a_;
+    RunningStats stats_b_;
+    RunningStats stats_diff_;
+#endif
+    FlickerFilter flicker_;
+    uint32_t frame_time_us_ = 0;
     bool new_sample_ = false;
     Sample last_sample_;
 };
+
+typedef BasicLightSensorPair<> LightSensorPair;
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "util/Platform.h"
+
+// Select/convert access to an external analog mux (CD74HC4067 / 4051 style).
+// MuxScanner drives it; a host model can replace the GPIO implementation.
+class MuxIo {
+public:
+    virtual ~MuxIo() {}
+
+    virtual void begin() {}
+    virtual void select(uint8_t channel) = 0;
+    // One conversion of the mux output (12-bit counts).
+    virtual uint16_t convert() = 0;
+};
+
+class GpioMuxIo : public MuxIo {
+public:
+    static const size_t MAX_SELECT_PINS = 4;
+
+    struct Config {
+        int select_pins[MAX_SELECT_PINS]; // S0..S3, -1 = tied low (8-channel parts)
+        int sig_pin;                      // ADC1 GPIO on the mux common pin
+    };
+
+    explicit GpioMuxIo(const Config& cfg)
+        : cfg_(cfg) {}
+
+    void begin() override {
+        for (size_t i = 0; i < MAX_SELECT_PINS; ++i) {
+            if (cfg_.select_pins[i] >= 0) {
+                pinMode(cfg_.select_pins[i], OUTPUT);
+                digitalWrite(cfg_.select_pins[i], LOW);
+            }
+        }
+        selected_ = 0;
+    }
+
+    void select(uint8_t channel) override {
+        // Only toggle lines that change: fewer edges, less charge injection.
+        const uint8_t changed = channel ^ selected_;
+        for (size_t i = 0; i < MAX_SELECT_PINS; ++i) {
+            if (cfg_.select_pins[i] >= 0 && (changed & (1U << i)) != 0) {
+                digitalWrite(cfg_.select_pins[i], ((channel >> i) & 1U) ? HIGH : LOW);
+            }
+        }
+        selected_ = channel;
+    }
+
+    uint16_t convert() override {
+        return (uint16_t)analogRead(cfg_.sig_pin);
+    }
+
+private:
+    Config cfg_;
+    uint8_t selected_ = 0;
+};
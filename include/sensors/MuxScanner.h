@@ -0,0 +1,168 @@
+#pragma once
+
+#include "util/Platform.h"
+
+#include "sensors/LightSampleSource.h"
+#include "sensors/MuxIo.h"
+
+// Scan engine for LDRs behind an analog mux. Every frame converts the enabled
+// channels in order; the next channel is selected right after each conversion
+// so it settles while the caller does other work, and only the remainder of
+// settle_us is waited for. Inputs of readPairs() are mux channel numbers, so
+// each logical pair is an ordinary LightSensorPair source.
+class MuxScanner : public LightSampleSource {
+public:
+    static const size_t MAX_CHANNELS = 16;
+    static const size_t RING_CAPACITY = 64;
+
+    struct Config {
+        uint16_t channel_mask;   // Bit n = scan mux channel n
+        uint16_t settle_us;      // From select to a valid conversion
+        uint32_t frame_rate_hz;  // Full scans per second
+    };
+
+    MuxScanner(const Config& cfg, MuxIo& io)
+        : cfg_(cfg),
+          io_(io) {}
+
+    void begin() override {
+        channel_count_ = 0;
+        for (uint8_t ch = 0; ch < MAX_CHANNELS; ++ch) {
+            if ((cfg_.channel_mask & (1U << ch)) != 0) {
+                order_[channel_count_++] = ch;
+            }
+            rings_[ch].head = 0;
+            rings_[ch].count = 0;
+        }
+        if (channel_count_ == 0 || cfg_.frame_rate_hz == 0) {
+            return;
+        }
+        frame_period_us_ = 1000000UL / cfg_.frame_rate_hz;
+        io_.begin();
+        position_ = 0;
+        in_frame_ = false;
+        io_.select(order_[0]);
+        select_us_ = micros();
+        frame_start_us_ = select_us_;
+        running_ = true;
+    }
+
+    uint32_t sampleRateHz() const override {
+        return running_ ? cfg_.frame_rate_hz : 0;
+    }
+
+    size_t readPairs(int input_a,
+                     int input_b,
+                     uint16_t* out_a,
+                     uint16_t* out_b,
+                     size_t max_pairs) override {
+        if (!running_ || !isScanned(input_a) || !isScanned(input_b)) {
+            return 0;
+        }
+        service();
+
+        Ring& ring_a = rings_[input_a];
+        Ring& ring_b = rings_[input_b];
+        size_t n = min(ring_a.count, ring_b.count);
+        n = min(n, max_pairs);
+        for (size_t i = 0; i < n; ++i) {
+            out_a[i] = pop(ring_a);
+            out_b[i] = pop(ring_b);
+        }
+        return n;
+    }
+
+    // Runs due frames; also called from readPairs(). Call from loop() when
+    // the pairs tick less often than the frame rate.
+    void service() {
+        if (!running_) {
+            return;
+        }
+        uint32_t now_us = micros();
+        for (;;) {
+            if (!in_frame_) {
+                if ((uint32_t)(now_us - frame_start_us_) < frame_period_us_) {
+                    return;
+                }
+                frame_start_us_ += frame_period_us_;
+                if ((uint32_t)(now_us - frame_start_us_) >= frame_period_us_) {
+                    // Too far behind to catch up; restart the frame clock.
+                    frames_skipped_++;
+                    frame_start_us_ = now_us;
+                }
+                in_frame_ = true;
+            }
+
+            const uint32_t settled_us = now_us - select_us_;
+            if (settled_us < cfg_.settle_us) {
+                settle_waits_++;
+                delayMicroseconds(cfg_.settle_us - settled_us);
+            }
+            const uint8_t channel = order_[position_];
+            const uint16_t value = io_.convert();
+
+            // Pipeline: switch first, store after.
+            position_ = (uint8_t)((position_ + 1) % channel_count_);
+            io_.select(order_[position_]);
+            select_us_ = micros();
+            push(rings_[channel], value);
+
+            if (position_ == 0) {
+                in_frame_ = false;
+                frames_++;
+            }
+            now_us = micros();
+        }
+    }
+
+    uint32_t frames() const { return frames_; }
+    uint32_t framesSkipped() const { return frames_skipped_; }
+    // Conversions that waited out part of settle_us.
+    uint32_t settleWaits() const { return settle_waits_; }
+    uint32_t overruns() const { return overruns_; }
+
+private:
+    struct Ring {
+        uint16_t values[RING_CAPACITY];
+        size_t head = 0;
+        size_t count = 0;
+    };
+
+    bool isScanned(int channel) const {
+        return channel >= 0 && channel < (int)MAX_CHANNELS &&
+               (cfg_.channel_mask & (1U << channel)) != 0;
+    }
+
+    void push(Ring& ring, uint16_t value) {
+        if (ring.count == RING_CAPACITY) {
+            ring.head = (ring.head + 1) % RING_CAPACITY;
+            ring.count--;
+            overruns_++;
+        }
+        ring.values[(ring.head + ring.count) % RING_CAPACITY] = value;
+        ring.count++;
+    }
+
+    static uint16_t pop(Ring& ring) {
+        const uint16_t value = ring.values[ring.head];
+        ring.head = (ring.head + 1) % RING_CAPACITY;
+        ring.count--;
+        return value;
+    }
+
+    Config cfg_;
+    MuxIo& io_;
+    Ring rings_[MAX_CHANNELS];
+    uint8_t order_[MAX_CHANNELS] = {};
+    uint8_t channel_count_ = 0;
+    uint8_t position_ = 0;
+    bool in_frame_ = false;
+    bool running_ = false;
+    uint32_t frame_period_us_ = 0;
+    uint32_t frame_start_us_ = 0;
+    uint32_t select_us_ = 0;
+    uint32_t frames_ = 0;
+    uint32_t frames_skipped_ = 0;
+    uint32_t settle_waits_ = 0;
+    uint32_t overruns_ = 0;
+};
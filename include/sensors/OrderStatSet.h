@@ -0,0 +1,98 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Multiset of 12-bit ADC readings with rank queries. A Fenwick tree of counts
+// over the value range gives O(log 4096) insert, erase and k-th lookups with
+// no allocation. Node counts are 8 bit, so at most MAX_COUNT values may be held.
+class OrderStatSet {
+public:
+    static const uint16_t VALUE_RANGE = 4096;
+    static const size_t MAX_COUNT = 255;
+
+    OrderStatSet() { clear(); }
+
+    void clear() {
+        memset(tree_, 0, sizeof(tree_));
+        size_ = 0;
+        sum_ = 0;
+    }
+
+    bool insert(uint16_t value) {
+        if (size_ >= MAX_COUNT) {
+            return false;
+        }
+        value = clampValue(value);
+        for (size_t i = (size_t)value + 1; i <= VALUE_RANGE; i += i & (~i + 1)) {
+            tree_[i]++;
+        }
+        size_++;
+        sum_ += value;
+        return true;
+    }
+
+    // Caller must only erase values it inserted.
+    void erase(uint16_t value) {
+        value = clampValue(value);
+        for (size_t i = (size_t)value + 1; i <= VALUE_RANGE; i += i & (~i + 1)) {
+            tree_[i]--;
+        }
+        size_--;
+        sum_ -= value;
+    }
+
+    // Value at 0-based rank k (k < size()).
+    uint16_t kth(size_t k) const {
+        size_t pos = 0;
+        size_t remaining = k + 1;
+        for (size_t step = VALUE_RANGE; step > 0; step >>= 1) {
+            const size_t next = pos + step;
+            if (next <= VALUE_RANGE && tree_[next] < remaining) {
+                pos = next;
+                remaining -= tree_[next];
+            }
+        }
+        return (uint16_t)pos;
+    }
+
+    uint16_t median() const {
+        if (size_ == 0) {
+            return 0;
+        }
+        const size_t mid = size_ / 2;
+        if ((size_ & 1U) != 0) {
+            return kth(mid);
+        }
+        return (uint16_t)(((uint32_t)kth(mid - 1) + kth(mid) + 1U) / 2U);
+    }
+
+    // Mean after dropping `trim` values from each end; O(trim * log range).
+    uint16_t trimmedMean(size_t trim) const {
+        if (size_ == 0) {
+            return 0;
+        }
+        if (trim * 2 >= size_) {
+            return median();
+        }
+        uint32_t sum = sum_;
+        for (size_t i = 0; i < trim; ++i) {
+            sum -= kth(i);
+            sum -= kth(size_ - 1 - i);
+        }
+        const size_t kept = size_ - (2 * trim);
+        return (uint16_t)((sum + (kept / 2)) / kept);
+    }
+
+    size_t size() const { return size_; }
+
+private:
+    static uint16_t clampValue(uint16_t value) {
+        return (value < VALUE_RANGE) ? value : (uint16_t)(VALUE_RANGE - 1);
+    }
+
+    uint8_t tree_[VALUE_RANGE + 1];
+    size_t size_ = 0;
+    uint32_t sum_ = 0;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdint.h>
+
+// Welford mean/variance in constant memory. remove() reverses add() for
+// sliding windows; callers should rebuild now and then to shed float drift.
+class RunningStats {
+public:
+    void clear() {
+        count_ = 0;
+        mean_ = 0.0f;
+        m2_ = 0.0f;
+    }
+
+    void add(float x) {
+        count_++;
+        const float delta = x - mean_;
+        mean_ += delta / (float)count_;
+        m2_ += delta * (x - mean_);
+    }
+
+    void remove(float x) {
+        if (count_ <= 1) {
+            clear();
+            return;
+        }
+        count_--;
+        const float delta = x - mean_;
+        mean_ -= delta / (float)count_;
+        m2_ -= delta * (x - mean_);
+        if (m2_ < 0.0f) {
+            m2_ = 0.0f;
+        }
+    }
+
+    uint32_t count() const { return count_; }
+    float mean() const { return mean_; }
+
+    // Sample variance (n - 1); 0 until two values are in.
+    float variance() const {
+        return (count_ > 1) ? (m2_ / (float)(count_ - 1)) : 0.0f;
+    }
+
+private:
+    uint32_t count_ = 0;
+    float mean_ = 0.0f;
+    float m2_ = 0.0f;
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Per-slot rings for a round-robin ADC scan. Every value carries the index of
+// the scan pass it came from; a pass starts whenever the slot order wraps.
+// Pairs are only formed from the same pass, so a lost conversion (DMA
+// overflow, ring overrun on one slot) costs that pass instead of shifting one
+// input against the other for good.
+template <size_t Slots, size_t Capacity>
+class ScanFrameRings {
+public:
+    void reset() {
+        for (size_t i = 0; i < Slots; ++i) {
+            rings_[i].head = 0;
+            rings_[i].count = 0;
+        }
+        last_slot_ = Slots;
+        frame_ = 0;
+    }
+
+    void push(size_t slot, uint16_t value) {
+        if (slot >= Slots) {
+            return;
+        }
+        if (slot <= last_slot_) {
+            frame_++;
+        }
+        last_slot_ = slot;
+        Ring& ring = rings_[slot];
+        if (ring.count == Capacity) {
+            dropFront(ring);
+            overruns_++;
+        }
+        const size_t idx = (ring.head + ring.count) % Capacity;
+        ring.value[idx] = value;
+        ring.frame[idx] = frame_;
+        ring.count++;
+    }
+
+    size_t popPairs(size_t slot_a, size_t slot_b, uint16_t* out_a, uint16_t* out_b, size_t max_pairs) {
+        if (slot_a >= Slots || slot_b >= Slots) {
+            return 0;
+        }
+        Ring& a = rings_[slot_a];
+        Ring& b = rings_[slot_b];
+        size_t n = 0;
+        while (n < max_pairs && a.count > 0 && b.count > 0) {
+            const int16_t lead = (int16_t)(a.frame[a.head] - b.frame[b.head]);
+            if (lead != 0) {
+                dropFront((lead < 0) ? a : b);
+                resyncs_++;
+                continue;
+            }
+            out_a[n] = a.value[a.head];
+            out_b[n] = b.value[b.head];
+            dropFront(a);
+            dropFront(b);
+            n++;
+        }
+        return n;
+    }
+
+    size_t count(size_t slot) const { return (slot < Slots) ? rings_[slot].count : 0; }
+    uint32_t overruns() const { return overruns_; }
+    // Values dropped because the other input had no sample from that pass.
+    uint32_t resyncs() const { return resyncs_; }
+
+private:
+    struct Ring {
+        uint16_t value[Capacity];
+        uint16_t frame[Capacity]; // Pass index, compared modulo 2^16
+        size_t head = 0;
+        size_t count = 0;
+    };
+
+    static void dropFront(Ring& ring) {
+        ring.head = (ring.head + 1) % Capacity;
+        ring.count--;
+    }
+
+    Ring rings_[Slots];
+    size_t last_slot_ = Slots;
+    uint16_t frame_ = 0;
+    uint32_t overruns_ = 0;
+    uint32_t resyncs_ = 0;
+};
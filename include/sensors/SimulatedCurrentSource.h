@@ -0,0 +1,86 @@
+#pragma once
+
+#include "util/Platform.h"
+#include <math.h>
+
+#include "sensors/CurrentSource.h"
+
+// Host-side current trace for CurrentMonitor: a brushed DC motor with
+// back-EMF, a first-order speed response and Coulomb friction, driven by the
+// duty the test passes to setApplied(). jam() stops the rotor at once, as a
+// hard stop or an obstruction would. Time is micros().
+class SimulatedCurrentSource : public CurrentSource {
+public:
+    struct Config {
+        float stall_amps;   // Locked rotor at full duty (supply / winding R)
+        float no_load_amps; // Friction; also the breakaway duty x stall_amps
+        float mech_tau_ms;
+        float noise_amps;   // Uniform +/-, per read
+        bool averages_pwm;
+    };
+
+    explicit SimulatedCurrentSource(const Config& cfg)
+        : cfg_(cfg) {}
+
+    void setApplied(float signed_norm) {
+        advance();
+        applied_ = constrain(signed_norm, -1.0f, 1.0f);
+    }
+
+    void jam(bool jammed) {
+        advance();
+        jammed_ = jammed;
+        if (jammed_) {
+            speed_ = 0.0f;
+        }
+    }
+
+    bool read(float& amps) override {
+        advance();
+        const float motor = cfg_.stall_amps * fabsf(applied_ - speed_);
+        const float mean = cfg_.averages_pwm ? (fabsf(applied_) * motor) : motor;
+        amps = max(mean + (noise() * cfg_.noise_amps), 0.0f);
+        reads_++;
+        return true;
+    }
+
+    bool averagesPwm() const override { return cfg_.averages_pwm; }
+
+    // Normalized back-EMF: 1 = no-load speed at full duty.
+    float speed() const { return speed_; }
+    uint32_t reads() const { return reads_; }
+
+private:
+    void advance() {
+        const unsigned long now_us = micros();
+        const float dt_ms = (float)(uint32_t)(now_us - last_us_) / 1000.0f;
+        last_us_ = now_us;
+        if (jammed_ || dt_ms <= 0.0f) {
+            return;
+        }
+        const float friction = (cfg_.stall_amps > 0.0f) ? (cfg_.no_load_amps / cfg_.stall_amps) : 0.0f;
+        if (speed_ == 0.0f && fabsf(applied_) <= friction) {
+            return;
+        }
+        const float dir = (applied_ != 0.0f) ? applied_ : speed_;
+        const float goal = applied_ - ((dir > 0.0f) ? friction : -friction);
+        const float k = (cfg_.mech_tau_ms > 0.0f) ? min(dt_ms / cfg_.mech_tau_ms, 1.0f) : 1.0f;
+        const float next = speed_ + ((goal - speed_) * k);
+        // Friction holds the rotor once it coasts through zero.
+        speed_ = (applied_ == 0.0f && (next > 0.0f) != (speed_ > 0.0f)) ? 0.0f : next;
+    }
+
+    // Uniform in [-1, 1), deterministic per instance.
+    float noise() {
+        rng_ = (rng_ * 1664525UL) + 1013904223UL;
+        return ((float)(rng_ >> 8) / 8388608.0f) - 1.0f;
+    }
+
+    Config cfg_;
+    float applied_ = 0.0f;
+    float speed_ = 0.0f;
+    bool jammed_ = false;
+    unsigned long last_us_ = 0;
+    uint32_t rng_ = 12345;
+    uint32_t reads_ = 0;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "util/Platform.h"
+#include <math.h>
+
+#include "sensors/MuxIo.h"
+
+// Host-side mux model for MuxScanner. The common node is an RC that starts
+// from the previous channel's voltage at every select, so a short settle time
+// shows up as crosstalk from the channel scanned before. Time is micros().
+class SimulatedMuxIo : public MuxIo {
+public:
+    static const size_t CHANNEL_COUNT = 16;
+
+    explicit SimulatedMuxIo(float tau_us)
+        : tau_us_(tau_us) {}
+
+    void setLevel(uint8_t channel, uint16_t counts) {
+        if (channel < CHANNEL_COUNT) {
+            levels_[channel] = (float)counts;
+        }
+    }
+
+    void select(uint8_t channel) override {
+        node_start_ = nodeNow();
+        selected_ = (channel < CHANNEL_COUNT) ? channel : 0;
+        select_us_ = micros();
+        selects_++;
+    }
+
+    uint16_t convert() override {
+        conversions_++;
+        const float v = nodeNow();
+        return (uint16_t)constrain(v + 0.5f, 0.0f, 4095.0f);
+    }
+
+    uint32_t selectCount() const { return selects_; }
+    uint32_t conversionCount() const { return conversions_; }
+
+private:
+    float nodeNow() const {
+        const float target = levels_[selected_];
+        if (tau_us_ <= 0.0f) {
+            return target;
+        }
+        const float dt = (float)(uint32_t)(micros() - select_us_);
+        return target + ((node_start_ - target) * expf(-dt / tau_us_));
+    }
+
+    float tau_us_;
+    float levels_[CHANNEL_COUNT] = {};
+    uint8_t selected_ = 0;
+    float node_start_ = 0.0f;
+    uint32_t select_us_ = 0;
+    uint32_t selects_ = 0;
+    uint32_t conversions_ = 0;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sensors/LightSampleSource.h"
+
+// Host-side stand-in for the DMA sampler: frames pushed by a test or a replay
+// tool are handed to LightSensorPair exactly like hardware frames. Inputs are
+// ignored, so one instance feeds one pair.
+template <size_t Capacity>
+class SyntheticSampleSource : public LightSampleSource {
+public:
+    explicit SyntheticSampleSource(uint32_t sample_rate_hz)
+        : sample_rate_hz_(sample_rate_hz) {}
+
+    uint32_t sampleRateHz() const override { return sample_rate_hz_; }
+
+    bool push(uint16_t a, uint16_t b) {
+        if (count_ >= Capacity) {
+            dropped_++;
+            return false;
+        }
+        const size_t idx = (head_ + count_) % Capacity;
+        a_[idx] = a;
+        b_[idx] = b;
+        count_++;
+        return true;
+    }
+
+    size_t pushFrame(const uint16_t* a, const uint16_t* b, size_t n) {
+        size_t pushed = 0;
+        while (pushed < n && push(a[pushed], b[pushed])) {
+            pushed++;
+        }
+        return pushed;
+    }
+
+    size_t readPairs(int input_a,
+                     int input_b,
+                     uint16_t* out_a,
+                     uint16_t* out_b,
+                     size_t max_pairs) override {
+        (void)input_a;
+        (void)input_b;
+        size_t n = 0;
+        while (n < max_pairs && count_ > 0) {
+            out_a[n] = a_[head_];
+            out_b[n] = b_[head_];
+            head_ = (head_ + 1) % Capacity;
+            count_--;
+            n++;
+        }
+        return n;
+    }
+
+    size_t pending() const { return count_; }
+    uint32_t dropped() const { return dropped_; }
+
+private:
+    uint32_t sample_rate_hz_;
+    uint16_t a_[Capacity];
+    uint16_t b_[Capacity];
+    size_t head_ = 0;
+    size_t count_ = 0;
+    uint32_t dropped_ = 0;
+};
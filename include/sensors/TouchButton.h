@@ -1,6 +1,6 @@
 #pragma once
 
-#include <Arduino.h>
+#include "util/Platform.h"
 
 class TouchButton {
 public:
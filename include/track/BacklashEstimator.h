@@ -0,0 +1,96 @@
+#pragma once
+
+#include "util/Platform.h"
+
+// Learns gear backlash as motor-on time: the motor time from a command until
+// the window diff moves by min_change_percent is measured for moves that
+// reverse direction and for moves that keep it. The latter is the plain
+// sensing lag; what reversals take on top of it is slack.
+class BacklashEstimator {
+public:
+    struct Config {
+        bool enabled;
+        float min_change_percent; // Diff change that counts as "the axis moved"
+        float learn_rate;         // 0..1, weight of each new measurement
+        unsigned long max_ms;     // Estimate clamp; longer measurements are dropped
+    };
+
+    BacklashEstimator(const Config& cfg, uint32_t initial_ms)
+        : cfg_(cfg), estimate_ms_((float)initial_ms) {}
+
+    // Every controller output; sign is -1, 0 or +1, diff the window diff it
+    // was computed from. A move that stops before the diff responds is
+    // dropped: the lag behind it would be counted on the next move.
+    void onCommand(int sign, uint32_t motor_on_ms, float diff_percent) {
+        if (!cfg_.enabled || sign == last_cmd_sign_) {
+            return;
+        }
+        last_cmd_sign_ = sign;
+        if (measuring_) {
+            measuring_ = false;
+            dropped_++;
+        }
+        if (sign == 0) {
+            return;
+        }
+
+        measuring_ = true;
+        measure_reversal_ = last_dir_ != 0 && sign != last_dir_;
+        measure_sign_ = sign;
+        start_on_ms_ = motor_on_ms;
+        ref_diff_ = diff_percent;
+        last_dir_ = sign;
+    }
+
+    // Completed windows. Returns true when the backlash estimate changed.
+    bool onWindow(float diff_percent, uint32_t motor_on_ms) {
+        if (!measuring_) {
+            return false;
+        }
+        const uint32_t elapsed = motor_on_ms - start_on_ms_;
+        if (elapsed > (cfg_.max_ms + (uint32_t)lag_ms_)) {
+            measuring_ = false;
+            dropped_++;
+            return false;
+        }
+        // Driving toward +diff reduces it.
+        if (((ref_diff_ - diff_percent) * (float)measure_sign_) < cfg_.min_change_percent) {
+            return false;
+        }
+
+        measuring_ = false;
+        const float rate = constrain(cfg_.learn_rate, 0.0f, 1.0f);
+        if (!measure_reversal_) {
+            lag_ms_ = has_lag_ ? (lag_ms_ + (((float)elapsed - lag_ms_) * rate)) : (float)elapsed;
+            has_lag_ = true;
+            return false;
+        }
+        if (!has_lag_) {
+            return false;
+        }
+        const float slack = constrain((float)elapsed - lag_ms_, 0.0f, (float)cfg_.max_ms);
+        estimate_ms_ += (slack - estimate_ms_) * rate;
+        measurements_++;
+        return true;
+    }
+
+    uint32_t estimateMs() const { return (uint32_t)lroundf(estimate_ms_); }
+    float lagMs() const { return lag_ms_; }
+    uint32_t measurements() const { return measurements_; }
+    uint32_t dropped() const { return dropped_; }
+
+private:
+    Config cfg_;
+    float estimate_ms_ = 0.0f;
+    float lag_ms_ = 0.0f;
+    bool has_lag_ = false;
+    bool measuring_ = false;
+    bool measure_reversal_ = false;
+    int measure_sign_ = 0;
+    int last_cmd_sign_ = 0;
+    int last_dir_ = 0;
+    uint32_t start_on_ms_ = 0;
+    float ref_diff_ = 0.0f;
+    uint32_t measurements_ = 0;
+    uint32_t dropped_ = 0;
+};
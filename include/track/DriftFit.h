@@ -0,0 +1,144 @@
+#pragma once
+
+#include "util/Platform.h"
+
+// Weighted least-squares line through (t, diff) with the slope's standard
+// error. Older samples fade with time constant memory_s, so a long hold
+// fits the recent drift and the sums stay bounded. Times are relative to the
+// newest sample: the origin moves with every add. sample_count dedups a diff
+// that did not change since the last add.
+class DriftFit {
+public:
+    static constexpr float DEFAULT_MEMORY_S = 120.0f;
+
+    explicit DriftFit(float memory_s = DEFAULT_MEMORY_S)
+        : memory_s_(memory_s) {}
+
+    void reset() {
+        n_ = 0;
+        sum_w_ = 0.0f;
+        sum_t_ = 0.0f;
+        sum_d_ = 0.0f;
+        sum_tt_ = 0.0f;
+        sum_td_ = 0.0f;
+        sum_dd_ = 0.0f;
+        sum_ww_ = 0.0f;
+        sum_ww_t_ = 0.0f;
+        sum_ww_tt_ = 0.0f;
+        span_s_ = 0.0f;
+        slope_ = 0.0f;
+        slope_se_ = 0.0f;
+    }
+
+    void add(uint32_t sample_count, float diff_percent, unsigned long now_ms) {
+        if (n_ > 0 && sample_count == last_count_) {
+            return;
+        }
+        last_count_ = sample_count;
+        if (n_ == 0) {
+            start_ms_ = now_ms;
+            last_ms_ = now_ms;
+        }
+        const float dt = (float)(now_ms - last_ms_) / 1000.0f;
+        last_ms_ = now_ms;
+        if (dt > 0.0f) {
+            shiftOrigin(dt);
+        }
+
+        // The new sample sits at t = 0 with weight 1.
+        n_++;
+        sum_w_ += 1.0f;
+        sum_d_ += diff_percent;
+        sum_dd_ += diff_percent * diff_percent;
+        sum_ww_ += 1.0f;
+        span_s_ = (float)(now_ms - start_ms_) / 1000.0f;
+
+        const float t_mean = sum_t_ / sum_w_;
+        const float s_tt = sum_tt_ - (sum_t_ * t_mean);
+        if (s_tt <= 0.0f) {
+            return;
+        }
+        const float s_td = sum_td_ - (t_mean * sum_d_);
+        const float s_dd = sum_dd_ - ((sum_d_ * sum_d_) / sum_w_);
+        slope_ = s_td / s_tt;
+        // Residual dof W - 2 * sum(w^2) / W is n - 2 for equal weights.
+        const float dof = sum_w_ - (2.0f * sum_ww_ / sum_w_);
+        if (n_ > 2 && dof > 0.0f) {
+            const float var = max(0.0f, s_dd - (slope_ * s_td)) / dof;
+            const float spread = sum_ww_tt_ - (2.0f * t_mean * sum_ww_t_) +
+                                 (t_mean * t_mean * sum_ww_);
+            slope_se_ = sqrtf(var * max(0.0f, spread)) / s_tt;
+        }
+    }
+
+    bool valid(float min_span_s) const { return n_ >= MIN_SAMPLES && span_s_ >= min_span_s; }
+    uint32_t samples() const { return n_; }
+    float slope() const { return slope_; }
+    float slopeStdErr() const { return slope_se_; }
+    // Fitted diff at the newest sample (t = 0).
+    float value() const {
+        return (n_ == 0) ? 0.0f : (sum_d_ - (slope_ * sum_t_)) / sum_w_;
+    }
+
+    // Time until the fitted diff reaches +-db, with the slope taken sigma
+    // standard errors toward each edge; -1 if it never does.
+    float secondsToExit(float db, float sigma) const {
+        const float diff = value();
+        const float up = slope_ + (sigma * slope_se_);
+        const float down = slope_ - (sigma * slope_se_);
+        const float t_up = (up > 0.0f) ? max(0.0f, (db - diff) / up) : -1.0f;
+        const float t_down = (down < 0.0f) ? max(0.0f, (-db - diff) / down) : -1.0f;
+        return earliest(t_up, t_down);
+    }
+
+    // Sooner of two exit times, either of which may be -1 (never).
+    static float earliest(float a, float b) {
+        if (a < 0.0f) {
+            return b;
+        }
+        return (b < 0.0f) ? a : min(a, b);
+    }
+
+private:
+    static const uint32_t MIN_SAMPLES = 4;
+
+    // Every old t becomes t - dt, then all weights fade by exp(-dt / memory).
+    void shiftOrigin(float dt) {
+        sum_tt_ += (dt * dt * sum_w_) - (2.0f * dt * sum_t_);
+        sum_td_ -= dt * sum_d_;
+        sum_t_ -= dt * sum_w_;
+        sum_ww_tt_ += (dt * dt * sum_ww_) - (2.0f * dt * sum_ww_t_);
+        sum_ww_t_ -= dt * sum_ww_;
+
+        const float decay = (memory_s_ > 0.0f) ? expf(-dt / memory_s_) : 1.0f;
+        const float decay_2 = decay * decay;
+        sum_w_ *= decay;
+        sum_t_ *= decay;
+        sum_d_ *= decay;
+        sum_tt_ *= decay;
+        sum_td_ *= decay;
+        sum_dd_ *= decay;
+        sum_ww_ *= decay_2;
+        sum_ww_t_ *= decay_2;
+        sum_ww_tt_ *= decay_2;
+    }
+
+    float memory_s_;
+    uint32_t n_ = 0;
+    uint32_t last_count_ = 0;
+    unsigned long start_ms_ = 0;
+    unsigned long last_ms_ = 0;
+    float sum_w_ = 0.0f;
+    float sum_t_ = 0.0f;
+    float sum_d_ = 0.0f;
+    float sum_tt_ = 0.0f;
+    float sum_td_ = 0.0f;
+    float sum_dd_ = 0.0f;
+    // Squared weights, for the slope variance.
+    float sum_ww_ = 0.0f;
+    float sum_ww_t_ = 0.0f;
+    float sum_ww_tt_ = 0.0f;
+    float span_s_ = 0.0f;
+    float slope_ = 0.0f;
+    float slope_se_ = 0.0f;
+};
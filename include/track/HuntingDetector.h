@@ -0,0 +1,123 @@
+#pragma once
+
+#include "util/Platform.h"
+
+#include "util/FixedPoint.h"
+
+// Limit-cycle detector on the controller output: min_reversals direction
+// changes of the target within window_ms is hunting. Each detection widens
+// the deadband by boost_step_percent (up to max_boost_percent); the boost
+// bleeds off at decay_percent_per_s so a quieter axis gets its precision back.
+// Integer state (Q15 diff scale, boost with 16 extra fraction bits for the
+// slow decay): update() runs on every controller output.
+class HuntingDetector {
+public:
+    struct Config {
+        bool enabled;
+        unsigned long window_ms;
+        uint8_t min_reversals;    // 2..MAX_REVERSALS
+        float boost_step_percent;
+        float max_boost_percent;
+        float decay_percent_per_s;
+    };
+
+    static const uint8_t MAX_REVERSALS = 8;
+
+    explicit HuntingDetector(const Config& cfg)
+        : cfg_(cfg),
+          boost_step_((int64_t)Q15::fromPercent(fabsf(cfg.boost_step_percent)) << BOOST_SHIFT),
+          max_boost_((int64_t)Q15::fromPercent(fabsf(cfg.max_boost_percent)) << BOOST_SHIFT),
+          decay_per_ms_((int64_t)lroundf(
+              fabsf(cfg.decay_percent_per_s) * ((float)Q15::ONE / 100.0f) * 65.536f)) {}
+
+    void reset() {
+        count_ = 0;
+        last_sign_ = 0;
+        boost_ = 0;
+    }
+
+    // Every controller output (signed Q15 norm). motor_on_ms is
+    // MotorDriver::motorOnMs().
+    void update(int32_t target_q15, uint32_t motor_on_ms, unsigned long now_ms) {
+        if (!cfg_.enabled) {
+            return;
+        }
+        if (last_ms_ != 0 && boost_ > 0) {
+            boost_ = max((int64_t)0, boost_ - (decay_per_ms_ * (int64_t)(now_ms - last_ms_)));
+        }
+        last_ms_ = now_ms;
+
+        const int sign = (target_q15 > 0) - (target_q15 < 0);
+        if (sign == 0) {
+            return;
+        }
+        const int32_t mag = Q15::magnitude(target_q15);
+        amplitude_ = (amplitude_ == 0)
+            ? mag
+            : (amplitude_ + Q15::mul(mag - amplitude_, AMPLITUDE_ALPHA));
+
+        if (last_sign_ == 0 || sign == last_sign_) {
+            last_sign_ = sign;
+            return;
+        }
+        last_sign_ = sign;
+        reversals_++;
+
+        // Oldest entry drops out once the ring is full.
+        if (count_ == MAX_REVERSALS) {
+            for (uint8_t i = 1; i < MAX_REVERSALS; i++) {
+                times_[i - 1] = times_[i];
+                on_ms_[i - 1] = on_ms_[i];
+            }
+            count_--;
+        }
+        times_[count_] = now_ms;
+        on_ms_[count_] = motor_on_ms;
+        count_++;
+
+        const uint8_t need = (cfg_.min_reversals < 2) ? 2
+            : (cfg_.min_reversals > MAX_REVERSALS) ? (uint8_t)MAX_REVERSALS
+            : cfg_.min_reversals;
+        if (count_ < need) {
+            return;
+        }
+        const uint8_t first = count_ - need;
+        if ((now_ms - times_[first]) > cfg_.window_ms) {
+            return;
+        }
+
+        events_++;
+        hunting_motor_ms_ += motor_on_ms - on_ms_[first];
+        boost_ = min(boost_ + boost_step_, max_boost_);
+        count_ = 0;
+    }
+
+    int32_t boostQ15() const { return (int32_t)(boost_ >> BOOST_SHIFT); }
+    float boostPercent() const { return Q15::toPercent(boostQ15()); }
+    bool isBoosted() const { return boost_ > 0; }
+    uint32_t events() const { return events_; }
+    uint32_t reversals() const { return reversals_; }
+    // Motor-on time spent inside detected limit cycles.
+    uint32_t huntingMotorMs() const { return hunting_motor_ms_; }
+    // Smoothed |target| over the recent outputs.
+    float amplitude() const { return Q15::toFloat(amplitude_); }
+
+private:
+    static const int BOOST_SHIFT = 16;
+    static const int32_t AMPLITUDE_ALPHA = Q15::fromFloat(0.2f);
+
+    Config cfg_;
+    int64_t boost_step_;
+    int64_t max_boost_;
+    int64_t decay_per_ms_;
+    unsigned long times_[MAX_REVERSALS] = {};
+    uint32_t on_ms_[MAX_REVERSALS] = {};
+    uint8_t count_ = 0;
+    int last_sign_ = 0;
+    unsigned long last_ms_ = 0;
+    int64_t boost_ = 0;
+    int32_t amplitude_ = 0;
+    uint32_t events_ = 0;
+    uint32_t reversals_ = 0;
+    uint32_t hunting_motor_ms_ = 0;
+};
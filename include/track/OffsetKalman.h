@@ -0,0 +1,108 @@
+#pragma once
+
+#include <math.h>
+
+// Two-state Kalman filter of the sun offset seen by one axis, in diff
+// percent: x = [offset, drift (%/s)]. The motor is the known input: driving
+// at norm u for dt moves the offset by -motor_gain * u * dt, so the filter
+// does not mistake its own motion (or the window lag behind it) for noise.
+class OffsetKalman {
+public:
+    struct Config {
+        float motor_gain; // Offset change (%/s) per unit applied norm
+        float q_offset;   // Process noise, offset (%^2/s)
+        float q_drift;    // Process noise, drift ((%/s)^2/s)
+        float gate_sigma; // Innovations beyond this many sigma re-seed the filter
+    };
+
+    explicit OffsetKalman(const Config& cfg)
+        : cfg_(cfg) {}
+
+    void reset() {
+        initialized_ = false;
+        x_offset_ = 0.0f;
+        x_drift_ = 0.0f;
+        motion_ = 0.0f;
+    }
+
+    // Integral of the applied norm since the last update (norm * s).
+    void addMotion(float applied_norm, float dt_s) { motion_ += applied_norm * dt_s; }
+
+    void predict(float dt_s) {
+        if (!initialized_ || dt_s <= 0.0f) {
+            motion_ = 0.0f;
+            return;
+        }
+        x_offset_ += (x_drift_ * dt_s) - (cfg_.motor_gain * motion_);
+        motion_ = 0.0f;
+
+        // P = F P F' + Q dt, F = [1 dt; 0 1]
+        const float p00 = p00_ + (dt_s * (p01_ + p10_)) + (dt_s * dt_s * p11_);
+        const float p01 = p01_ + (dt_s * p11_);
+        const float p10 = p10_ + (dt_s * p11_);
+        p00_ = p00 + (cfg_.q_offset * dt_s);
+        p01_ = p01;
+        p10_ = p10;
+        p11_ = p11_ + (cfg_.q_drift * dt_s);
+    }
+
+    // z: measured diff (%), r: its variance (%^2).
+    void update(float z, float r) {
+        if (!initialized_) {
+            seed(z, r);
+            return;
+        }
+        const float s = p00_ + r;
+        const float y = z - x_offset_;
+        if (cfg_.gate_sigma > 0.0f && (y * y) > (cfg_.gate_sigma * cfg_.gate_sigma * s)) {
+            // Cloud edge, wake-up after a long hold: the model no longer applies.
+            reseeds_++;
+            seed(z, r);
+            return;
+        }
+        const float k0 = p00_ / s;
+        const float k1 = p10_ / s;
+        x_offset_ += k0 * y;
+        x_drift_ += k1 * y;
+
+        const float p00 = (1.0f - k0) * p00_;
+        const float p01 = (1.0f - k0) * p01_;
+        const float p10 = p10_ - (k1 * p00_);
+        const float p11 = p11_ - (k1 * p01_);
+        p00_ = p00;
+        p01_ = p01;
+        p10_ = p10;
+        p11_ = p11;
+    }
+
+    bool isInitialized() const { return initialized_; }
+    float offset() const { return x_offset_; }
+    float drift() const { return x_drift_; }
+    float offsetSigma() const { return sqrtf(fmaxf(p00_, 0.0f)); }
+    unsigned long reseeds() const { return reseeds_; }
+
+private:
+    void seed(float z, float r) {
+        x_offset_ = z;
+        x_drift_ = 0.0f;
+        p00_ = r;
+        p01_ = 0.0f;
+        p10_ = 0.0f;
+        p11_ = INITIAL_DRIFT_VAR;
+        motion_ = 0.0f;
+        initialized_ = true;
+    }
+
+    static constexpr float INITIAL_DRIFT_VAR = 1.0f;
+
+    Config cfg_;
+    bool initialized_ = false;
+    float x_offset_ = 0.0f;
+    float x_drift_ = 0.0f;
+    float p00_ = 0.0f;
+    float p01_ = 0.0f;
+    float p10_ = 0.0f;
+    float p11_ = 0.0f;
+    float motion_ = 0.0f;
+    unsigned long reseeds_ = 0;
+};
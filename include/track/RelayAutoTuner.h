@@ -0,0 +1,162 @@
+#pragma once
+
+#include <math.h>
+
+#include "track/TrackerController.h"
+#include "util/Platform.h"
+
+// Åström–Hägglund relay experiment on one axis. The motor is driven at
+// +-relay_norm toward the sun, switching when the window diff crosses
+// +-hysteresis; the loop settles into a limit cycle whose amplitude a and
+// period Tu give the ultimate gain Ku = 4 d / (pi sqrt(a^2 - h^2)).
+// Ziegler–Nichols turns (Ku, Tu) into PID gains; the deadband is the
+// overshoot past the switching point (what the lag carries the axis on
+// after a stop), and the motor IIR is kept well inside Tu. RelayTuneStore
+// keeps the result in NVS.
+class RelayAutoTuner {
+public:
+    struct Config {
+        const char* nvs_namespace;
+        const char* nvs_prefix;     // Per axis, keeps keys unique in the namespace
+        float relay_norm;           // 0..1, usually pwm_min
+        float hysteresis_percent;   // Above the diff noise
+        uint8_t cycles;             // Measured periods, after one settling period
+        unsigned long timeout_ms;
+        unsigned long motor_update_interval_ms;
+    };
+
+    enum class State {
+        Idle,
+        Running,
+        Done,
+        Failed
+    };
+
+    struct Result {
+        float ku;          // norm per percent
+        float tu_s;
+        float amplitude_percent;
+        TrackerController::Tuning tuning;
+        float motor_smooth;
+    };
+
+    explicit RelayAutoTuner(const Config& cfg)
+        : cfg_(cfg) {}
+
+    void start(unsigned long now_ms) {
+        state_ = State::Running;
+        start_ms_ = now_ms;
+        relay_sign_ = 0;
+        last_rise_ms_ = 0;
+        periods_ = 0;
+        period_sum_ms_ = 0;
+        amplitude_sum_ = 0.0f;
+        diff_max_ = 0.0f;
+        diff_min_ = 0.0f;
+    }
+
+    void cancel() {
+        if (state_ == State::Running) {
+            state_ = State::Idle;
+        }
+    }
+
+    State state() const { return state_; }
+    bool isRunning() const { return state_ == State::Running; }
+
+    // Relay output to apply as the axis target while running, else 0.
+    float output() const {
+        return (state_ == State::Running) ? ((float)relay_sign_ * relay_norm()) : 0.0f;
+    }
+
+    // Completed windows only.
+    void update(float diff_percent, unsigned long now_ms) {
+        if (state_ != State::Running) {
+            return;
+        }
+        if ((now_ms - start_ms_) > cfg_.timeout_ms) {
+            state_ = State::Failed;
+            return;
+        }
+
+        const float h = fabsf(cfg_.hysteresis_percent);
+        if (relay_sign_ == 0) {
+            relay_sign_ = (diff_percent >= 0.0f) ? 1 : -1;
+            diff_max_ = diff_percent;
+            diff_min_ = diff_percent;
+            return;
+        }
+        diff_max_ = max(diff_max_, diff_percent);
+        diff_min_ = min(diff_min_, diff_percent);
+
+        if (relay_sign_ < 0 && diff_percent > h) {
+            relay_sign_ = 1;
+            onRise(now_ms);
+        } else if (relay_sign_ > 0 && diff_percent < -h) {
+            relay_sign_ = -1;
+        }
+    }
+
+    // Valid once state() == Done.
+    bool result(Result& out) const {
+        if (state_ != State::Done || periods_ == 0) {
+            return false;
+        }
+        const float h = fabsf(cfg_.hysteresis_percent);
+        const float a = amplitude_sum_ / (float)periods_;
+        if (a <= h) {
+            return false;
+        }
+        out.amplitude_percent = a;
+        out.tu_s = (float)period_sum_ms_ / ((float)periods_ * 1000.0f);
+        out.ku = (4.0f * relay_norm()) / (PI * sqrtf((a * a) - (h * h)));
+
+        out.tuning.pid_kp = ZN_KP * out.ku;
+        out.tuning.pid_ki = (ZN_KI * out.ku) / out.tu_s;
+        out.tuning.pid_kd = ZN_KD * out.ku * out.tu_s;
+        out.tuning.diff_deadband = max(h, a - h);
+        out.tuning.diff_pwm_threshold = PWM_THRESHOLD_PER_AMPLITUDE * a;
+
+        const float tau_s = out.tu_s / IIR_TAU_PER_TU;
+        const float dt_s = (float)max(cfg_.motor_update_interval_ms, 1UL) / 1000.0f;
+        out.motor_smooth = constrain(expf(-dt_s / tau_s), 0.0f, MAX_SMOOTH);
+        return true;
+    }
+
+private:
+    // Classic Ziegler–Nichols PID: Kp = 0.6 Ku, Ti = Tu / 2, Td = Tu / 8.
+    static constexpr float ZN_KP = 0.6f;
+    static constexpr float ZN_KI = 1.2f;
+    static constexpr float ZN_KD = 0.075f;
+    static constexpr float PWM_THRESHOLD_PER_AMPLITUDE = 2.0f;
+    static constexpr float IIR_TAU_PER_TU = 60.0f;
+    static constexpr float MAX_SMOOTH = 0.95f;
+
+    float relay_norm() const { return constrain(cfg_.relay_norm, 0.0f, 1.0f); }
+
+    // Rising switch: closes a period; the first one only ends the settling.
+    void onRise(unsigned long now_ms) {
+        if (last_rise_ms_ != 0) {
+            period_sum_ms_ += now_ms - last_rise_ms_;
+            amplitude_sum_ += (diff_max_ - diff_min_) * 0.5f;
+            periods_++;
+        }
+        last_rise_ms_ = now_ms;
+        diff_max_ = 0.0f;
+        diff_min_ = 0.0f;
+        if (periods_ >= cfg_.cycles) {
+            state_ = State::Done;
+        }
+    }
+
+    Config cfg_;
+    State state_ = State::Idle;
+    unsigned long start_ms_ = 0;
+    int relay_sign_ = 0;
+    unsigned long last_rise_ms_ = 0;
+    uint8_t periods_ = 0;
+    unsigned long period_sum_ms_ = 0;
+    float amplitude_sum_ = 0.0f;
+    float diff_max_ = 0.0f;
+    float diff_min_ = 0.0f;
+};
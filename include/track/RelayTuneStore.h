@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+
+#include "track/RelayAutoTuner.h"
+
+// One axis's RelayAutoTuner result in NVS, under the tuner config's
+// namespace and per-axis key prefix.
+class RelayTuneStore {
+public:
+    explicit RelayTuneStore(const RelayAutoTuner::Config& cfg)
+        : cfg_(cfg) {}
+
+    bool load(RelayAutoTuner::Result& out) {
+        Preferences prefs;
+        if (!prefs.begin(cfg_.nvs_namespace, true)) {
+            return false;
+        }
+        char key[16];
+        const bool ok = prefs.getUChar(makeKey(key, 'f'), 0) == NVS_FORMAT;
+        if (ok) {
+            out.ku = prefs.getFloat(makeKey(key, 'u'), 0.0f);
+            out.tu_s = prefs.getFloat(makeKey(key, 'T'), 0.0f);
+            out.amplitude_percent = prefs.getFloat(makeKey(key, 'a'), 0.0f);
+            out.tuning.diff_deadband = prefs.getFloat(makeKey(key, 'd'), 0.0f);
+            out.tuning.diff_pwm_threshold = prefs.getFloat(makeKey(key, 't'), 0.0f);
+            out.tuning.pid_kp = prefs.getFloat(makeKey(key, 'p'), 0.0f);
+            out.tuning.pid_ki = prefs.getFloat(makeKey(key, 'i'), 0.0f);
+            out.tuning.pid_kd = prefs.getFloat(makeKey(key, 'k'), 0.0f);
+            out.motor_smooth = prefs.getFloat(makeKey(key, 's'), 0.0f);
+        }
+        prefs.end();
+        return ok;
+    }
+
+    bool save(const RelayAutoTuner::Result& r) {
+        Preferences prefs;
+        if (!prefs.begin(cfg_.nvs_namespace, false)) {
+            return false;
+        }
+        char key[16];
+        prefs.putFloat(makeKey(key, 'u'), r.ku);
+        prefs.putFloat(makeKey(key, 'T'), r.tu_s);
+        prefs.putFloat(makeKey(key, 'a'), r.amplitude_percent);
+        prefs.putFloat(makeKey(key, 'd'), r.tuning.diff_deadband);
+        prefs.putFloat(makeKey(key, 't'), r.tuning.diff_pwm_threshold);
+        prefs.putFloat(makeKey(key, 'p'), r.tuning.pid_kp);
+        prefs.putFloat(makeKey(key, 'i'), r.tuning.pid_ki);
+        prefs.putFloat(makeKey(key, 'k'), r.tuning.pid_kd);
+        prefs.putFloat(makeKey(key, 's'), r.motor_smooth);
+        prefs.putUChar(makeKey(key, 'f'), NVS_FORMAT);
+        prefs.end();
+        return true;
+    }
+
+private:
+    static const uint8_t NVS_FORMAT = 1;
+
+    const char* makeKey(char* key, char suffix) const {
+        snprintf(key, 16, "%s_%c", cfg_.nvs_prefix, suffix);
+        return key;
+    }
+
+    RelayAutoTuner::Config cfg_;
+};
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "util/Platform.h"
+
+// Coarse search for an axis whose LDR pair has lost the sun (morning, panel
+// moved by hand). Drives toward an endstop; the TravelGuard sweep that the
+// endstop starts carries the axis end to end at sweep speed while the summed
+// LDR level is recorded against a dead-reckoned position (integral of
+// |applied norm| dt). The axis then drives back to the brightest position
+// and fine tracking takes over; time-to-lock is the first in-deadband window.
+class SunAcquisition {
+public:
+    struct Config {
+        bool enabled;
+        float seek_norm;          // 0..1, toward the start endstop
+        int seek_dir;             // Motor sign toward the start endstop
+        uint32_t lost_level;      // max(avg_a, avg_b) below this counts as lost
+        unsigned long lost_ms;    // ...for this long before a search
+        unsigned long retry_ms;   // Holdoff between searches (e.g. at night)
+        uint32_t min_peak_level;  // Sweep peak below this: give up
+        unsigned long timeout_ms;
+    };
+
+    enum class State {
+        Idle,
+        Seek,
+        Sweep,
+        Return,
+        Done,
+        Failed
+    };
+
+    explicit SunAcquisition(const Config& cfg)
+        : cfg_(cfg) {}
+
+    void start(unsigned long now_ms) {
+        state_ = State::Seek;
+        start_ms_ = now_ms;
+        last_start_ms_ = now_ms;
+        has_started_ = true;
+        last_tick_ms_ = now_ms;
+        lost_since_ms_ = 0;
+        locked_ = false;
+        time_to_lock_ms_ = 0;
+        peak_level_ = 0;
+        searches_++;
+    }
+
+    void cancel() {
+        if (isActive()) {
+            state_ = State::Idle;
+        }
+    }
+
+    State state() const { return state_; }
+    // Seeking, sweeping or returning: the axis belongs to the search.
+    bool isActive() const {
+        return state_ == State::Seek || state_ == State::Sweep || state_ == State::Return;
+    }
+
+    // Target override while seeking or returning; during the sweep the
+    // TravelGuard override drives the axis.
+    float targetNorm() const {
+        const float mag = constrain(fabsf(cfg_.seek_norm), 0.0f, 1.0f);
+        if (state_ == State::Seek) {
+            return (cfg_.seek_dir >= 0) ? mag : -mag;
+        }
+        if (state_ == State::Return) {
+            return (sweep_dir_ > 0) ? -return_norm_ : return_norm_;
+        }
+        return 0.0f;
+    }
+
+    // Every loop, with the TravelGuard sweep state and the applied motor norm.
+    void tick(unsigned long now_ms, bool sweep_active, float sweep_norm, float applied_norm) {
+        const float dt_s = (float)(now_ms - last_tick_ms_) / 1000.0f;
+        last_tick_ms_ = now_ms;
+        if (!isActive()) {
+            return;
+        }
+        if ((now_ms - start_ms_) > cfg_.timeout_ms) {
+            state_ = State::Failed;
+            return;
+        }
+
+        const float travel = fabsf(applied_norm) * dt_s;
+        if (state_ == State::Seek) {
+            if (sweep_active) {
+                state_ = State::Sweep;
+                sweep_dir_ = (sweep_norm >= 0.0f) ? 1 : -1;
+                return_norm_ = fabsf(sweep_norm);
+                pos_ = 0.0f;
+                window_pos_ = 0.0f;
+                peak_pos_ = 0.0f;
+                peak_level_ = 0;
+            }
+            return;
+        }
+        if (state_ == State::Sweep) {
+            pos_ += travel;
+            if (!sweep_active) {
+                if (peak_level_ < cfg_.min_peak_level) {
+                    state_ = State::Failed;
+                    return;
+                }
+                remaining_ = pos_ - peak_pos_;
+                state_ = State::Return;
+            }
+            return;
+        }
+        // Return
+        remaining_ -= travel;
+        if (remaining_ <= 0.0f) {
+            state_ = State::Done;
+            done_ms_ = now_ms;
+        }
+    }
+
+    // Completed windows of the searched axis.
+    void addWindow(uint32_t avg_a, uint32_t avg_b, bool in_deadband, unsigned long now_ms) {
+        if (state_ == State::Sweep) {
+            // The window averaged the travel since the previous one.
+            const uint32_t level = avg_a + avg_b;
+            if (level > peak_level_) {
+                peak_level_ = level;
+                peak_pos_ = 0.5f * (window_pos_ + pos_);
+            }
+            window_pos_ = pos_;
+            return;
+        }
+        if (state_ == State::Done && !locked_ && in_deadband) {
+            locked_ = true;
+            time_to_lock_ms_ = now_ms - start_ms_;
+            return;
+        }
+        if (state_ == State::Idle || state_ == State::Done || state_ == State::Failed) {
+            if (max(avg_a, avg_b) >= cfg_.lost_level) {
+                lost_since_ms_ = 0;
+            } else if (lost_since_ms_ == 0) {
+                lost_since_ms_ = now_ms;
+            }
+        }
+    }
+
+    // Lost long enough and outside the retry holdoff.
+    bool wantsStart(unsigned long now_ms) const {
+        if (!cfg_.enabled || isActive() || lost_since_ms_ == 0) {
+            return false;
+        }
+        if ((now_ms - lost_since_ms_) < cfg_.lost_ms) {
+            return false;
+        }
+        return !has_started_ || (now_ms - last_start_ms_) >= cfg_.retry_ms;
+    }
+
+    bool isLocked() const { return locked_; }
+    unsigned long timeToLockMs() const { return time_to_lock_ms_; }
+    unsigned long searchMs() const { return done_ms_ - start_ms_; }
+    uint32_t peakLevel() const { return peak_level_; }
+    uint32_t searches() const { return searches_; }
+
+private:
+    Config cfg_;
+    State state_ = State::Idle;
+    unsigned long start_ms_ = 0;
+    unsigned long last_start_ms_ = 0;
+    bool has_started_ = false;
+    unsigned long last_tick_ms_ = 0;
+    unsigned long done_ms_ = 0;
+    unsigned long lost_since_ms_ = 0;
+    int sweep_dir_ = 1;
+    float return_norm_ = 0.0f;
+    float pos_ = 0.0f;        // norm * s since the sweep started
+    float window_pos_ = 0.0f;
+    float peak_pos_ = 0.0f;
+    float remaining_ = 0.0f;
+    uint32_t peak_level_ = 0;
+    bool locked_ = false;
+    unsigned long time_to_lock_ms_ = 0;
+    uint32_t searches_ = 0;
+};
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+#include <time.h>
+
+// Low-cost sun position (Astronomical Almanac low-precision sun, ~0.02 deg
+// from 1950 to 2050, without refraction). The day-dependent terms
+// (declination, equation of time) are tabulated for the current and next UTC
+// midnight and interpolated, so a call costs one sin/cos of the hour angle
+// plus asin/atan2, in float.
+class SunEphemeris {
+public:
+    struct Config {
+        float latitude_deg;  // + north
+        float longitude_deg; // + east
+    };
+
+    struct Position {
+        float azimuth_deg = 0.0f;   // From north, clockwise, 0..360
+        float elevation_deg = 0.0f; // Above the horizon, no refraction
+    };
+
+    struct Rates {
+        Position position;
+        float azimuth_deg_per_s = 0.0f;
+        float elevation_deg_per_s = 0.0f;
+    };
+
+    // RTC times before this are treated as "clock never set".
+    static const time_t MIN_VALID_UTC = 1577836800; // 2020-01-01
+
+    explicit SunEphemeris(const Config& cfg)
+        : cfg_(cfg) {
+        const float lat = cfg_.latitude_deg * DEG_TO_RAD_F;
+        sin_lat_ = sinf(lat);
+        cos_lat_ = cosf(lat);
+    }
+
+    static bool isValidTime(time_t utc) { return utc >= MIN_VALID_UTC; }
+
+    Position position(time_t utc) {
+        const int32_t day = (int32_t)(utc / 86400);
+        const float day_fraction = (float)(utc - ((time_t)day * 86400)) / 86400.0f;
+        if (day != table_day_) {
+            fillTable(day);
+        }
+
+        const float sin_decl = lerp(table_[0].sin_decl, table_[1].sin_decl, day_fraction);
+        const float cos_decl = lerp(table_[0].cos_decl, table_[1].cos_decl, day_fraction);
+        const float eot_min = lerp(table_[0].eot_min, table_[1].eot_min, day_fraction);
+
+        // True solar time -> hour angle (0 at local solar noon).
+        const float tst_min = (day_fraction * 1440.0f) + eot_min + (4.0f * cfg_.longitude_deg);
+        const float ha = ((tst_min / 4.0f) - 180.0f) * DEG_TO_RAD_F;
+        const float sin_ha = sinf(ha);
+        const float cos_ha = cosf(ha);
+
+        const float sin_el = (sin_lat_ * sin_decl) + (cos_lat_ * cos_decl * cos_ha);
+        Position p;
+        p.elevation_deg = asinf(fmaxf(-1.0f, fminf(1.0f, sin_el))) * RAD_TO_DEG_F;
+        // atan2 is measured from south, westward; shift to north, clockwise.
+        float az = atan2f(sin_ha * cos_decl,
+                          (cos_ha * cos_decl * sin_lat_) - (sin_decl * cos_lat_)) * RAD_TO_DEG_F;
+        az += 180.0f;
+        p.azimuth_deg = (az >= 360.0f) ? (az - 360.0f) : az;
+        return p;
+    }
+
+    // Position at utc and rates from a forward difference over step_s.
+    Rates rates(time_t utc, uint32_t step_s = 60) {
+        Rates r;
+        r.position = position(utc);
+        const Position next = position(utc + (time_t)step_s);
+        float d_az = next.azimuth_deg - r.position.azimuth_deg;
+        if (d_az > 180.0f) {
+            d_az -= 360.0f;
+        } else if (d_az < -180.0f) {
+            d_az += 360.0f;
+        }
+        r.azimuth_deg_per_s = d_az / (float)step_s;
+        r.elevation_deg_per_s = (next.elevation_deg - r.position.elevation_deg) / (float)step_s;
+        return r;
+    }
+
+private:
+    static constexpr float DEG_TO_RAD_F = 0.0174532925f;
+    static constexpr float RAD_TO_DEG_F = 57.2957795f;
+    // Epoch day of J2000.0, 2000-01-01 12:00 UTC.
+    static constexpr float J2000_DAY = 10957.5f;
+
+    struct DayTerms {
+        float sin_decl;
+        float cos_decl;
+        float eot_min;
+    };
+
+    void fillTable(int32_t day) {
+        table_[0] = dayTerms(day);
+        table_[1] = dayTerms(day + 1);
+        table_day_ = day;
+    }
+
+    // Terms at 00:00 UTC of the given day since the epoch. Mean longitude and
+    // anomaly are reduced before scaling so float keeps 0.001 deg.
+    static DayTerms dayTerms(int32_t day) {
+        const float n = (float)day - J2000_DAY;
+        const float l = wrap360(280.460f + (0.9856474f * n));
+        const float g = wrap360(357.528f + (0.9856003f * n)) * DEG_TO_RAD_F;
+        const float lambda = (l + (1.915f * sinf(g)) + (0.020f * sinf(2.0f * g))) * DEG_TO_RAD_F;
+        const float eps = (23.439f - (0.0000004f * n)) * DEG_TO_RAD_F;
+
+        DayTerms terms;
+        terms.sin_decl = sinf(eps) * sinf(lambda);
+        terms.cos_decl = sqrtf(1.0f - (terms.sin_decl * terms.sin_decl));
+        // Equation of time: mean longitude less right ascension.
+        const float ra = atan2f(cosf(eps) * sinf(lambda), cosf(lambda)) * RAD_TO_DEG_F;
+        float eot_deg = wrap360(l - ra);
+        if (eot_deg > 180.0f) {
+            eot_deg -= 360.0f;
+        }
+        terms.eot_min = 4.0f * eot_deg;
+        return terms;
+    }
+
+    static float wrap360(float deg) {
+        const float r = fmodf(deg, 360.0f);
+        return (r < 0.0f) ? (r + 360.0f) : r;
+    }
+
+    static float lerp(float a, float b, float t) { return a + ((b - a) * t); }
+
+    Config cfg_;
+    float sin_lat_ = 0.0f;
+    float cos_lat_ = 1.0f;
+    DayTerms table_[2] = {};
+    int32_t table_day_ = -1;
+};
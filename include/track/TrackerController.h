@@ -1,12 +1,35 @@
 #pragma once
 
-#include <Arduino.h>
+#include "util/Platform.h"
 
 #include "sensors/LightSensorPair.h"
 #include "drivers/MotorDriver.h"
+#include "track/BacklashEstimator.h"
+#include "track/HuntingDetector.h"
+#include "track/OffsetKalman.h"
+#include "track/TransientDetector.h"
+#include "util/ConfigRef.h"
+#include "util/FixedPoint.h"
 
-class TrackerController {
+// Types every BasicTrackerController shares, whatever its config.
+class TrackerControllerTypes {
 public:
+    // Tiered: fixed deadband raised by the low-light tiers.
+    // Statistical: deadband = max(diff_deadband, k * standard error of the
+    // window diff), from the per-read diff variance LightSensorPair measures.
+    enum class DeadbandMode {
+        Tiered,
+        Statistical
+    };
+
+    // BangBang: pwm_min below diff_pwm_threshold, pwm_max above it.
+    // Pid: PID on the diff outside the deadband, magnitude clamped to
+    // [pwm_min, pwm_max], gains scaled down in dim light.
+    enum class ControlMode {
+        BangBang,
+        Pid
+    };
+
     struct Config {
         float diff_deadband;
         float diff_pwm_threshold;
@@ -18,12 +41,90 @@ public:
         float low_light_deadband_2_percent;
         uint32_t low_light_level_3;
         float low_light_deadband_3_percent;
+        DeadbandMode deadband_mode;
+        float deadband_sigma_k;
+        ControlMode control_mode;
+        float pid_kp; // norm per percent
+        float pid_ki; // norm per percent*s
+        float pid_kd; // norm per percent/s
+        // Gain schedule on max(avg_a, avg_b): dark_gain_scale at or below the
+        // dark level, 1.0 at or above the bright level, linear in between.
+        uint32_t pid_schedule_dark_level;
+        uint32_t pid_schedule_bright_level;
+        float pid_dark_gain_scale;
+        // Feedforward: axis speed (deg/s) at pwm_min. With a rate set, windows
+        // inside the deadband become pwm_min pulses whose density tracks the
+        // expected sun motion (sigma-delta); the LDR diff only corrects.
+        // 0 disables it.
+        float ff_deg_per_s_at_min;
+        // Kalman: act on the filtered offset instead of the raw window diff,
+        // moving only when |offset| > deadband + sigma_k * sigma(offset).
+        // Measurement variance is var_diff / n, floored at r_min.
+        bool kalman_enabled;
+        OffsetKalman::Config kalman;
+        float kalman_r_min;
+        float kalman_sigma_k;
+        // Cloud/transient hold: no motion during an event, fresh window after.
+        TransientDetector::Config transient;
+        // Learns the MotorDriver backlash from reversal latency.
+        BacklashEstimator::Config backlash;
+        // Limit cycles widen the deadband; the boost decays back.
+        HuntingDetector::Config hunting;
+    };
+
+    // Parameters an auto-tune may replace at runtime.
+    struct Tuning {
+        float diff_deadband;
+        float diff_pwm_threshold;
+        float pid_kp;
+        float pid_ki;
+        float pid_kd;
     };
 
-    TrackerController(const Config& cfg, LightSensorPair& sensors, MotorDriver& motor)
-        : cfg_(cfg), sensors_(sensors), motor_(motor) {}
+};
+
+// One axis's controller: window diff in, motor target out. The config comes
+// from the constructor (TrackerController) or is a constexpr object named as
+// C, see ConfigRef; Sensors and Motor are the pair and driver it runs on.
+template <typename Sensors = LightSensorPair, typename Motor = MotorDriver,
+          const TrackerControllerTypes::Config* C = nullptr>
+class BasicTrackerController : public TrackerControllerTypes {
+public:
+    BasicTrackerController(const Config& cfg, Sensors& sensors, Motor& motor)
+        : cfg_(cfg),
+          tuning_{cfg.diff_deadband, cfg.diff_pwm_threshold, cfg.pid_kp, cfg.pid_ki, cfg.pid_kd},
+          sensors_(sensors),
+          motor_(motor),
+          kalman_(cfg.kalman),
+          transient_(cfg.transient),
+          backlash_(cfg.backlash, motor.backlashMs()),
+          hunting_(cfg.hunting) {
+        // Clamped / absolute copies of the config, once instead of per
+        // window, plus Q15 versions for the fixed-point build.
+        const float pwm_min = constrain(cfg.pwm_min_norm, 0.0f, 1.0f);
+        const float pwm_max = constrain(cfg.pwm_max_norm, 0.0f, 1.0f);
+        pwm_low_ = min(pwm_min, pwm_max);
+        pwm_high_ = max(pwm_min, pwm_max);
+        low_light_db_[0] = fabsf(cfg.low_light_deadband_1_percent);
+        low_light_db_[1] = fabsf(cfg.low_light_deadband_2_percent);
+        low_light_db_[2] = fabsf(cfg.low_light_deadband_3_percent);
+        sigma_k_ = fabsf(cfg.deadband_sigma_k);
+        kalman_sigma_k_ = fabsf(cfg.kalman_sigma_k);
+        dark_scale_ = constrain(cfg.pid_dark_gain_scale, 0.0f, 1.0f);
+        updateThresholds();
+        pwm_low_q15_ = Q15::fromFloat(pwm_low_);
+        pwm_high_q15_ = Q15::fromFloat(pwm_high_);
+        for (int i = 0; i < 3; i++) {
+            low_light_db_q15_[i] = Q15::fromPercent(low_light_db_[i]);
+        }
+        sigma_k_q8_ = (int32_t)lroundf(sigma_k_ * 256.0f);
+    }
+
+    void tick(unsigned long now_ms) {
+        if (cfg().kalman_enabled) {
+            trackMotion(now_ms);
+        }
 
-    void tick() {
         LightSensorPair::Sample sample;
         if (!sensors_.consumeSample(sample)) {
             return;
@@ -31,58 +132,458 @@ public:
 
         last_sample_ = sample;
         new_sample_ = true;
+        sample_count_++;
 
+        if (sample.window_complete) {
+            updateTransient(sample, now_ms);
+            if (backlash_.onWindow(sample.diff_percent, motor_.motorOnMs())) {
+                motor_.setBacklashMs(backlash_.estimateMs());
+            }
+        }
+        raw_diff_percent_ = sample.diff_percent;
+
+        if (cfg().kalman_enabled) {
+            filterSample(sample, now_ms);
+        }
+
+        if (cfg().control_mode == ControlMode::Pid) {
+            // Sliding windows overlap read to read: D would see a 3 ms dt
+            // and I would count every read a window's worth. The PID steps
+            // on completed windows only, which never share a read.
+            if (sample.window_complete) {
+                pidTick(sample, now_ms);
+            }
+            return;
+        }
+
+#if SATELLITE_FIXED_POINT
+        const int32_t diff = sample.diff_q15;
+        const int32_t db = effectiveDeadbandQ15(sample);
+        int32_t target_q15 = 0;
+        if (diff > db || diff < -db) {
+            const int32_t pwm_choice = (Q15::magnitude(diff) >= pwm_threshold_q15_)
+                ? pwm_high_q15_
+                : pwm_low_q15_;
+            target_q15 = (diff > 0) ? pwm_choice : -pwm_choice;
+        }
+        target_q15 += feedforwardStep(sample, now_ms, target_q15 == 0) * pwm_low_q15_;
+        if (holdForTransient(target_q15 != 0, now_ms)) {
+            target_q15 = 0;
+        }
+        if (override_active_) {
+            target_q15 = Q15::fromFloat(override_norm_);
+        }
+
+        last_target_q15_ = target_q15;
+        noteCommand(target_q15, now_ms);
+        motor_.setTargetQ15(target_q15);
+#else
         const float diff = sample.diff_percent;
         const float diff_abs = fabsf(diff);
         const float db = effectiveDeadband(sample);
-        const float pwm_threshold = fabsf(cfg_.diff_pwm_threshold);
         const bool move_pos = diff > db;
         const bool move_neg = diff < -db;
 
         float target_norm = 0.0f;
         if (move_pos || move_neg) {
-            const float pwm_min = constrain(cfg_.pwm_min_norm, 0.0f, 1.0f);
-            const float pwm_max = constrain(cfg_.pwm_max_norm, 0.0f, 1.0f);
-            const float pwm_low = min(pwm_min, pwm_max);
-            const float pwm_high = max(pwm_min, pwm_max);
             const float pwm_choice =
-                (diff_abs >= pwm_threshold) ? pwm_high : pwm_low;
+                (diff_abs >= pwm_threshold_) ? pwm_high_ : pwm_low_;
             target_norm = (move_pos ? pwm_choice : -pwm_choice);
         }
 
+        target_norm += (float)feedforwardStep(sample, now_ms, target_norm == 0.0f) * pwm_low_;
+        if (holdForTransient(target_norm != 0.0f, now_ms)) {
+            target_norm = 0.0f;
+        }
+        if (override_active_) {
+            target_norm = override_norm_;
+        }
+
         last_target_norm_ = target_norm;
+        noteCommand(Q15::fromFloat(target_norm), now_ms);
         motor_.setTargetNormalized(target_norm);
+#endif
     }
 
     bool hasNewSample() const { return new_sample_; }
+    // Samples consumed so far; tells a fresh diff from a repeated one.
+    uint32_t sampleCount() const { return sample_count_; }
     void clearNewSample() { new_sample_ = false; }
     LightSensorPair::Sample lastSample() const { return last_sample_; }
-    float lastTargetNorm() const { return last_target_norm_; }
-    float deadband() const { return fabsf(cfg_.diff_deadband); }
-    float lastEffectiveDeadband() const { return last_effective_deadband_; }
+    float lastTargetNorm() const {
+        return SATELLITE_FIXED_POINT ? Q15::toFloat(last_target_q15_) : last_target_norm_;
+    }
+    float deadband() const { return deadband_; }
+    float pwmThreshold() const { return pwm_threshold_; }
+    float pwmLowNorm() const { return pwm_low_; }
+    float pwmHighNorm() const { return pwm_high_; }
+    float pidIntegral() const { return pid_integral_; }
+
+    // Diff the controller acted on: the Kalman offset when enabled.
+    float lastControlDiffPercent() const {
+        return cfg().kalman_enabled ? kalman_.offset() : last_sample_.diff_percent;
+    }
+    const OffsetKalman& kalman() const { return kalman_; }
+
+    bool isTransientHold() const { return transient_.isActive(); }
+    uint32_t transientEvents() const { return transient_.events(); }
+    // Time the controller wanted to drive during transient holds.
+    uint32_t transientSavedMotorMs() const { return transient_saved_ms_; }
+
+    // Target another owner (vector mode, sweep, search, tuner) puts on the
+    // motor. While set it is the command hunting and backlash see and the
+    // one logged; the PID stays reset.
+    void setCommandOverride(bool active, float target_norm) {
+        override_active_ = active;
+        override_norm_ = target_norm;
+    }
+
+    // Expected axis rate from the ephemeris (deg/s, sign = motor direction).
+    void setFeedforwardRate(float deg_per_s) { ff_rate_deg_per_s_ = deg_per_s; }
+    float feedforwardLeadDeg() const { return ff_lead_deg_; }
+    uint32_t feedforwardPulses() const { return ff_pulses_; }
+
+    const BacklashEstimator& backlash() const { return backlash_; }
+    const HuntingDetector& hunting() const { return hunting_; }
+
+    void setTuning(const Tuning& tuning) {
+        tuning_ = tuning;
+        updateThresholds();
+        resetPid();
+    }
+
+    // Clears PID state, e.g. after the motor was held off for a while.
+    void resetPid() {
+        pid_integral_ = 0.0f;
+        pid_last_error_ = 0.0f;
+        pid_last_ms_ = 0;
+        pid_has_last_ = false;
+    }
+    float lastEffectiveDeadband() const {
+        return SATELLITE_FIXED_POINT ? Q15::toPercent(last_effective_deadband_q15_)
+                                     : last_effective_deadband_;
+    }
 
 private:
+    static const unsigned long PID_MAX_GAP_MS = 1000;
+    static const unsigned long FF_MAX_STEP_MS = 1000;
+    static const int FF_MAX_LEAD_STEPS = 10;
+
+    static const unsigned long KALMAN_MAX_GAP_MS = 5000;
+
+    const Config& cfg() const { return cfg_.get(); }
+
+    void updateThresholds() {
+        deadband_ = fabsf(tuning_.diff_deadband);
+        pwm_threshold_ = fabsf(tuning_.diff_pwm_threshold);
+        deadband_q15_ = Q15::fromPercent(deadband_);
+        pwm_threshold_q15_ = Q15::fromPercent(pwm_threshold_);
+    }
+
+    void updateTransient(const LightSensorPair::Sample& sample, unsigned long now_ms) {
+        transient_.update(sample, now_ms);
+        if (transient_.ended()) {
+            // Windows straddling the event are mixed; start clean.
+            sensors_.restartWindow();
+            kalman_.reset();
+            resetPid();
+        }
+    }
+
+    bool holdForTransient(bool would_move, unsigned long now_ms) {
+        const unsigned long dt_ms = (hold_last_ms_ == 0) ? 0 : (now_ms - hold_last_ms_);
+        hold_last_ms_ = now_ms;
+        if (!transient_.isActive()) {
+            return false;
+        }
+        if (would_move && motor_.isEnabled()) {
+            transient_saved_ms_ += dt_ms;
+        }
+        return true;
+    }
+
+    void noteCommand(int32_t target_q15, unsigned long now_ms) {
+        const int sign = (target_q15 > 0) - (target_q15 < 0);
+        backlash_.onCommand(sign, motor_.motorOnMs(), raw_diff_percent_);
+        hunting_.update(target_q15, motor_.motorOnMs(), now_ms);
+        hunting_boost_q15_ = hunting_.boostQ15();
+    }
+
+    void trackMotion(unsigned long now_ms) {
+        // Crossing the gear slack does not move the axis.
+        if (motion_last_ms_ != 0 && !motor_.isTakingUpBacklash()) {
+            kalman_.addMotion(motor_.getAppliedNorm(),
+                              (float)(now_ms - motion_last_ms_) / 1000.0f);
+        }
+        motion_last_ms_ = now_ms;
+    }
+
+    // Replaces the sample diff by the filtered offset; the deadband margin
+    // follows the estimate's uncertainty.
+    void filterSample(LightSensorPair::Sample& sample, unsigned long now_ms) {
+        if (kalman_last_ms_ != 0 && (now_ms - kalman_last_ms_) > KALMAN_MAX_GAP_MS) {
+            kalman_.reset();
+        }
+        if (kalman_last_ms_ != 0) {
+            kalman_.predict((float)(now_ms - kalman_last_ms_) / 1000.0f);
+        }
+        kalman_last_ms_ = now_ms;
+
+        // Sliding windows share all but one read: measuring every emission
+        // would count each read window_size times and shrink sigma by
+        // sqrt(window_size). Completed windows never overlap; partial ones
+        // act on the prediction.
+        if (sample.window_complete) {
+            const float r = (sample.sample_count > 1)
+                ? max(sample.var_diff / (float)sample.sample_count, cfg().kalman_r_min)
+                : max(cfg().kalman_r_min, 100.0f);
+            kalman_.update(sample.diff_percent, r);
+        } else if (!kalman_.isInitialized()) {
+            return;
+        }
+
+        sample.diff_percent = constrain(kalman_.offset(), -100.0f, 100.0f);
+        sample.diff_q15 = Q15::fromPercent(sample.diff_percent);
+        kalman_margin_ = kalman_sigma_k_ * kalman_.offsetSigma();
+        kalman_margin_q15_ = Q15::fromPercent(min(kalman_margin_, 100.0f));
+    }
+
+    // Sigma-delta: integrate the expected motion, spend one window at pwm_min
+    // once half a window's worth of travel is owed. Returns -1, 0 or +1.
+    // An LDR correction (not idle) resets the accumulated lead.
+    int feedforwardPulse(unsigned long now_ms, bool idle) {
+        const unsigned long dt_ms = (ff_last_ms_ == 0) ? 0 : (now_ms - ff_last_ms_);
+        ff_last_ms_ = now_ms;
+        if (cfg().ff_deg_per_s_at_min <= 0.0f || ff_rate_deg_per_s_ == 0.0f) {
+            ff_lead_deg_ = 0.0f;
+            return 0;
+        }
+        if (!idle) {
+            ff_lead_deg_ = 0.0f;
+            return 0;
+        }
+
+        const float dt_s = (float)((dt_ms < FF_MAX_STEP_MS) ? dt_ms : FF_MAX_STEP_MS) / 1000.0f;
+        const float step_deg = cfg().ff_deg_per_s_at_min * dt_s;
+        const float max_lead = step_deg * (float)FF_MAX_LEAD_STEPS;
+        ff_lead_deg_ = constrain(ff_lead_deg_ + (ff_rate_deg_per_s_ * dt_s), -max_lead, max_lead);
+        if (step_deg <= 0.0f || fabsf(ff_lead_deg_) < (0.5f * step_deg)) {
+            return 0;
+        }
+        const int sign = (ff_lead_deg_ > 0.0f) ? 1 : -1;
+        ff_lead_deg_ -= (float)sign * step_deg;
+        ff_pulses_++;
+        return sign;
+    }
+
+    // The sigma-delta steps once per completed window, so a pulse lasts a
+    // whole window; partial Sliding samples repeat it while still idle.
+    int feedforwardStep(const LightSensorPair::Sample& sample, unsigned long now_ms, bool idle) {
+        if (sample.window_complete) {
+            ff_pulse_ = feedforwardPulse(now_ms, idle);
+        } else if (!idle) {
+            ff_lead_deg_ = 0.0f;
+            ff_pulse_ = 0;
+        }
+        return ff_pulse_;
+    }
+
+    // Float in both builds: PID gains do not map well onto Q15 and the loop
+    // only runs once per window.
+    void pidTick(const LightSensorPair::Sample& sample, unsigned long now_ms) {
+        // Held off (blocked, sleep) or windows missing: start over instead of
+        // integrating an error the motor could not act on.
+        // Likewise while another owner drives the axis.
+        if (!motor_.isEnabled() || override_active_ ||
+            (pid_has_last_ && (now_ms - pid_last_ms_) > PID_MAX_GAP_MS)) {
+            resetPid();
+        }
+
+        const float error = sample.diff_percent;
+        const float db = effectiveDeadband(sample);
+        const float dt_s = pid_has_last_ ? (float)(now_ms - pid_last_ms_) / 1000.0f : 0.0f;
+        const float derivative =
+            (pid_has_last_ && dt_s > 0.0f) ? (error - pid_last_error_) / dt_s : 0.0f;
+        pid_last_error_ = error;
+        pid_last_ms_ = now_ms;
+        pid_has_last_ = true;
+
+        float target_norm = 0.0f;
+        if (fabsf(error) > db) {
+            // Past the target: stale integral would only push the overshoot.
+            if ((error > 0.0f) != (pid_integral_ > 0.0f)) {
+                pid_integral_ = 0.0f;
+            }
+
+            const float scale = gainScale(max(sample.avg_a, sample.avg_b));
+            const float kp = tuning_.pid_kp * scale;
+            const float ki = tuning_.pid_ki * scale;
+            const float kd = tuning_.pid_kd * scale;
+
+            const float integral = pid_integral_ + (error * dt_s);
+            const float u = (kp * error) + (ki * integral) + (kd * derivative);
+            // Anti-windup: integrate only near the target (inside the
+            // diff_pwm_threshold band) and never while the output is pinned
+            // at max in the direction the integral would grow.
+            const bool saturated = fabsf(u) > pwm_high_ && (u > 0.0f) == (error > 0.0f);
+            // Nor while the gear slack is taken up: the error cannot respond yet.
+            if (!saturated && !motor_.isTakingUpBacklash() &&
+                fabsf(error) < pwm_threshold_) {
+                pid_integral_ = integral;
+            }
+
+            const float mag = constrain(fabsf(u), pwm_low_, pwm_high_);
+            target_norm = (error > 0.0f) ? mag : -mag;
+        }
+        target_norm += (float)feedforwardStep(sample, now_ms, target_norm == 0.0f) * pwm_low_;
+        if (holdForTransient(target_norm != 0.0f, now_ms)) {
+            target_norm = 0.0f;
+        }
+        if (override_active_) {
+            target_norm = override_norm_;
+        }
+
+        last_target_norm_ = target_norm;
+        last_target_q15_ = Q15::fromFloat(target_norm);
+        last_effective_deadband_q15_ = Q15::fromPercent(db);
+        noteCommand(last_target_q15_, now_ms);
+        motor_.setTargetNormalized(target_norm);
+    }
+
+    float gainScale(uint32_t signal) const {
+        if (signal <= cfg().pid_schedule_dark_level) {
+            return dark_scale_;
+        }
+        if (signal >= cfg().pid_schedule_bright_level) {
+            return 1.0f;
+        }
+        const float t = (float)(signal - cfg().pid_schedule_dark_level) /
+                        (float)(cfg().pid_schedule_bright_level - cfg().pid_schedule_dark_level);
+        return dark_scale_ + ((1.0f - dark_scale_) * t);
+    }
+
     float effectiveDeadband(const LightSensorPair::Sample& sample) {
-        float db = fabsf(cfg_.diff_deadband);
+        float db = (cfg().deadband_mode == DeadbandMode::Statistical)
+            ? statisticalDeadband(sample)
+            : tieredDeadband(sample);
+        db = min(db + kalman_margin_ + hunting_.boostPercent(), 100.0f);
+        last_effective_deadband_ = db;
+        return db;
+    }
+
+    float tieredDeadband(const LightSensorPair::Sample& sample) const {
+        float db = deadband_;
         const uint32_t max_signal = max(sample.avg_a, sample.avg_b);
 
-        if (cfg_.low_light_level_3 > 0 && max_signal < cfg_.low_light_level_3) {
-            db = max(db, fabsf(cfg_.low_light_deadband_3_percent));
-        } else if (cfg_.low_light_level_2 > 0 && max_signal < cfg_.low_light_level_2) {
-            db = max(db, fabsf(cfg_.low_light_deadband_2_percent));
-        } else if (cfg_.low_light_level_1 > 0 && max_signal < cfg_.low_light_level_1) {
-            db = max(db, fabsf(cfg_.low_light_deadband_1_percent));
+        if (cfg().low_light_level_3 > 0 && max_signal < cfg().low_light_level_3) {
+            db = max(db, low_light_db_[2]);
+        } else if (cfg().low_light_level_2 > 0 && max_signal < cfg().low_light_level_2) {
+            db = max(db, low_light_db_[1]);
+        } else if (cfg().low_light_level_1 > 0 && max_signal < cfg().low_light_level_1) {
+            db = max(db, low_light_db_[0]);
         }
 
-        last_effective_deadband_ = db;
+        // Partial sliding windows average fewer reads; widen the deadband by the
+        // standard-error ratio so they can act early without chasing noise.
+        if (sample.confidence > 0.0f && sample.confidence < 1.0f) {
+            db = min(db / sqrtf(sample.confidence), 100.0f);
+        }
         return db;
     }
 
-    Config cfg_;
-    LightSensorPair& sensors_;
-    MotorDriver& motor_;
+    float statisticalDeadband(const LightSensorPair::Sample& sample) const {
+        if (sample.sample_count < 2) {
+            return 100.0f;
+        }
+        const float std_err = sqrtf(sample.var_diff / (float)sample.sample_count);
+        return constrain(max(deadband_, sigma_k_ * std_err), 0.0f, 100.0f);
+    }
+
+    int32_t effectiveDeadbandQ15(const LightSensorPair::Sample& sample) {
+        int32_t db = deadband_q15_;
+        if (cfg().deadband_mode == DeadbandMode::Statistical) {
+            if (sample.sample_count < 2) {
+                db = Q15::MAX;
+            } else {
+                const uint32_t std_err = Q15::isqrt(sample.var_diff_q30 / sample.sample_count);
+                const int64_t k_err = ((int64_t)sigma_k_q8_ * std_err) >> 8;
+                db = (int32_t)min((int64_t)Q15::MAX, max((int64_t)db, k_err));
+            }
+            db = min(Q15::MAX, db + kalman_margin_q15_ + hunting_boost_q15_);
+            last_effective_deadband_q15_ = db;
+            return db;
+        }
+
+        const uint32_t max_signal = max(sample.avg_a, sample.avg_b);
+        if (cfg().low_light_level_3 > 0 && max_signal < cfg().low_light_level_3) {
+            db = max(db, low_light_db_q15_[2]);
+        } else if (cfg().low_light_level_2 > 0 && max_signal < cfg().low_light_level_2) {
+            db = max(db, low_light_db_q15_[1]);
+        } else if (cfg().low_light_level_1 > 0 && max_signal < cfg().low_light_level_1) {
+            db = max(db, low_light_db_q15_[0]);
+        }
+
+        // db / sqrt(confidence) == db * sqrt(window / count), sqrt in Q8.
+        if (sample.sample_count > 0 && sample.sample_count < sample.window_size) {
+            const uint32_t scale_q8 = Q15::isqrt(
+                ((uint64_t)sample.window_size << 16) / sample.sample_count);
+            db = (int32_t)min((int64_t)Q15::MAX, ((int64_t)db * scale_q8) >> 8);
+        }
+
+        db = min(Q15::MAX, db + kalman_margin_q15_ + hunting_boost_q15_);
+        last_effective_deadband_q15_ = db;
+        return db;
+    }
+
+    ConfigRef<Config, C> cfg_;
+    // Out of the config: setTuning() replaces it at run time.
+    Tuning tuning_;
+    Sensors& sensors_;
+    Motor& motor_;
     LightSensorPair::Sample last_sample_;
     bool new_sample_ = false;
+    uint32_t sample_count_ = 0;
     float last_target_norm_ = 0.0f;
     float last_effective_deadband_ = 0.0f;
+    float deadband_ = 0.0f;
+    float pwm_threshold_ = 0.0f;
+    float pwm_low_ = 0.0f;
+    float pwm_high_ = 0.0f;
+    float low_light_db_[3] = {0.0f, 0.0f, 0.0f};
+    float sigma_k_ = 0.0f;
+    float kalman_sigma_k_ = 0.0f;
+    float dark_scale_ = 0.0f;
+    int32_t deadband_q15_ = 0;
+    int32_t pwm_threshold_q15_ = 0;
+    int32_t pwm_low_q15_ = 0;
+    int32_t pwm_high_q15_ = 0;
+    int32_t low_light_db_q15_[3] = {0, 0, 0};
+    int32_t sigma_k_q8_ = 0;
+    int32_t last_target_q15_ = 0;
+    int32_t last_effective_deadband_q15_ = 0;
+    float pid_integral_ = 0.0f;
+    float pid_last_error_ = 0.0f;
+    unsigned long pid_last_ms_ = 0;
+    bool pid_has_last_ = false;
+    float ff_rate_deg_per_s_ = 0.0f;
+    float ff_lead_deg_ = 0.0f;
+    unsigned long ff_last_ms_ = 0;
+    uint32_t ff_pulses_ = 0;
+    int ff_pulse_ = 0;
+    OffsetKalman kalman_;
+    unsigned long motion_last_ms_ = 0;
+    unsigned long kalman_last_ms_ = 0;
+    float kalman_margin_ = 0.0f;
+    int32_t kalman_margin_q15_ = 0;
+    TransientDetector transient_;
+    unsigned long hold_last_ms_ = 0;
+    uint32_t transient_saved_ms_ = 0;
+    BacklashEstimator backlash_;
+    float raw_diff_percent_ = 0.0f;
+    HuntingDetector hunting_;
+    int32_t hunting_boost_q15_ = 0;
+    bool override_active_ = false;
+    float override_norm_ = 0.0f;
 };
+
+typedef BasicTrackerController<> TrackerController;
@@ -1,110 +1,140 @@
 #pragma once
 
-#include <Arduino.h>
+#include "util/Platform.h"
 
+#include "track/TrackingGroup.h"
 #include "track/TrackingUnit.h"
 
+// H/V front end over TrackingGroup<2>: the group runs the auto-block, this
+// adds vector drive.
 class TrackingCoordinator {
 public:
+    // Independent: each TrackingUnit drives its own axis.
+    // Vector: (diff_h, diff_v) is one error with a radial deadband (the
+    // larger of the two effective deadbands). The major axis drives at its
+    // pwm_min/pwm_max choice; the minor axis drives at the same choice for
+    // |minor| / |major| of every vector_period_ms, so both arrive together
+    // even though PWM below pwm_min would not move the motors.
+    enum class Mode {
+        Independent,
+        Vector
+    };
+
+    // Block timing as TrackingGroup::Config.
     struct Config {
         unsigned long deadband_hold_ms;
         unsigned long block_duration_ms;
+        Mode mode;
+        unsigned long vector_period_ms;
+        bool predictive_block;
+        float block_margin;
+        float block_drift_sigma;
+        unsigned long block_min_ms;
+        unsigned long block_max_ms;
     };
 
     TrackingCoordinator(const Config& cfg, TrackingUnit& unit_h, TrackingUnit& unit_v)
-        : cfg_(cfg), unit_h_(unit_h), unit_v_(unit_v) {}
+        : cfg_(cfg),
+          units_{&unit_h, &unit_v},
+          group_(groupConfig(cfg), units_) {}
 
     void setEnabled(bool enabled) {
-        if (enabled_ == enabled) {
+        if (group_.isEnabled() == enabled) {
             return;
         }
-        enabled_ = enabled;
-        resetState();
+        group_.setEnabled(enabled);
+        // The minor axis restarts every vector period without having come
+        // to rest: no kick for it.
+        const unsigned long holdoff = ownsTargets() ? cfg_.vector_period_ms : 0;
+        unitH().setKickHoldoffMs(holdoff);
+        unitV().setKickHoldoffMs(holdoff);
+        if (!enabled && cfg_.mode == Mode::Vector) {
+            unitH().clearTargetOverride();
+            unitV().clearTargetOverride();
+        }
     }
 
-    void resetState() {
-        deadband_enter_ms_ = 0;
-        block_until_ms_ = 0;
-        blocked_ = false;
-        in_deadband_ = false;
-        has_both_diffs_ = false;
-    }
+    // Vector mode sets both axis targets; other target overrides go on top.
+    bool ownsTargets() const { return group_.isEnabled() && cfg_.mode == Mode::Vector; }
+
+    void resetState() { group_.resetState(); }
 
     void tick(unsigned long now_ms) {
-        if (!enabled_) {
+        if (!group_.isEnabled()) {
             return;
         }
-
-        has_both_diffs_ = unit_h_.hasDiffSample() && unit_v_.hasDiffSample();
-        if (!has_both_diffs_) {
-            blocked_ = false;
-            in_deadband_ = false;
-            deadband_enter_ms_ = 0;
-            block_until_ms_ = 0;
-            applyMotorState(true);
-            return;
+        group_.tick(now_ms);
+        if (cfg_.mode == Mode::Vector) {
+            driveVector(now_ms, group_.hasAllDiffs() && !group_.isBlocked(0) &&
+                                    !group_.isGroupInDeadband());
         }
+    }
 
-        const float diff_h_abs = fabsf(unit_h_.lastDiffPercent());
-        const float diff_v_abs = fabsf(unit_v_.lastDiffPercent());
-        const float db_h = fabsf(unit_h_.lastEffectiveDeadband());
-        const float db_v = fabsf(unit_v_.lastEffectiveDeadband());
-        in_deadband_ = (diff_h_abs <= db_h) && (diff_v_abs <= db_v);
-
-        const bool is_blocked_window = now_ms < block_until_ms_;
-        if (is_blocked_window) {
-            blocked_ = true;
-            applyMotorState(false);
-            return;
-        }
+    bool isBlocked() const { return group_.isBlocked(0); }
+    bool isInDeadband() const { return group_.isGroupInDeadband(); }
+    bool hasBothDiffs() const { return group_.hasAllDiffs(); }
+    unsigned long lastBlockMs() const { return group_.lastBlockMs(); }
+    uint32_t blocks() const { return group_.blocks(); }
+    uint32_t predictedBlocks() const { return group_.predictedBlocks(); }
+    // Fitted diff drift while holding still, percent per second.
+    float driftHPercentPerS() const { return group_.driftPercentPerS(0); }
+    float driftVPercentPerS() const { return group_.driftPercentPerS(1); }
 
-        if (block_until_ms_ > 0 && in_deadband_) {
-            block_until_ms_ = now_ms + cfg_.block_duration_ms;
-            blocked_ = true;
-            applyMotorState(false);
-            return;
-        }
-
-        if (!in_deadband_) {
-            deadband_enter_ms_ = 0;
-            block_until_ms_ = 0;
-            blocked_ = false;
-            applyMotorState(true);
-            return;
-        }
+private:
+    static TrackingGroup<2>::Config groupConfig(const Config& cfg) {
+        return {(cfg.mode == Mode::Vector) ? TrackingGroup<2>::Policy::Radial
+                                           : TrackingGroup<2>::Policy::AllInDeadband,
+                cfg.deadband_hold_ms,
+                cfg.block_duration_ms,
+                cfg.predictive_block,
+                cfg.block_margin,
+                cfg.block_drift_sigma,
+                cfg.block_min_ms,
+                cfg.block_max_ms,
+                0};
+    }
 
-        if (deadband_enter_ms_ == 0) {
-            deadband_enter_ms_ = now_ms;
+    TrackingUnit& unitH() const { return *units_[0]; }
+    TrackingUnit& unitV() const { return *units_[1]; }
+
+    void driveVector(unsigned long now_ms, bool move) {
+        TrackingUnit& unit_h = unitH();
+        TrackingUnit& unit_v = unitV();
+        float target_h = 0.0f;
+        float target_v = 0.0f;
+        if (move && !unit_h.isTransientHold() && !unit_v.isTransientHold()) {
+            const float diff_h = unit_h.lastDiffPercent();
+            const float diff_v = unit_v.lastDiffPercent();
+            const float abs_h = fabsf(diff_h);
+            const float abs_v = fabsf(diff_v);
+            const bool h_major = abs_h >= abs_v;
+            const float major_abs = h_major ? abs_h : abs_v;
+            const float ratio = (major_abs > 0.0f) ? ((h_major ? abs_v : abs_h) / major_abs) : 0.0f;
+            const float radius = sqrtf((abs_h * abs_h) + (abs_v * abs_v));
+            const bool high = radius >= (h_major ? unit_h : unit_v).pwmThreshold();
+            // A minor axis inside its own deadband stays put: at that size its
+            // sign is mostly window noise.
+            const float minor_db = fabsf((h_major ? unit_v : unit_h).lastEffectiveDeadband());
+            const bool minor_on = ((h_major ? abs_v : abs_h) > minor_db) &&
+                ((cfg_.vector_period_ms == 0) ||
+                 ((float)(now_ms % cfg_.vector_period_ms) < (ratio * (float)cfg_.vector_period_ms)));
+
+            if (h_major || minor_on) {
+                target_h = signedNorm(diff_h, high ? unit_h.pwmHighNorm() : unit_h.pwmLowNorm());
+            }
+            if (!h_major || minor_on) {
+                target_v = signedNorm(diff_v, high ? unit_v.pwmHighNorm() : unit_v.pwmLowNorm());
+            }
         }
-        if ((now_ms - deadband_enter_ms_) >= cfg_.deadband_hold_ms) {
-            block_until_ms_ = now_ms + cfg_.block_duration_ms;
-            deadband_enter_ms_ = 0;
-            blocked_ = true;
-            applyMotorState(false);
-            return;
-        }
-
-        blocked_ = false;
-        applyMotorState(true);
+        unit_h.setTargetOverride(target_h);
+        unit_v.setTargetOverride(target_v);
     }
 
-    bool isBlocked() const { return blocked_; }
-    bool isInDeadband() const { return in_deadband_; }
-    bool hasBothDiffs() const { return has_both_diffs_; }
-
-private:
-    void applyMotorState(bool enabled) {
-        unit_h_.setMotorOverride(enabled);
-        unit_v_.setMotorOverride(enabled);
+    static float signedNorm(float diff, float mag) {
+        return (diff > 0.0f) ? mag : (diff < 0.0f) ? -mag : 0.0f;
     }
 
     Config cfg_;
-    TrackingUnit& unit_h_;
-    TrackingUnit& unit_v_;
-    bool enabled_ = false;
-    bool blocked_ = false;
-    bool in_deadband_ = false;
-    bool has_both_diffs_ = false;
-    unsigned long deadband_enter_ms_ = 0;
-    unsigned long block_until_ms_ = 0;
+    TrackingUnit* const units_[2];
+    TrackingGroup<2> group_;
 };
@@ -0,0 +1,302 @@
+#pragma once
+
+#include "util/Platform.h"
+#include <stddef.h>
+
+#include "track/DriftFit.h"
+#include "track/TrackingUnit.h"
+
+// Auto-block for N axes on one controller (a row of panels, or the H/V pair
+// behind TrackingCoordinator). Per-axis state is kept in parallel arrays;
+// tick() copies each unit's diff and deadband once and then works on those.
+//
+// AllInDeadband: every axis in its deadband for deadband_hold_ms blocks the
+// whole group.
+// Radial: as AllInDeadband, but the axes form one error vector whose length
+// is held to the largest effective deadband.
+// Staggered: each axis blocks on its own hold; block ends are spread at least
+// stagger_ms apart so the motors do not all start on the same tick.
+//
+// Predictive: the block lasts until the fitted diff drift would carry an
+// axis out of its deadband (times block_margin), clamped to
+// [block_min_ms, block_max_ms]; block_duration_ms until a fit exists. The
+// drift is taken block_drift_sigma standard errors toward each edge, so a
+// short, noisy fit gives a short block. The fit spans the hold and the blocks
+// that follow it; any move restarts it.
+template <size_t N>
+class TrackingGroup {
+public:
+    static_assert(N > 0, "TrackingGroup needs at least one axis");
+
+    enum class Policy {
+        AllInDeadband,
+        Radial,
+        Staggered
+    };
+
+    struct Config {
+        Policy policy;
+        unsigned long deadband_hold_ms;
+        unsigned long block_duration_ms;
+        bool predictive_block;
+        float block_margin;
+        float block_drift_sigma;
+        unsigned long block_min_ms;
+        unsigned long block_max_ms;
+        unsigned long stagger_ms;
+    };
+
+    TrackingGroup(const Config& cfg, TrackingUnit* const (&units)[N])
+        : cfg_(cfg) {
+        for (size_t i = 0; i < N; i++) {
+            units_[i] = units[i];
+        }
+        resetState();
+    }
+
+    void setEnabled(bool enabled) {
+        if (enabled_ == enabled) {
+            return;
+        }
+        enabled_ = enabled;
+        resetState();
+    }
+
+    bool isEnabled() const { return enabled_; }
+
+    void resetState() {
+        for (size_t i = 0; i < N; i++) {
+            diff_[i] = 0.0f;
+            db_[i] = 0.0f;
+            deadband_enter_ms_[i] = 0;
+            block_until_ms_[i] = 0;
+            in_deadband_[i] = false;
+            blocked_[i] = false;
+            drift_[i].reset();
+        }
+        group_enter_ms_ = 0;
+        group_block_until_ms_ = 0;
+        group_in_deadband_ = false;
+        has_all_diffs_ = false;
+    }
+
+    void tick(unsigned long now_ms) {
+        if (!enabled_) {
+            return;
+        }
+
+        bool has_all = true;
+        bool all_in = true;
+        float radius_sq = 0.0f;
+        float max_db = 0.0f;
+        for (size_t i = 0; i < N; i++) {
+            const TrackingUnit& unit = *units_[i];
+            const bool has_diff = unit.hasDiffSample();
+            diff_[i] = has_diff ? unit.lastDiffPercent() : 0.0f;
+            db_[i] = fabsf(unit.lastEffectiveDeadband());
+            in_deadband_[i] = has_diff && fabsf(diff_[i]) <= db_[i];
+            has_all = has_all && has_diff;
+            all_in = all_in && in_deadband_[i];
+            radius_sq += diff_[i] * diff_[i];
+            max_db = max(max_db, db_[i]);
+        }
+        has_all_diffs_ = has_all;
+        if (cfg_.policy == Policy::Radial) {
+            group_in_deadband_ = has_all && radius_sq <= (max_db * max_db);
+        } else {
+            group_in_deadband_ = all_in;
+        }
+
+        for (size_t i = 0; i < N; i++) {
+            const bool hold = (cfg_.policy == Policy::Staggered) ? in_deadband_[i]
+                                                                 : group_in_deadband_;
+            if (hold) {
+                drift_[i].add(units_[i]->diffSamples(), diff_[i], now_ms);
+            } else {
+                drift_[i].reset();
+            }
+        }
+
+        if (cfg_.policy == Policy::Staggered) {
+            tickStaggered(now_ms);
+        } else {
+            tickAll(now_ms);
+        }
+
+        for (size_t i = 0; i < N; i++) {
+            units_[i]->setMotorOverride(!blocked_[i]);
+        }
+    }
+
+    static size_t size() { return N; }
+    TrackingUnit& unit(size_t i) const { return *units_[i]; }
+    bool isBlocked(size_t i) const { return blocked_[i]; }
+    bool isInDeadband(size_t i) const { return in_deadband_[i]; }
+    // Group deadband (all axes, or the radial one).
+    bool isGroupInDeadband() const { return group_in_deadband_; }
+    bool hasAllDiffs() const { return has_all_diffs_; }
+    // Fitted diff drift while holding still, percent per second.
+    float driftPercentPerS(size_t i) const { return drift_[i].slope(); }
+    unsigned long lastBlockMs() const { return last_block_ms_; }
+    uint32_t blocks() const { return blocks_; }
+    uint32_t predictedBlocks() const { return predicted_blocks_; }
+
+    size_t blockedCount() const {
+        size_t count = 0;
+        for (size_t i = 0; i < N; i++) {
+            count += blocked_[i] ? 1 : 0;
+        }
+        return count;
+    }
+
+private:
+    void tickAll(unsigned long now_ms) {
+        bool blocked = false;
+        if (now_ms < group_block_until_ms_) {
+            blocked = true;
+        } else if (!group_in_deadband_) {
+            group_enter_ms_ = 0;
+            group_block_until_ms_ = 0;
+        } else if (group_block_until_ms_ > 0) {
+            group_block_until_ms_ = now_ms + blockDurationMs(0, N);
+            blocked = true;
+        } else {
+            if (group_enter_ms_ == 0) {
+                group_enter_ms_ = now_ms;
+            }
+            if ((now_ms - group_enter_ms_) >= cfg_.deadband_hold_ms) {
+                group_block_until_ms_ = now_ms + blockDurationMs(0, N);
+                group_enter_ms_ = 0;
+                blocked = true;
+            }
+        }
+        for (size_t i = 0; i < N; i++) {
+            blocked_[i] = blocked;
+        }
+    }
+
+    void tickStaggered(unsigned long now_ms) {
+        for (size_t i = 0; i < N; i++) {
+            if (now_ms < block_until_ms_[i]) {
+                blocked_[i] = true;
+                continue;
+            }
+            blocked_[i] = false;
+            if (!in_deadband_[i]) {
+                deadband_enter_ms_[i] = 0;
+                block_until_ms_[i] = 0;
+                continue;
+            }
+            if (block_until_ms_[i] == 0) {
+                if (deadband_enter_ms_[i] == 0) {
+                    deadband_enter_ms_[i] = now_ms;
+                }
+                if ((now_ms - deadband_enter_ms_[i]) < cfg_.deadband_hold_ms) {
+                    continue;
+                }
+                deadband_enter_ms_[i] = 0;
+            }
+            block_until_ms_[i] = staggeredEnd(i, now_ms, now_ms + blockDurationMs(i, i + 1));
+            blocked_[i] = true;
+        }
+    }
+
+    // Pushes a block end until it is stagger_ms clear of every other
+    // axis' pending unblock.
+    unsigned long staggeredEnd(size_t self, unsigned long now_ms, unsigned long end_ms) const {
+        if (cfg_.stagger_ms == 0) {
+            return end_ms;
+        }
+        bool moved = true;
+        for (size_t pass = 0; moved && pass < N; pass++) {
+            moved = false;
+            for (size_t i = 0; i < N; i++) {
+                const unsigned long other = block_until_ms_[i];
+                if (i == self || other <= now_ms) {
+                    continue;
+                }
+                const unsigned long gap = (end_ms > other) ? (end_ms - other) : (other - end_ms);
+                if (gap < cfg_.stagger_ms) {
+                    end_ms = other + cfg_.stagger_ms;
+                    moved = true;
+                }
+            }
+        }
+        return end_ms;
+    }
+
+    // Block length for axes [first, last): the earliest predicted exit.
+    unsigned long blockDurationMs(size_t first, size_t last) {
+        unsigned long ms = cfg_.block_duration_ms;
+        const float min_span_s = (float)cfg_.deadband_hold_ms / 2000.0f;
+        bool valid = cfg_.predictive_block;
+        for (size_t i = first; valid && i < last; i++) {
+            valid = drift_[i].valid(min_span_s);
+        }
+        if (valid) {
+            const float exit_s = (cfg_.policy == Policy::Radial) ? radialExitS()
+                                                                 : axisExitS(first, last);
+            const float max_s = (float)cfg_.block_max_ms / 1000.0f;
+            const float block_s = (exit_s < 0.0f) ? max_s : min(exit_s * cfg_.block_margin, max_s);
+            ms = max((unsigned long)(block_s * 1000.0f), cfg_.block_min_ms);
+            predicted_blocks_++;
+        }
+        last_block_ms_ = ms;
+        blocks_++;
+        return ms;
+    }
+
+    float axisExitS(size_t first, size_t last) const {
+        const float k = fabsf(cfg_.block_drift_sigma);
+        float exit_s = -1.0f;
+        for (size_t i = first; i < last; i++) {
+            exit_s = DriftFit::earliest(exit_s, drift_[i].secondsToExit(db_[i], k));
+        }
+        return exit_s;
+    }
+
+    // |d + r t| = db on the radial deadband, with each rate pushed outward
+    // by its uncertainty; -1 if the drift never gets there.
+    float radialExitS() const {
+        const float k = fabsf(cfg_.block_drift_sigma);
+        float a = 0.0f;
+        float b = 0.0f;
+        float c = 0.0f;
+        float db = 0.0f;
+        for (size_t i = 0; i < N; i++) {
+            const float d = drift_[i].value();
+            const float r = drift_[i].slope() +
+                            ((d >= 0.0f) ? 1.0f : -1.0f) * k * drift_[i].slopeStdErr();
+            a += r * r;
+            b += 2.0f * d * r;
+            c += d * d;
+            db = max(db, db_[i]);
+        }
+        c -= db * db;
+        if (a <= 0.0f) {
+            return -1.0f;
+        }
+        if (c >= 0.0f) {
+            return 0.0f;
+        }
+        return (-b + sqrtf((b * b) - (4.0f * a * c))) / (2.0f * a);
+    }
+
+    Config cfg_;
+    TrackingUnit* units_[N];
+    float diff_[N];
+    float db_[N];
+    bool in_deadband_[N];
+    bool blocked_[N];
+    unsigned long deadband_enter_ms_[N];
+    unsigned long block_until_ms_[N];
+    DriftFit drift_[N];
+    bool enabled_ = false;
+    bool group_in_deadband_ = false;
+    bool has_all_diffs_ = false;
+    unsigned long group_enter_ms_ = 0;
+    unsigned long group_block_until_ms_ = 0;
+    unsigned long last_block_ms_ = 0;
+    uint32_t blocks_ = 0;
+    uint32_t predicted_blocks_ = 0;
+};
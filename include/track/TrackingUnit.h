@@ -1,49 +1,73 @@
 #pragma once
 
-#include <Arduino.h>
+#include "util/Platform.h"
 
 #include "sensors/LightSensorPair.h"
 #include "drivers/MotorDriver.h"
 #include "track/TrackerController.h"
 
+// One tracking axis as the coordinator, group and main see it. Overrides and
+// tick bookkeeping live here; the axis itself is behind the virtual calls.
+// BasicTrackingUnit runs a sensor pair, controller and motor; IdleTrackingUnit
+// stands in for an axis the build leaves out.
 class TrackingUnit {
 public:
     struct LogSample {
         uint32_t avg_a = 0;
         uint32_t avg_b = 0;
+        float level_a = 0.0f;
+        float level_b_uncal = 0.0f;
         float diff_percent = 0.0f;
+        float var_diff = 0.0f;
         float target_norm = 0.0f;
         float applied_norm = 0.0f;
         uint32_t applied_raw = 0;
     };
 
-    TrackingUnit(const LightSensorPair::Config& s_cfg,
-                 const TrackerController::Config& t_cfg,
-                 const MotorDriver::Config& m_cfg)
-        : sensors_(s_cfg), motor_(m_cfg), tracker_(t_cfg, sensors_, motor_) {}
+    virtual ~TrackingUnit() {}
 
-    void begin() { motor_.begin(); }
+    virtual void begin() = 0;
+    virtual void tick(unsigned long now_ms) = 0;
 
-    void tick(unsigned long now_ms) {
-        sensors_.tick(now_ms);
-        tracker_.tick();
-        if (tracker_.hasNewSample()) {
-            last_diff_percent_ = tracker_.lastSample().diff_percent;
-            has_diff_ = true;
-        }
+    virtual void setResponseTable(const uint16_t* table) = 0;
+    virtual void setFeedforwardRate(float deg_per_s) = 0;
+    virtual uint32_t feedforwardPulses() const = 0;
 
-        if (target_override_active_) {
-            motor_.setTargetNormalized(target_override_norm_);
-        }
+    virtual bool isTransientHold() const = 0;
+    virtual uint32_t transientEvents() const = 0;
+    virtual uint32_t transientSavedMotorMs() const = 0;
 
-        bool motor_enabled = true;
-        if (motor_override_active_) {
-            motor_enabled = motor_override_enabled_;
-        }
-        motor_enabled_last_ = motor_enabled;
-        motor_.setEnabled(motor_enabled);
-        motor_.tick(now_ms);
-    }
+    virtual void applyTuning(const TrackerController::Tuning& tuning, float motor_smooth) = 0;
+    virtual void setSensorCalibration(float gain_b, float offset_b) = 0;
+    virtual void setKickHoldoffMs(unsigned long ms) = 0;
+
+    virtual uint32_t diffSamples() const = 0;
+    virtual float lastEffectiveDeadband() const = 0;
+    virtual float pwmThreshold() const = 0;
+    virtual float pwmLowNorm() const = 0;
+    virtual float pwmHighNorm() const = 0;
+    virtual unsigned long readIntervalMs() const = 0;
+    virtual uint32_t sensorReadsSkipped() const = 0;
+    virtual float appliedNorm() const = 0;
+    virtual uint32_t motorReversals() const = 0;
+    virtual uint32_t motorOnMs() const = 0;
+    virtual uint32_t motorDutyMs() const = 0;
+    virtual uint32_t motorOutputWrites() const = 0;
+    virtual uint32_t motorOutputCycles() const = 0;
+    virtual int motorStallSign() const = 0;
+    virtual const CurrentMonitor* currentMonitor() const = 0;
+    virtual uint32_t huntingEvents() const = 0;
+    virtual uint32_t huntingMotorMs() const = 0;
+    virtual float huntingBoostPercent() const = 0;
+    virtual uint32_t backlashMs() const = 0;
+    virtual uint32_t backlashMeasurements() const = 0;
+
+    virtual bool consumeLog(LogSample& out) = 0;
+
+    // CPU cycles of the last / slowest tick (sensors + controller + motor).
+    uint32_t lastTickCycles() const { return last_tick_cycles_; }
+    uint32_t maxTickCycles() const { return max_tick_cycles_; }
+    void resetTickCycles() { max_tick_cycles_ = 0; }
 
     void setMotorOverride(bool enabled) {
         motor_override_active_ = true;
@@ -62,16 +86,129 @@ public:
     bool isMotorEnabled() const { return motor_enabled_last_; }
     bool hasDiffSample() const { return has_diff_; }
     float lastDiffPercent() const { return last_diff_percent_; }
-    float lastEffectiveDeadband() const { return tracker_.lastEffectiveDeadband(); }
 
-    bool consumeLog(LogSample& out) {
+protected:
+    float last_diff_percent_ = 0.0f;
+    bool has_diff_ = false;
+    bool motor_override_active_ = false;
+    bool motor_override_enabled_ = true;
+    bool target_override_active_ = false;
+    float target_override_norm_ = 0.0f;
+    bool motor_enabled_last_ = true;
+    uint32_t last_tick_cycles_ = 0;
+    uint32_t max_tick_cycles_ = 0;
+};
+
+// Sensor pair, controller and motor of one axis. The configs come from the
+// constructor (BasicTrackingUnit<>) or are constexpr objects named as the
+// template arguments (StaticTrackingUnit), see ConfigRef.
+template <const LightSensorPair::Config* SC = nullptr,
+          const TrackerController::Config* TC = nullptr,
+          const MotorDriver::Config* MC = nullptr>
+class BasicTrackingUnit : public TrackingUnit {
+public:
+    typedef BasicLightSensorPair<SC> Sensors;
+    typedef BasicMotorDriver<MC> Motor;
+    typedef BasicTrackerController<Sensors, Motor, TC> Tracker;
+
+    BasicTrackingUnit(const LightSensorPair::Config& s_cfg,
+                      const TrackerController::Config& t_cfg,
+                      const MotorDriver::Config& m_cfg,
+                      LightSampleSource* sample_source = nullptr,
+                      PwmOutput* pwm_output = nullptr,
+                      CurrentMonitor* current_monitor = nullptr)
+        : sensors_(s_cfg, sample_source),
+          motor_(m_cfg, pwm_output, current_monitor),
+          tracker_(t_cfg, sensors_, motor_) {}
+
+    void begin() override {
+        sensors_.begin();
+        motor_.begin();
+    }
+
+    void setResponseTable(const uint16_t* table) override { sensors_.setResponseTable(table); }
+    void setFeedforwardRate(float deg_per_s) override { tracker_.setFeedforwardRate(deg_per_s); }
+    uint32_t feedforwardPulses() const override { return tracker_.feedforwardPulses(); }
+
+    bool isTransientHold() const override { return tracker_.isTransientHold(); }
+    uint32_t transientEvents() const override { return tracker_.transientEvents(); }
+    uint32_t transientSavedMotorMs() const override { return tracker_.transientSavedMotorMs(); }
+
+    void applyTuning(const TrackerController::Tuning& tuning, float motor_smooth) override {
+        tracker_.setTuning(tuning);
+        motor_.setSmooth(motor_smooth);
+    }
+
+    void setSensorCalibration(float gain_b, float offset_b) override {
+        sensors_.setCalibration(gain_b, offset_b);
+    }
+
+    void tick(unsigned long now_ms) override {
+        const uint32_t start_cycles = Platform::cycleCount();
+        sensors_.setMotorActive(motor_.isDriving());
+        sensors_.tick(now_ms);
+        tracker_.setCommandOverride(target_override_active_, target_override_norm_);
+        tracker_.tick(now_ms);
+        if (tracker_.hasNewSample()) {
+            last_diff_percent_ = tracker_.lastControlDiffPercent();
+            has_diff_ = true;
+        }
+
+        if (target_override_active_) {
+            motor_.setTargetNormalized(target_override_norm_);
+        }
+
+        bool motor_enabled = true;
+        if (motor_override_active_) {
+            motor_enabled = motor_override_enabled_;
+        }
+        motor_enabled_last_ = motor_enabled;
+        motor_.setEnabled(motor_enabled);
+        motor_.tick(now_ms);
+
+        last_tick_cycles_ = Platform::cycleCount() - start_cycles;
+        max_tick_cycles_ = max(max_tick_cycles_, last_tick_cycles_);
+    }
+
+    void setKickHoldoffMs(unsigned long ms) override { motor_.setKickHoldoffMs(ms); }
+
+    uint32_t diffSamples() const override { return tracker_.sampleCount(); }
+    float lastEffectiveDeadband() const override { return tracker_.lastEffectiveDeadband(); }
+    float pwmThreshold() const override { return tracker_.pwmThreshold(); }
+    float pwmLowNorm() const override { return tracker_.pwmLowNorm(); }
+    float pwmHighNorm() const override { return tracker_.pwmHighNorm(); }
+    unsigned long readIntervalMs() const override { return sensors_.currentReadIntervalMs(); }
+    uint32_t sensorReadsSkipped() const override { return sensors_.readsSkipped(); }
+    float appliedNorm() const override { return motor_.getAppliedNorm(); }
+    uint32_t motorReversals() const override { return motor_.reversalCount(); }
+    uint32_t motorOnMs() const override { return motor_.motorOnMs(); }
+    uint32_t motorDutyMs() const override { return motor_.motorDutyMs(); }
+    uint32_t motorOutputWrites() const override { return motor_.outputWrites(); }
+    uint32_t motorOutputCycles() const override { return motor_.outputCycles(); }
+    int motorStallSign() const override { return motor_.stallSign(); }
+    const CurrentMonitor* currentMonitor() const override { return motor_.currentMonitor(); }
+    uint32_t huntingEvents() const override { return tracker_.hunting().events(); }
+    uint32_t huntingMotorMs() const override { return tracker_.hunting().huntingMotorMs(); }
+    float huntingBoostPercent() const override { return tracker_.hunting().boostPercent(); }
+    uint32_t backlashMs() const override { return motor_.backlashMs(); }
+    uint32_t backlashMeasurements() const override { return tracker_.backlash().measurements(); }
+
+    bool consumeLog(LogSample& out) override {
         if (!tracker_.hasNewSample()) {
             return false;
         }
         const LightSensorPair::Sample s = tracker_.lastSample();
+        if (!s.window_complete) {
+            // Sliding windows emit on every read; log once per full window.
+            tracker_.clearNewSample();
+            return false;
+        }
         out.avg_a = s.avg_a;
         out.avg_b = s.avg_b;
+        out.level_a = s.level_a;
+        out.level_b_uncal = s.level_b_uncal;
         out.diff_percent = s.diff_percent;
+        out.var_diff = s.var_diff;
         out.target_norm = tracker_.lastTargetNorm();
         out.applied_norm = motor_.getAppliedNorm();
         out.applied_raw = motor_.getAppliedPwmRaw();
@@ -80,14 +217,71 @@ public:
     }
 
 private:
-    LightSensorPair sensors_;
-    MotorDriver motor_;
-    TrackerController tracker_;
-    float last_diff_percent_ = 0.0f;
-    bool has_diff_ = false;
-    bool motor_override_active_ = false;
-    bool motor_override_enabled_ = true;
-    bool target_override_active_ = false;
-    float target_override_norm_ = 0.0f;
-    bool motor_enabled_last_ = true;
+    Sensors sensors_;
+    Motor motor_;
+    Tracker tracker_;
+};
+
+// A unit on three constexpr configs with external linkage (ProjectConfig's
+// axis configs): field reads fold to constants and the branches of features
+// the configs leave off are not compiled in.
+template <const LightSensorPair::Config& S,
+          const TrackerController::Config& T,
+          const MotorDriver::Config& M>
+class StaticTrackingUnit : public BasicTrackingUnit<&S, &T, &M> {
+public:
+    explicit StaticTrackingUnit(LightSampleSource* sample_source = nullptr,
+                                PwmOutput* pwm_output = nullptr,
+                                CurrentMonitor* current_monitor = nullptr)
+        : BasicTrackingUnit<&S, &T, &M>(S, T, M, sample_source, pwm_output, current_monitor) {}
+};
+
+// An axis the build leaves out (no motor pins). Nothing is read or driven;
+// it reports a zero diff from the start, so groups and vector drive go by
+// the other axes.
+class IdleTrackingUnit : public TrackingUnit {
+public:
+    explicit IdleTrackingUnit(LightSampleSource* = nullptr,
+                              PwmOutput* = nullptr,
+                              CurrentMonitor* = nullptr) {
+        has_diff_ = true;
+    }
+
+    void begin() override {}
+    void tick(unsigned long) override {}
+
+    void setResponseTable(const uint16_t*) override {}
+    void setFeedforwardRate(float) override {}
+    uint32_t feedforwardPulses() const override { return 0; }
+
+    bool isTransientHold() const override { return false; }
+    uint32_t transientEvents() const override { return 0; }
+    uint32_t transientSavedMotorMs() const override { return 0; }
+
+    void applyTuning(const TrackerController::Tuning&, float) override {}
+    void setSensorCalibration(float, float) override {}
+    void setKickHoldoffMs(unsigned long) override {}
+
+    uint32_t diffSamples() const override { return 0; }
+    float lastEffectiveDeadband() const override { return 0.0f; }
+    float pwmThreshold() const override { return 0.0f; }
+    float pwmLowNorm() const override { return 0.0f; }
+    float pwmHighNorm() const override { return 0.0f; }
+    unsigned long readIntervalMs() const override { return 0; }
+    uint32_t sensorReadsSkipped() const override { return 0; }
+    float appliedNorm() const override { return 0.0f; }
+    uint32_t motorReversals() const override { return 0; }
+    uint32_t motorOnMs() const override { return 0; }
+    uint32_t motorDutyMs() const override { return 0; }
+    uint32_t motorOutputWrites() const override { return 0; }
+    uint32_t motorOutputCycles() const override { return 0; }
+    int motorStallSign() const override { return 0; }
+    const CurrentMonitor* currentMonitor() const override { return nullptr; }
+    uint32_t huntingEvents() const override { return 0; }
+    uint32_t huntingMotorMs() const override { return 0; }
+    float huntingBoostPercent() const override { return 0.0f; }
+    uint32_t backlashMs() const override { return 0; }
+    uint32_t backlashMeasurements() const override { return 0; }
+
+    bool consumeLog(LogSample&) override { return false; }
 };
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "util/Platform.h"
+
+#include "sensors/LightSensorPair.h"
+
+// Flags irradiance transients (cloud edges, passing shadows) from completed
+// windows: a fast relative change of avg_a + avg_b, a dip below the slow
+// baseline, or a jump of the per-read diff variance. The event ends once the
+// level has been steady for settle_ms (or after max_hold_ms, when the new
+// level is taken as the baseline, e.g. steady overcast).
+class TransientDetector {
+public:
+    struct Config {
+        bool enabled;
+        float max_level_rate;   // |d(level)/dt| / level, per second
+        float dip_ratio;        // Event while level < baseline * (1 - dip_ratio)
+        float var_ratio;        // Event while var_diff > var baseline * var_ratio
+        float baseline_tau_s;   // Baseline smoothing outside events
+        unsigned long settle_ms;
+        unsigned long max_hold_ms;
+    };
+
+    explicit TransientDetector(const Config& cfg)
+        : cfg_(cfg) {}
+
+    void reset() {
+        has_baseline_ = false;
+        active_ = false;
+        steady_since_ms_ = 0;
+    }
+
+    // Returns true while an event is active. ended() is true for the window
+    // that closed an event.
+    bool update(const LightSensorPair::Sample& sample, unsigned long now_ms) {
+        ended_ = false;
+        if (!cfg_.enabled) {
+            return false;
+        }
+
+        const float level = (float)(sample.avg_a + sample.avg_b);
+        if (!has_baseline_) {
+            baseline_ = level;
+            var_baseline_ = sample.var_diff;
+            last_level_ = level;
+            last_ms_ = now_ms;
+            has_baseline_ = true;
+            return false;
+        }
+
+        const float dt_s = (float)(now_ms - last_ms_) / 1000.0f;
+        const float rate = (dt_s > 0.0f && last_level_ > 0.0f)
+            ? fabsf(level - last_level_) / (last_level_ * dt_s)
+            : 0.0f;
+        last_level_ = level;
+        last_ms_ = now_ms;
+
+        const bool fast = rate > cfg_.max_level_rate;
+        const bool dip = level < (baseline_ * (1.0f - cfg_.dip_ratio));
+        const bool noisy = var_baseline_ > 0.0f &&
+                           sample.var_diff > (var_baseline_ * cfg_.var_ratio);
+
+        if (!active_) {
+            if (fast || dip || noisy) {
+                active_ = true;
+                events_++;
+                start_ms_ = now_ms;
+                steady_since_ms_ = 0;
+                return true;
+            }
+            // Baselines only learn from undisturbed windows.
+            const float alpha = (cfg_.baseline_tau_s > 0.0f)
+                ? min(1.0f, dt_s / cfg_.baseline_tau_s)
+                : 1.0f;
+            baseline_ += (level - baseline_) * alpha;
+            var_baseline_ += (sample.var_diff - var_baseline_) * alpha;
+            return false;
+        }
+
+        if (fast || noisy) {
+            steady_since_ms_ = 0;
+        } else if (steady_since_ms_ == 0) {
+            steady_since_ms_ = now_ms;
+        }
+
+        const bool settled = steady_since_ms_ != 0 &&
+                             (now_ms - steady_since_ms_) >= cfg_.settle_ms && !dip;
+        const bool timed_out = (now_ms - start_ms_) >= cfg_.max_hold_ms;
+        if (settled || timed_out) {
+            active_ = false;
+            ended_ = true;
+            if (timed_out) {
+                baseline_ = level;
+                var_baseline_ = sample.var_diff;
+            }
+        }
+        return active_;
+    }
+
+    bool isActive() const { return active_; }
+    bool ended() const { return ended_; }
+    uint32_t events() const { return events_; }
+
+private:
+    Config cfg_;
+    bool has_baseline_ = false;
+    bool active_ = false;
+    bool ended_ = false;
+    float baseline_ = 0.0f;
+    float var_baseline_ = 0.0f;
+    float last_level_ = 0.0f;
+    unsigned long last_ms_ = 0;
+    unsigned long start_ms_ = 0;
+    unsigned long steady_since_ms_ = 0;
+    uint32_t events_ = 0;
+};
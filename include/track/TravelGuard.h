@@ -1,7 +1,10 @@
 #pragma once
 
-#include <Arduino.h>
+#include "util/Platform.h"
 
+// A limit is a debounced switch input, or with current sensing a stall of
+// the axis motor driving toward it (setStallSign), which works without
+// endstops. The stall reads as a held switch until the drive turns away.
 class TravelGuard {
 public:
     struct Config {
@@ -34,8 +37,8 @@ public:
     }
 
     void tick(unsigned long now_ms) {
-        const bool raw_1 = readPressedRaw(cfg_.limit_pin_1);
-        const bool raw_2 = readPressedRaw(cfg_.limit_pin_2);
+        const bool raw_1 = readPressedRaw(cfg_.limit_pin_1) || stallToward(cfg_.dir_from_limit_1);
+        const bool raw_2 = readPressedRaw(cfg_.limit_pin_2) || stallToward(cfg_.dir_from_limit_2);
         updateSwitch(limit_1_, raw_1, now_ms);
         updateSwitch(limit_2_, raw_2, now_ms);
 
@@ -68,6 +71,22 @@ public:
         }
     }
 
+    // A sweep normally starts on a limit press; this starts one from a limit
+    // that is already held (e.g. a search beginning at the endstop).
+    void startSweepFromPressedLimit() {
+        if (state_ != SweepState::Idle) {
+            return;
+        }
+        if (limit_1_.stable) {
+            state_ = SweepState::ToLimit2;
+        } else if (limit_2_.stable) {
+            state_ = SweepState::ToLimit1;
+        }
+    }
+
+    // MotorDriver::stallSign() of the guarded axis, every loop before tick().
+    void setStallSign(int drive_sign) { stall_sign_ = drive_sign; }
+
     bool isSweepActive() const { return state_ != SweepState::Idle; }
 
     float sweepTargetNorm() const {
@@ -98,6 +117,11 @@ private:
         unsigned long last_change_ms = 0;
     };
 
+    // Driving toward a limit is against its dir_from_limit.
+    bool stallToward(int dir_from_limit) const {
+        return stall_sign_ != 0 && stall_sign_ == ((dir_from_limit >= 0) ? -1 : 1);
+    }
+
     bool readPressedRaw(int pin) const {
         if (pin < 0) {
             return false;
@@ -135,4 +159,5 @@ private:
     SwitchState limit_1_;
     SwitchState limit_2_;
     SweepState state_ = SweepState::Idle;
+    int stall_sign_ = 0;
 };
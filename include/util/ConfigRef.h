@@ -0,0 +1,27 @@
+#pragma once
+
+// Where a class reads its config. Named as the template argument, a
+// constexpr config with external linkage is read in place: every field is a
+// compile-time constant, derived values fold and branches on features it
+// leaves off drop out, and the object keeps no copy. Without one (nullptr)
+// the config given to the constructor is copied in, for configs built at
+// run time (tests, tools).
+template <typename Config, const Config* Static, bool IsStatic = (Static != nullptr)>
+class ConfigRef {
+public:
+    explicit ConfigRef(const Config&) {}
+
+    const Config& get() const { return *Static; }
+};
+
+template <typename Config, const Config* Static>
+class ConfigRef<Config, Static, false> {
+public:
+    explicit ConfigRef(const Config& cfg)
+        : cfg_(cfg) {}
+
+    const Config& get() const { return cfg_; }
+
+private:
+    Config cfg_;
+};
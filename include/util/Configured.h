@@ -0,0 +1,39 @@
+#pragma once
+
+// An object that exists only when a compile-time config flag enables it.
+// Disabled, the holder is empty and get() is nullptr: the class takes no
+// RAM and, never constructed, is not linked in. Constructor arguments are
+// ignored then.
+template <typename T, bool Enabled>
+class Configured {
+public:
+    Configured()
+        : value_() {}
+
+    template <typename A>
+    explicit Configured(const A& a)
+        : value_(a) {}
+
+    template <typename A, typename B>
+    Configured(const A& a, B& b)
+        : value_(a, b) {}
+
+    T* get() { return &value_; }
+
+private:
+    T value_;
+};
+
+template <typename T>
+class Configured<T, false> {
+public:
+    Configured() {}
+
+    template <typename A>
+    explicit Configured(const A&) {}
+
+    template <typename A, typename B>
+    Configured(const A&, B&) {}
+
+    T* get() { return nullptr; }
+};
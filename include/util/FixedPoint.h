@@ -0,0 +1,87 @@
+#pragma once
+
+#include <stdint.h>
+
+// Build with -DSATELLITE_FIXED_POINT=1 to run the per-read and per-tick
+// control path (window sums -> diff -> deadband -> target -> IIR -> duty) in
+// Q15 integers. Float values are still derived for display and logging, and
+// stages that run once per completed window (PID, Kalman, transient and
+// backlash estimators, LDR calibration) stay in float.
+#ifndef SATELLITE_FIXED_POINT
+#define SATELLITE_FIXED_POINT 0
+#endif
+
+// Q15: 1.0 == 32768, saturated to +-32767. Diffs use full scale == 100 %.
+namespace Q15 {
+
+static const int32_t ONE = 32768;
+static const int32_t MAX = 32767;
+static constexpr float PERCENT_PER_LSB = 100.0f / 32768.0f;
+
+constexpr int32_t saturate(int32_t v) {
+    return (v > MAX) ? MAX : (v < -MAX) ? -MAX : v;
+}
+
+// For config constants; evaluated once, not in the control path.
+constexpr int32_t fromFloat(float v) {
+    return saturate((int32_t)((v * (float)ONE) + ((v >= 0.0f) ? 0.5f : -0.5f)));
+}
+
+constexpr int32_t fromPercent(float percent) {
+    return fromFloat(percent / 100.0f);
+}
+
+inline float toFloat(int32_t q) {
+    return (float)q / (float)ONE;
+}
+
+inline float toPercent(int32_t q) {
+    return ((float)q * 100.0f) / (float)ONE;
+}
+
+inline int32_t magnitude(int32_t q) {
+    return (q < 0) ? -q : q;
+}
+
+// Rounded a * b.
+inline int32_t mul(int32_t a, int32_t b) {
+    return (int32_t)((((int64_t)a * (int64_t)b) + (ONE / 2)) >> 15);
+}
+
+// Rounded num / den, saturated; 0 for den == 0.
+inline int32_t divRound(int64_t num, int64_t den) {
+    if (den == 0) {
+        return 0;
+    }
+    if (den < 0) {
+        num = -num;
+        den = -den;
+    }
+    const int64_t q = (num >= 0) ? ((num + (den / 2)) / den) : ((num - (den / 2)) / den);
+    return (q > MAX) ? MAX : (q < -MAX) ? -MAX : (int32_t)q;
+}
+
+// num / den as a Q15 fraction.
+inline int32_t ratio(int32_t num, int32_t den) {
+    return divRound((int64_t)num * ONE, den);
+}
+
+inline uint32_t isqrt(uint64_t v) {
+    uint64_t bit = (uint64_t)1 << 62;
+    uint64_t res = 0;
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (v >= res + bit) {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
+
+} // namespace Q15
@@ -0,0 +1,93 @@
+#pragma once
+
+// Arduino core on the target. The native test env (no ARDUINO define) gets
+// the handful of core calls the hardware-independent headers use, backed by
+// a settable clock and pin table in namespace HostPlatform.
+
+#if defined(ARDUINO)
+
+#include <Arduino.h>
+
+namespace Platform {
+inline uint32_t cycleCount() { return ESP.getCycleCount(); }
+} // namespace Platform
+
+#else
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+using std::max;
+using std::min;
+
+#define PI 3.1415926535897932384626433832795
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+namespace HostPlatform {
+static const size_t PIN_COUNT = 40;
+static const size_t LEDC_CHANNELS = 16;
+
+inline unsigned long& clockUs() {
+    static unsigned long us = 0;
+    return us;
+}
+inline void setMillis(unsigned long ms) { clockUs() = ms * 1000UL; }
+inline void setMicros(unsigned long us) { clockUs() = us; }
+inline void advanceMicros(unsigned long us) { clockUs() += us; }
+
+inline int* analogPins() {
+    static int values[PIN_COUNT] = {};
+    return values;
+}
+inline int* digitalPins() {
+    static int values[PIN_COUNT] = {};
+    return values;
+}
+inline uint32_t* ledcDuty() {
+    static uint32_t duty[LEDC_CHANNELS] = {};
+    return duty;
+}
+} // namespace HostPlatform
+
+inline unsigned long millis() { return HostPlatform::clockUs() / 1000UL; }
+inline unsigned long micros() { return HostPlatform::clockUs(); }
+inline void delay(unsigned long ms) { HostPlatform::advanceMicros(ms * 1000UL); }
+inline void delayMicroseconds(unsigned int us) { HostPlatform::advanceMicros(us); }
+
+inline int analogRead(uint8_t pin) {
+    return (pin < HostPlatform::PIN_COUNT) ? HostPlatform::analogPins()[pin] : 0;
+}
+inline uint32_t analogReadMilliVolts(uint8_t pin) { return (uint32_t)analogRead(pin); }
+inline void pinMode(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t pin) {
+    return (pin < HostPlatform::PIN_COUNT) ? HostPlatform::digitalPins()[pin] : 0;
+}
+inline void digitalWrite(uint8_t pin, uint8_t value) {
+    if (pin < HostPlatform::PIN_COUNT) {
+        HostPlatform::digitalPins()[pin] = value;
+    }
+}
+
+inline double ledcSetup(uint8_t, double freq, uint8_t) { return freq; }
+inline void ledcAttachPin(uint8_t, uint8_t) {}
+inline void ledcWrite(uint8_t channel, uint32_t duty) {
+    if (channel < HostPlatform::LEDC_CHANNELS) {
+        HostPlatform::ledcDuty()[channel] = duty;
+    }
+}
+
+namespace Platform {
+inline uint32_t cycleCount() { return 0; }
+} // namespace Platform
+
+#endif
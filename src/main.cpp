@@ -2,7 +2,21 @@
 #include <WiFi.h>
 #include <esp_sleep.h>
 #include <driver/rtc_io.h>
+#include <sys/time.h>
+#include <type_traits>
 
+#include "drivers/CurrentMonitor.h"
+#include "drivers/LedcFadePwmOutput.h"
+#include "sensors/CurrentSource.h"
+#include "sensors/Ina219CurrentSource.h"
+#include "sensors/AdcCalibratedResponse.h"
+#include "sensors/AdcDmaSampler.h"
+#include "sensors/LdrCalibrator.h"
+#include "sensors/MuxScanner.h"
+#include "track/RelayAutoTuner.h"
+#include "track/RelayTuneStore.h"
+#include "track/SunAcquisition.h"
+#include "track/SunEphemeris.h"
 #include "track/TrackingUnit.h"
 #include "track/TrackingCoordinator.h"
 #include "track/TravelGuard.h"
@@ -10,10 +24,12 @@
 #include "sensors/TouchButton.h"
 #include "display/DisplayManager.h"
 #include "config/ProjectConfig.h"
+#include "util/Configured.h"
 
 enum class SystemMode {
     Active,
     ActiveBlocked,
+    AutoTune,
     DeepSleep
 };
 
@@ -23,6 +39,8 @@ static const char* systemModeName(SystemMode mode) {
         return "ACTIVE";
     case SystemMode::ActiveBlocked:
         return "ACTIVE_BLOCKED";
+    case SystemMode::AutoTune:
+        return "AUTOTUNE";
     case SystemMode::DeepSleep:
         return "DEEPSLEEP";
     default:
@@ -30,22 +48,110 @@ static const char* systemModeName(SystemMode mode) {
     }
 }
 
-TrackingUnit tracking_unit_h(
-    ProjectConfig::SENSOR_CFG_H,
-    ProjectConfig::TRACKER_CFG_H,
-    ProjectConfig::MOTOR_CFG_H);
-TrackingUnit tracking_unit_v(
-    ProjectConfig::SENSOR_CFG_V,
-    ProjectConfig::TRACKER_CFG_V,
-    ProjectConfig::MOTOR_CFG_V);
+// Backends a config flag leaves off are not built (util/Configured.h).
+Configured<AdcDmaSampler,
+           ProjectConfig::LIGHT_SAMPLER_USE_DMA && !ProjectConfig::LIGHT_SAMPLER_USE_MUX>
+    light_sampler(ProjectConfig::LIGHT_SAMPLER_CFG);
+// The mux select lines and the scanner that drives them.
+struct MuxLightSource {
+    GpioMuxIo io;
+    MuxScanner scanner;
+
+    MuxLightSource()
+        : io(ProjectConfig::MUX_IO_CFG),
+          scanner(ProjectConfig::MUX_SCANNER_CFG, io) {}
+};
+Configured<MuxLightSource, ProjectConfig::LIGHT_SAMPLER_USE_MUX> mux_light;
+LightSampleSource* const light_source =
+    (mux_light.get() != nullptr) ? static_cast<LightSampleSource*>(&mux_light.get()->scanner)
+    : static_cast<LightSampleSource*>(light_sampler.get());
+// The 8 KB eFuse table exists only for a calibrated response.
+Configured<AdcCalibratedResponse,
+           ProjectConfig::LIGHT_RESPONSE_USE_EFUSE &&
+               ProjectConfig::LIGHT_RESPONSE != LightSensorPair::Response::Raw>
+    light_response(ProjectConfig::LIGHT_RESPONSE_CAL_CFG);
+Configured<LedcFadePwmOutput, ProjectConfig::MOTOR_USE_HW_FADE> motor_fade_output;
+PwmOutput* const motor_output = motor_fade_output.get();
+
+// One axis's current source and the monitor reading it.
+template <typename Source>
+struct CurrentSense {
+    Source source;
+    CurrentMonitor monitor;
+
+    explicit CurrentSense(const typename Source::Config& cfg)
+        : source(cfg),
+          monitor(ProjectConfig::CURRENT_MONITOR_CFG, source) {}
+};
+
+Configured<CurrentSense<ShuntAdcCurrentSource>,
+           ProjectConfig::CURRENT_SENSE_ENABLED_H && !ProjectConfig::CURRENT_SENSE_USE_INA219>
+    current_shunt_h(ProjectConfig::CURRENT_SHUNT_CFG_H);
+Configured<CurrentSense<ShuntAdcCurrentSource>,
+           ProjectConfig::CURRENT_SENSE_ENABLED_V && !ProjectConfig::CURRENT_SENSE_USE_INA219>
+    current_shunt_v(ProjectConfig::CURRENT_SHUNT_CFG_V);
+Configured<CurrentSense<Ina219CurrentSource>,
+           ProjectConfig::CURRENT_SENSE_ENABLED_H && ProjectConfig::CURRENT_SENSE_USE_INA219>
+    current_ina219_h(ProjectConfig::CURRENT_INA219_CFG_H);
+Configured<CurrentSense<Ina219CurrentSource>,
+           ProjectConfig::CURRENT_SENSE_ENABLED_V && ProjectConfig::CURRENT_SENSE_USE_INA219>
+    current_ina219_v(ProjectConfig::CURRENT_INA219_CFG_V);
+
+// The monitor of whichever backend the axis built, nullptr for none.
+template <typename Shunt, typename Ina219>
+static CurrentMonitor* currentMonitor(Shunt* shunt, Ina219* ina219) {
+    return (shunt != nullptr) ? &shunt->monitor
+        : (ina219 != nullptr) ? &ina219->monitor
+        : nullptr;
+}
+
+// An axis runs on its constexpr configs, or is an IdleTrackingUnit when it
+// has no motor pins: its sensor, controller and motor code is not built.
+template <bool Enabled,
+          const LightSensorPair::Config& S,
+          const TrackerController::Config& T,
+          const MotorDriver::Config& M>
+using AxisUnit =
+    typename std::conditional<Enabled, StaticTrackingUnit<S, T, M>, IdleTrackingUnit>::type;
+
+AxisUnit<ProjectConfig::AXIS_H_ENABLED,
+         ProjectConfig::SENSOR_CFG_H,
+         ProjectConfig::TRACKER_CFG_H,
+         ProjectConfig::MOTOR_CFG_H>
+    tracking_unit_h(light_source,
+                    motor_output,
+                    currentMonitor(current_shunt_h.get(), current_ina219_h.get()));
+AxisUnit<ProjectConfig::AXIS_V_ENABLED,
+         ProjectConfig::SENSOR_CFG_V,
+         ProjectConfig::TRACKER_CFG_V,
+         ProjectConfig::MOTOR_CFG_V>
+    tracking_unit_v(light_source,
+                    motor_output,
+                    currentMonitor(current_shunt_v.get(), current_ina219_v.get()));
+LdrCalibrator ldr_calibrator_h(ProjectConfig::LDR_CALIBRATION_CFG_H);
+LdrCalibrator ldr_calibrator_v(ProjectConfig::LDR_CALIBRATION_CFG_V);
+RelayAutoTuner relay_tuner_h(ProjectConfig::AUTOTUNE_CFG_H);
+RelayAutoTuner relay_tuner_v(ProjectConfig::AUTOTUNE_CFG_V);
+RelayTuneStore tune_store_h(ProjectConfig::AUTOTUNE_CFG_H);
+RelayTuneStore tune_store_v(ProjectConfig::AUTOTUNE_CFG_V);
 TrackingCoordinator tracking_coordinator(
     {
         ProjectConfig::AUTO_BLOCK_DEADBAND_HOLD_MS,
-        ProjectConfig::AUTO_BLOCK_DURATION_MS
+        ProjectConfig::AUTO_BLOCK_DURATION_MS,
+        ProjectConfig::TRACKING_MODE,
+        ProjectConfig::TRACKING_VECTOR_PERIOD_MS,
+        ProjectConfig::AUTO_BLOCK_PREDICTIVE,
+        ProjectConfig::AUTO_BLOCK_MARGIN,
+        ProjectConfig::AUTO_BLOCK_DRIFT_SIGMA,
+        ProjectConfig::AUTO_BLOCK_MIN_MS,
+        ProjectConfig::AUTO_BLOCK_MAX_MS
     },
     tracking_unit_h,
     tracking_unit_v);
+TrackingUnit* const tracking_units[] = {&tracking_unit_h, &tracking_unit_v};
 TravelGuard travel_guard(ProjectConfig::TRAVEL_GUARD_CFG);
+SunEphemeris sun_ephemeris(ProjectConfig::SUN_EPHEMERIS_CFG);
+SunAcquisition sun_acquisition(ProjectConfig::SUN_ACQUISITION_CFG);
 
 Dht11Sensor dht11(ProjectConfig::DHT_CFG);
 TouchButton touch_button(ProjectConfig::TOUCH_BUTTON_CFG);
@@ -53,22 +159,216 @@ DisplayManager display(ProjectConfig::DISPLAY_CFG);
 SystemMode system_mode = SystemMode::Active;
 
 static void applySystemMode(SystemMode mode) {
-    if (mode == SystemMode::Active) {
-        tracking_coordinator.setEnabled(true);
+    if (mode == SystemMode::Active || mode == SystemMode::AutoTune) {
+        tracking_coordinator.setEnabled(mode == SystemMode::Active);
         tracking_coordinator.resetState();
-        tracking_unit_h.setMotorOverride(true);
-        tracking_unit_v.setMotorOverride(true);
+        for (TrackingUnit* unit : tracking_units) {
+            unit->setMotorOverride(true);
+        }
     } else if (mode == SystemMode::ActiveBlocked) {
         tracking_coordinator.setEnabled(false);
         tracking_coordinator.resetState();
-        tracking_unit_h.setMotorOverride(false);
-        tracking_unit_v.setMotorOverride(false);
+        for (TrackingUnit* unit : tracking_units) {
+            unit->setMotorOverride(false);
+        }
     } else {
         tracking_coordinator.setEnabled(false);
         tracking_coordinator.resetState();
-        tracking_unit_h.clearMotorOverride();
-        tracking_unit_v.clearMotorOverride();
+        for (TrackingUnit* unit : tracking_units) {
+            unit->clearMotorOverride();
+        }
+    }
+}
+
+static void finishLdrCalibration(LdrCalibrator& calibrator,
+                                 TrackingUnit& unit,
+                                 const char* axis) {
+    float gain = 1.0f;
+    float offset = 0.0f;
+    const uint16_t windows = calibrator.windowCount();
+    const uint16_t rejected = calibrator.rejectedCount();
+    if (!calibrator.finish(gain, offset)) {
+        return;
     }
+    unit.setSensorCalibration(gain, offset);
+    calibrator.save(gain, offset);
+    Serial.print("[DBG] LDR cal ");
+    Serial.print(axis);
+    Serial.print(": gain=");
+    Serial.print(gain, 4);
+    Serial.print(" offset=");
+    Serial.print(offset, 2);
+    Serial.print(" windows=");
+    Serial.print(windows);
+    Serial.print(" rejected=");
+    Serial.println(rejected);
+}
+
+static void printTuneResult(const RelayAutoTuner::Result& r, const char* axis) {
+    Serial.print("[DBG] Autotune ");
+    Serial.print(axis);
+    Serial.print(": Ku=");
+    Serial.print(r.ku, 4);
+    Serial.print(" Tu=");
+    Serial.print(r.tu_s, 2);
+    Serial.print("s a=");
+    Serial.print(r.amplitude_percent, 2);
+    Serial.print(" | db=");
+    Serial.print(r.tuning.diff_deadband, 2);
+    Serial.print(" thr=");
+    Serial.print(r.tuning.diff_pwm_threshold, 2);
+    Serial.print(" kp=");
+    Serial.print(r.tuning.pid_kp, 4);
+    Serial.print(" ki=");
+    Serial.print(r.tuning.pid_ki, 4);
+    Serial.print(" kd=");
+    Serial.print(r.tuning.pid_kd, 4);
+    Serial.print(" smooth=");
+    Serial.println(r.motor_smooth, 3);
+}
+
+static void finishAutoTune(RelayAutoTuner& tuner, RelayTuneStore& store, TrackingUnit& unit,
+                           const char* axis) {
+    RelayAutoTuner::Result r;
+    if (tuner.result(r)) {
+        unit.applyTuning(r.tuning, r.motor_smooth);
+        store.save(r);
+        printTuneResult(r, axis);
+    } else if (tuner.state() == RelayAutoTuner::State::Failed) {
+        Serial.print("[DBG] Autotune ");
+        Serial.print(axis);
+        Serial.println(": no limit cycle (timeout)");
+    }
+    tuner.cancel();
+}
+
+static bool isMotorConfigured(int in1_pin, int in2_pin) {
+    return in1_pin >= 0 && in2_pin >= 0;
+}
+
+// A search needs the V motor and both limits (endstops or V current
+// sensing); with the clock set it is also skipped while the sun is below the
+// horizon.
+static bool canStartAcquisition() {
+    const bool has_limits = ProjectConfig::CURRENT_SENSE_ENABLED_V ||
+        (ProjectConfig::TRAVEL_GUARD_PIN_1 >= 0 && ProjectConfig::TRAVEL_GUARD_PIN_2 >= 0);
+    if (!isMotorConfigured(ProjectConfig::MOTOR_V_IN1_PIN, ProjectConfig::MOTOR_V_IN2_PIN) ||
+        !has_limits) {
+        return false;
+    }
+    const time_t utc = time(nullptr);
+    return !SunEphemeris::isValidTime(utc) ||
+           sun_ephemeris.position(utc).elevation_deg > ProjectConfig::SUN_MIN_ELEVATION_DEG;
+}
+
+// One line per finished move and per stall.
+static void logMotorCurrent(const TrackingUnit& unit, const char* axis,
+                            uint32_t& last_moves, uint32_t& last_stalls) {
+    const CurrentMonitor* monitor = unit.currentMonitor();
+    if (monitor == nullptr) {
+        return;
+    }
+    if (monitor->moves() != last_moves) {
+        last_moves = monitor->moves();
+        Serial.print("[DBG] Move ");
+        Serial.print(axis);
+        Serial.print(": J=");
+        Serial.print(monitor->lastMoveJoules(), 2);
+        Serial.print(" peak A=");
+        Serial.println(monitor->lastMovePeakAmps(), 2);
+    }
+    if (monitor->stalls() != last_stalls) {
+        last_stalls = monitor->stalls();
+        Serial.print("[DBG] Stall ");
+        Serial.print(axis);
+        Serial.print(": dir=");
+        Serial.print(unit.motorStallSign());
+        Serial.print(" A=");
+        Serial.println(monitor->amps(), 2);
+    }
+}
+
+static void startAcquisition(unsigned long now_ms) {
+    sun_acquisition.start(now_ms);
+    travel_guard.startSweepFromPressedLimit();
+    Serial.println("[DBG] Acquisition: start");
+}
+
+static void handleSerialCommand(const char* line) {
+    if (strcmp(line, "acquire") == 0) {
+        if (!canStartAcquisition() ||
+            system_mode == SystemMode::ActiveBlocked || system_mode == SystemMode::AutoTune) {
+            Serial.println("[DBG] acquire: not available");
+        } else {
+            startAcquisition(millis());
+        }
+        return;
+    }
+    if (strcmp(line, "tune") == 0) {
+        if (!ProjectConfig::AUTOTUNE_ENABLED) {
+            Serial.println("[DBG] tune: disabled in config");
+        } else if (system_mode != SystemMode::DeepSleep) {
+            system_mode = SystemMode::AutoTune;
+        }
+        return;
+    }
+    if (strncmp(line, "time=", 5) == 0) {
+        const long long epoch = atoll(line + 5);
+        if (!SunEphemeris::isValidTime((time_t)epoch)) {
+            Serial.println("[DBG] time: invalid");
+            return;
+        }
+        struct timeval tv;
+        tv.tv_sec = (time_t)epoch;
+        tv.tv_usec = 0;
+        settimeofday(&tv, nullptr);
+        Serial.print("[DBG] time set: ");
+        Serial.println((long)epoch);
+        return;
+    }
+    Serial.print("[DBG] unknown command: ");
+    Serial.println(line);
+}
+
+// Line-based commands on the debug port, e.g. "time=1718000000", "tune",
+// "acquire".
+static void pollSerialCommands() {
+    static char line[32];
+    static size_t len = 0;
+    while (Serial.available() > 0) {
+        const int c = Serial.read();
+        if (c == '\r' || c == '\n') {
+            if (len > 0) {
+                line[len] = '\0';
+                handleSerialCommand(line);
+                len = 0;
+            }
+        } else if (len < sizeof(line) - 1) {
+            line[len++] = (char)c;
+        }
+    }
+}
+
+static void updateSunFeedforward(unsigned long now_ms) {
+    static unsigned long last_update_ms = 0;
+    if (last_update_ms != 0 &&
+        (now_ms - last_update_ms) < ProjectConfig::SUN_FEEDFORWARD_UPDATE_MS) {
+        return;
+    }
+    last_update_ms = now_ms;
+
+    const time_t utc = time(nullptr);
+    float rate_h = 0.0f;
+    float rate_v = 0.0f;
+    if (SunEphemeris::isValidTime(utc)) {
+        const SunEphemeris::Rates sun = sun_ephemeris.rates(utc);
+        if (sun.position.elevation_deg > ProjectConfig::SUN_MIN_ELEVATION_DEG) {
+            rate_h = (float)ProjectConfig::FF_DIRECTION_H * sun.azimuth_deg_per_s;
+            rate_v = (float)ProjectConfig::FF_DIRECTION_V * sun.elevation_deg_per_s;
+        }
+    }
+    tracking_unit_h.setFeedforwardRate(rate_h);
+    tracking_unit_v.setFeedforwardRate(rate_v);
 }
 
 static bool isRtcGpio(int pin) {
@@ -92,11 +392,11 @@ static void holdBacklightForSleep() {
 }
 
 static void prepareForSleep(unsigned long now_ms) {
-    tracking_unit_h.setMotorOverride(false);
-    tracking_unit_v.setMotorOverride(false);
-    tracking_unit_v.clearTargetOverride();
-    tracking_unit_h.tick(now_ms);
-    tracking_unit_v.tick(now_ms);
+    for (TrackingUnit* unit : tracking_units) {
+        unit->setMotorOverride(false);
+        unit->clearTargetOverride();
+        unit->tick(now_ms);
+    }
     display.setMode(DisplayManager::Mode::Off);
     display.setBacklight(false);
     holdBacklightForSleep();
@@ -156,9 +456,44 @@ void setup() {
     // ESP32 ADC configuration
     analogReadResolution(12);       // Range: 0-4095
     analogSetAttenuation(ADC_11db); // Up to ~3.3 V
+    if (mux_light.get() != nullptr) {
+        mux_light.get()->scanner.begin();
+    } else if (light_sampler.get() != nullptr) {
+        light_sampler.get()->begin();
+    }
+
+    AdcCalibratedResponse* const response = light_response.get();
+    if (response != nullptr && response->begin()) {
+        for (TrackingUnit* unit : tracking_units) {
+            unit->setResponseTable(response->table());
+        }
+        Serial.println("[DBG] LDR response table from eFuse ADC calibration");
+    }
+    if (ProjectConfig::AUTOTUNE_ENABLED) {
+        RelayAutoTuner::Result tuned;
+        if (tune_store_h.load(tuned)) {
+            tracking_unit_h.applyTuning(tuned.tuning, tuned.motor_smooth);
+            printTuneResult(tuned, "H");
+        }
+        if (tune_store_v.load(tuned)) {
+            tracking_unit_v.applyTuning(tuned.tuning, tuned.motor_smooth);
+            printTuneResult(tuned, "V");
+        }
+    }
+    if (ProjectConfig::LDR_CALIBRATION_ENABLED) {
+        float gain = 1.0f;
+        float offset = 0.0f;
+        if (ldr_calibrator_h.load(gain, offset)) {
+            tracking_unit_h.setSensorCalibration(gain, offset);
+        }
+        if (ldr_calibrator_v.load(gain, offset)) {
+            tracking_unit_v.setSensorCalibration(gain, offset);
+        }
+    }
 
-    tracking_unit_h.begin();
-    tracking_unit_v.begin();
+    for (TrackingUnit* unit : tracking_units) {
+        unit->begin();
+    }
     travel_guard.begin();
     dht11.begin();
     touch_button.begin();
@@ -187,17 +522,20 @@ void setup() {
 
 void loop() {
     const unsigned long now_ms = millis();
+    pollSerialCommands();
+    if (ProjectConfig::SUN_FEEDFORWARD_ENABLED) {
+        updateSunFeedforward(now_ms);
+    }
     touch_button.tick(now_ms);
+    travel_guard.setStallSign(tracking_unit_v.motorStallSign());
     travel_guard.tick(now_ms);
     const bool travel_sweep_active = travel_guard.isSweepActive();
     const float travel_target_norm = travel_sweep_active
         ? travel_guard.sweepTargetNorm()
         : 0.0f;
-    if (travel_sweep_active) {
-        tracking_unit_v.setTargetOverride(travel_target_norm);
-    } else {
-        tracking_unit_v.clearTargetOverride();
-    }
+    sun_acquisition.tick(now_ms, travel_sweep_active, travel_target_norm,
+                         tracking_unit_v.appliedNorm());
+    const bool acquisition_active = sun_acquisition.isActive();
     static SystemMode last_mode = system_mode;
     static unsigned long deep_sleep_deadband_ms = 0;
     static bool have_diff_h = false;
@@ -205,7 +543,9 @@ void loop() {
     static float last_pwm_norm_h = 0.0f;
     static float last_pwm_norm_v = 0.0f;
     if (touch_button.consumeLongPress()) {
-        if (system_mode != SystemMode::DeepSleep) {
+        if (ProjectConfig::AUTOTUNE_ENABLED && system_mode == SystemMode::ActiveBlocked) {
+            system_mode = SystemMode::AutoTune;
+        } else if (system_mode != SystemMode::DeepSleep) {
             system_mode = SystemMode::DeepSleep;
             applySystemMode(system_mode);
             prepareForSleep(now_ms);
@@ -219,28 +559,80 @@ void loop() {
             system_mode = SystemMode::ActiveBlocked;
         } else if (system_mode == SystemMode::ActiveBlocked) {
             system_mode = SystemMode::Active;
+        } else if (system_mode == SystemMode::AutoTune) {
+            system_mode = SystemMode::Active;
         }
     }
+    if (system_mode == SystemMode::AutoTune &&
+        !relay_tuner_h.isRunning() && !relay_tuner_v.isRunning() &&
+        last_mode == SystemMode::AutoTune) {
+        finishAutoTune(relay_tuner_h, tune_store_h, tracking_unit_h, "H");
+        finishAutoTune(relay_tuner_v, tune_store_v, tracking_unit_v, "V");
+        system_mode = SystemMode::Active;
+    }
     if (last_mode != system_mode) {
         applySystemMode(system_mode);
         display.setActiveIndicator(system_mode == SystemMode::Active);
         Serial.print("[DBG] Mode -> ");
         Serial.println(systemModeName(system_mode));
+        if (ProjectConfig::LDR_CALIBRATION_ENABLED) {
+            if (system_mode == SystemMode::ActiveBlocked) {
+                ldr_calibrator_h.start();
+                ldr_calibrator_v.start();
+            } else if (last_mode == SystemMode::ActiveBlocked) {
+                finishLdrCalibration(ldr_calibrator_h, tracking_unit_h, "H");
+                finishLdrCalibration(ldr_calibrator_v, tracking_unit_v, "V");
+            }
+        }
+        if (system_mode == SystemMode::ActiveBlocked || system_mode == SystemMode::AutoTune) {
+            sun_acquisition.cancel();
+        }
+        if (system_mode == SystemMode::AutoTune) {
+            if (isMotorConfigured(ProjectConfig::MOTOR_H_IN1_PIN, ProjectConfig::MOTOR_H_IN2_PIN)) {
+                relay_tuner_h.start(now_ms);
+            }
+            if (isMotorConfigured(ProjectConfig::MOTOR_V_IN1_PIN, ProjectConfig::MOTOR_V_IN2_PIN)) {
+                relay_tuner_v.start(now_ms);
+            }
+        } else if (last_mode == SystemMode::AutoTune) {
+            // Aborted (button); a completed run was finished above.
+            relay_tuner_h.cancel();
+            relay_tuner_v.cancel();
+            tracking_unit_h.clearTargetOverride();
+            tracking_unit_v.clearTargetOverride();
+        }
         last_mode = system_mode;
     }
 
     if (system_mode == SystemMode::Active) {
         tracking_coordinator.tick(now_ms);
     }
+    // After the coordinator: sweep, search and tuning take the axis from
+    // a vector-mode target.
     if (travel_sweep_active) {
+        tracking_unit_v.setTargetOverride(travel_target_norm);
+    } else if (acquisition_active) {
+        tracking_unit_v.setTargetOverride(sun_acquisition.targetNorm());
+    } else if (relay_tuner_v.isRunning()) {
+        tracking_unit_v.setTargetOverride(relay_tuner_v.output());
+    } else if (!tracking_coordinator.ownsTargets()) {
+        tracking_unit_v.clearTargetOverride();
+    }
+    if (relay_tuner_h.isRunning()) {
+        tracking_unit_h.setTargetOverride(relay_tuner_h.output());
+    } else if (!tracking_coordinator.ownsTargets()) {
+        tracking_unit_h.clearTargetOverride();
+    }
+    if (travel_sweep_active || acquisition_active) {
         tracking_unit_v.setMotorOverride(true);
     } else if (system_mode == SystemMode::ActiveBlocked) {
         tracking_unit_v.setMotorOverride(false);
     } else if (system_mode == SystemMode::DeepSleep) {
         tracking_unit_v.clearMotorOverride();
     }
-    tracking_unit_h.tick(now_ms);
-    tracking_unit_v.tick(now_ms);
+    for (TrackingUnit* unit : tracking_units) {
+        unit->tick(now_ms);
+    }
     dht11.tick(now_ms);
     {
         static float last_display_deadband = -1.0f;
@@ -255,8 +647,103 @@ void loop() {
             }
         }
     }
-    display.setBlocked(
-        !(tracking_unit_h.isMotorEnabled() && tracking_unit_v.isMotorEnabled()));
+    {
+        static SunAcquisition::State last_acq_state = SunAcquisition::State::Idle;
+        static bool last_acq_locked = false;
+        const SunAcquisition::State acq_state = sun_acquisition.state();
+        if (acq_state != last_acq_state) {
+            if (acq_state == SunAcquisition::State::Done) {
+                Serial.print("[DBG] Acquisition: peak level=");
+                Serial.print(sun_acquisition.peakLevel());
+                Serial.print(" search ms=");
+                Serial.println(sun_acquisition.searchMs());
+            } else if (acq_state == SunAcquisition::State::Failed) {
+                Serial.println("[DBG] Acquisition: no sun found");
+            }
+            last_acq_state = acq_state;
+        }
+        if (sun_acquisition.isLocked() && !last_acq_locked) {
+            Serial.print("[DBG] Acquisition: locked, time-to-lock ms=");
+            Serial.println(sun_acquisition.timeToLockMs());
+        }
+        last_acq_locked = sun_acquisition.isLocked();
+        if ((system_mode == SystemMode::Active || system_mode == SystemMode::DeepSleep) &&
+            sun_acquisition.wantsStart(now_ms) && canStartAcquisition()) {
+            startAcquisition(now_ms);
+        }
+    }
+    {
+        static uint32_t last_hunting_events = 0;
+        uint32_t hunting_events = 0;
+        uint32_t hunting_motor_ms = 0;
+        uint32_t duty_ms = 0;
+        for (const TrackingUnit* unit : tracking_units) {
+            hunting_events += unit->huntingEvents();
+            hunting_motor_ms += unit->huntingMotorMs();
+            duty_ms += unit->motorDutyMs();
+        }
+        if (hunting_events != last_hunting_events) {
+            Serial.print("[DBG] Hunting: events=");
+            Serial.print(hunting_events);
+            Serial.print(" boost H/V=");
+            Serial.print(tracking_unit_h.huntingBoostPercent(), 2);
+            Serial.print("/");
+            Serial.print(tracking_unit_v.huntingBoostPercent(), 2);
+            Serial.print(" hunting motor ms=");
+            Serial.print(hunting_motor_ms);
+            Serial.print(" duty ms=");
+            Serial.println(duty_ms);
+            last_hunting_events = hunting_events;
+        }
+    }
+    {
+        static uint32_t last_blocks = 0;
+        if (tracking_coordinator.blocks() != last_blocks) {
+            Serial.print("[DBG] Block ms=");
+            Serial.print(tracking_coordinator.lastBlockMs());
+            Serial.print(" drift H/V %/s=");
+            Serial.print(tracking_coordinator.driftHPercentPerS(), 4);
+            Serial.print("/");
+            Serial.print(tracking_coordinator.driftVPercentPerS(), 4);
+            Serial.print(" predicted=");
+            Serial.print(tracking_coordinator.predictedBlocks());
+            Serial.print("/");
+            Serial.println(tracking_coordinator.blocks());
+            last_blocks = tracking_coordinator.blocks();
+        }
+    }
+    {
+        static bool last_transient_hold = false;
+        bool transient_hold = false;
+        uint32_t saved_motor_ms = 0;
+        for (const TrackingUnit* unit : tracking_units) {
+            transient_hold = transient_hold || unit->isTransientHold();
+            saved_motor_ms += unit->transientSavedMotorMs();
+        }
+        if (transient_hold != last_transient_hold) {
+            Serial.print("[DBG] Transient hold ");
+            Serial.print(transient_hold ? "start" : "end");
+            Serial.print(" | saved motor ms=");
+            Serial.println(saved_motor_ms);
+            last_transient_hold = transient_hold;
+        }
+    }
+    {
+        bool all_motors_enabled = true;
+        for (const TrackingUnit* unit : tracking_units) {
+            all_motors_enabled = all_motors_enabled && unit->isMotorEnabled();
+        }
+        display.setBlocked(!all_motors_enabled);
+    }
+    {
+        static unsigned long last_read_interval_ms = 0;
+        const unsigned long read_interval_ms = max(
+            tracking_unit_h.readIntervalMs(), tracking_unit_v.readIntervalMs());
+        if (read_interval_ms != last_read_interval_ms) {
+            display.setReadIntervalMs(read_interval_ms);
+            last_read_interval_ms = read_interval_ms;
+        }
+    }
 
     TrackingUnit::LogSample log_h;
     static float last_diff_percent_h = 0.0f;
@@ -265,6 +752,9 @@ void loop() {
         last_diff_percent_h = log_h.diff_percent;
         last_pwm_norm_h = log_h.applied_norm;
         have_diff_h = true;
+        ldr_calibrator_h.add(log_h.level_a, log_h.level_b_uncal,
+                             log_h.avg_a, log_h.avg_b, log_h.var_diff);
+        relay_tuner_h.update(log_h.diff_percent, now_ms);
         display.setTrackingRawH(log_h.avg_a, log_h.avg_b);
         display.setTrackingInfoHV(last_diff_percent_h, last_diff_percent_v);
         display.setMotorPwmHV(last_pwm_norm_h, last_pwm_norm_v);
@@ -275,6 +765,14 @@ void loop() {
         last_diff_percent_v = log_v.diff_percent;
         last_pwm_norm_v = log_v.applied_norm;
         have_diff_v = true;
+        ldr_calibrator_v.add(log_v.level_a, log_v.level_b_uncal,
+                             log_v.avg_a, log_v.avg_b, log_v.var_diff);
+        relay_tuner_v.update(log_v.diff_percent, now_ms);
+        sun_acquisition.addWindow(
+            log_v.avg_a,
+            log_v.avg_b,
+            fabsf(log_v.diff_percent) <= tracking_unit_v.lastEffectiveDeadband(),
+            now_ms);
         display.setTrackingRawV(log_v.avg_a, log_v.avg_b);
         display.setTrackingInfoHV(last_diff_percent_h, last_diff_percent_v);
         display.setMotorPwmHV(last_pwm_norm_h, last_pwm_norm_v);
@@ -328,6 +826,43 @@ void loop() {
         }
     }
 
+    if (ProjectConfig::LOG_TICK_CYCLES_ENABLED) {
+        static unsigned long last_cycles_log_ms = 0;
+        if (now_ms - last_cycles_log_ms >= ProjectConfig::LOG_TICK_CYCLES_INTERVAL_MS) {
+            last_cycles_log_ms = now_ms;
+            Serial.print("[DBG] Tick cycles fixed=");
+            Serial.print(SATELLITE_FIXED_POINT);
+            Serial.print(" H=");
+            Serial.print(tracking_unit_h.lastTickCycles());
+            Serial.print("/");
+            Serial.print(tracking_unit_h.maxTickCycles());
+            Serial.print(" V=");
+            Serial.print(tracking_unit_v.lastTickCycles());
+            Serial.print("/");
+            Serial.print(tracking_unit_v.maxTickCycles());
+            Serial.print(" | PWM writes/cycles H=");
+            Serial.print(tracking_unit_h.motorOutputWrites());
+            Serial.print("/");
+            Serial.print(tracking_unit_h.motorOutputCycles());
+            Serial.print(" V=");
+            Serial.print(tracking_unit_v.motorOutputWrites());
+            Serial.print("/");
+            Serial.println(tracking_unit_v.motorOutputCycles());
+            for (TrackingUnit* unit : tracking_units) {
+                unit->resetTickCycles();
+            }
+        }
+    }
+
+    {
+        static uint32_t moves_h = 0;
+        static uint32_t stalls_h = 0;
+        static uint32_t moves_v = 0;
+        static uint32_t stalls_v = 0;
+        logMotorCurrent(tracking_unit_h, "H", moves_h, stalls_h);
+        logMotorCurrent(tracking_unit_v, "V", moves_v, stalls_v);
+    }
+
     Dht11Sensor::Sample dht_log;
     if (dht11.consumeSample(dht_log)) {
         display.setEnvironment(dht_log.temperature_c, dht_log.humidity_pct);
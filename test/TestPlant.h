@@ -0,0 +1,77 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+#include "drivers/MotorDriver.h"
+#include "sensors/LightSensorPair.h"
+#include "track/TrackerController.h"
+
+// Host fixtures shared by the closed-loop tests: one axis's default configs,
+// the LDR pair it looks through and the geared DC motor it drives.
+namespace TestPlant {
+
+// BangBang, deadband 1 %, pwm threshold 15 %, no low-light tiers, every
+// detector off. Tests set the fields they exercise.
+inline TrackerController::Config trackerConfig() {
+    const OffsetKalman::Config kalman = {8.0f, 0.5f, 0.01f, 6.0f};
+    const TransientDetector::Config transient = {false, 0.5f, 0.3f, 9.0f, 60.0f, 2000, 120000};
+    const BacklashEstimator::Config backlash = {false, 0.5f, 0.25f, 3000};
+    const HuntingDetector::Config hunting = {false, 2000, 4, 0.5f, 5.0f, 0.02f};
+    return {1.0f, 15.0f, 0.4f, 0.99f, 0, 0.0f, 0, 0.0f, 0, 0.0f,
+            TrackerController::DeadbandMode::Tiered, 3.0f,
+            TrackerController::ControlMode::BangBang, 0.0f, 0.0f, 0.0f, 500, 2000, 1.0f,
+            0.0f, false, kalman, 0.01f, 1.0f, transient, backlash, hunting};
+}
+
+// Polled pair, 3 ms reads, 120 ms windows, mean of raw counts.
+inline LightSensorPair::Config sensorConfig(
+        int pin_a, int pin_b,
+        LightSensorPair::WindowMode mode = LightSensorPair::WindowMode::Block) {
+    return {pin_a, pin_b, 3, 120, mode, LightSensorPair::Estimator::Mean, 20,
+            LightSensorPair::Response::Raw, nullptr, 0, 0.0f, 0, false, 0.0f};
+}
+
+// Unconnected 8-bit driver on 10 ms updates, exponential profile.
+inline MotorDriver::Config motorConfig(float smooth, float kick_norm, unsigned long kick_ms) {
+    return {-1, -1, 20000, 8, 0, 1, smooth, 10, kick_norm, kick_ms, 0.0f, 0,
+            MotorDriver::Profile::Exponential, 2.0f, 20.0f, 400.0f};
+}
+
+// Count of one LDR (side +1 for A, -1 for B) at `level` with the axis `err`
+// degrees off the sun: 2 % diff per degree, saturating at 30 %.
+inline int pairCount(double level, double err, int side) {
+    const double diff = constrain(4.0 * err, -60.0, 60.0);
+    return (int)lround(level * (1.0 + (side * diff) / 200.0));
+}
+
+// 6 deg/s at full duty with a 0.3 dead zone and a 100 ms speed lag, stepped
+// once per ms.
+struct Axis {
+    double pos;
+    double speed;
+
+    void move(double u) {
+        const double mag = fabs(u);
+        const double v = (mag > 0.3) ? (6.0 * (mag - 0.3) / 0.7) * ((u > 0.0) ? 1.0 : -1.0) : 0.0;
+        speed += (v - speed) / 100.0;
+        pos += speed / 1000.0;
+    }
+};
+
+// Repeatable uniform integer noise in [-amplitude, amplitude].
+class Noise {
+public:
+    explicit Noise(uint32_t seed = 1)
+        : state_(seed) {}
+
+    int next(int amplitude) {
+        state_ = state_ * 1103515245UL + 12345UL;
+        return (int)((state_ >> 16) % (uint32_t)(2 * amplitude + 1)) - amplitude;
+    }
+
+private:
+    uint32_t state_;
+};
+
+} // namespace TestPlant
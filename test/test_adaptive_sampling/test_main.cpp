@@ -0,0 +1,108 @@
+#include <unity.h>
+
+#include <stdio.h>
+
+#include "sensors/LightSensorPair.h"
+
+// Polled pair on host analog pins, replaying a slow clear-sky trace: the diff
+// creeps by a few counts per minute, with ADC noise and a short tracker move
+// once a minute.
+static const int PIN_A = 33;
+static const int PIN_B = 35;
+static const unsigned long FAST_MS = 3;
+static const unsigned long SLOW_MS = 24;
+
+static LightSensorPair::Config config() {
+    return {PIN_A, PIN_B, FAST_MS, 120, LightSensorPair::WindowMode::Block,
+            LightSensorPair::Estimator::Mean, 20, LightSensorPair::Response::Raw,
+            nullptr, SLOW_MS, 0.5f, 4, false, 0.0f};
+}
+
+static uint32_t noise_state = 1;
+
+static int noise() {
+    noise_state = noise_state * 1103515245UL + 12345UL;
+    return (int)((noise_state >> 16) % 7U) - 3;
+}
+
+static void setLight(unsigned long t_ms, int step) {
+    const int drift = (int)(t_ms / 15000UL); // ~4 counts per minute
+    HostPlatform::analogPins()[PIN_A] = 2000 + drift + step + noise();
+    HostPlatform::analogPins()[PIN_B] = 1900 - drift + noise();
+}
+
+struct Replay {
+    uint32_t reads;
+    uint32_t skipped;
+};
+
+static Replay replay(LightSensorPair& pair, unsigned long duration_ms) {
+    LightSensorPair::Sample sample;
+    for (unsigned long t = 0; t < duration_ms; ++t) {
+        HostPlatform::setMillis(t);
+        setLight(t, 0);
+        pair.setMotorActive((t % 60000UL) < 2000UL);
+        pair.tick(t);
+        pair.consumeSample(sample);
+    }
+    Replay out = {pair.readCount(), pair.readsSkipped()};
+    return out;
+}
+
+void setUp() {
+    noise_state = 1;
+    HostPlatform::setMillis(0);
+}
+void tearDown() {}
+
+static void test_reads_saved_against_fixed_schedule() {
+    static const unsigned long DURATION_MS = 10UL * 60UL * 1000UL;
+    LightSensorPair pair(config());
+    const Replay r = replay(pair, DURATION_MS);
+    const uint32_t fixed = DURATION_MS / FAST_MS;
+    char line[128];
+    snprintf(line, sizeof(line), "10 min replay: %lu reads vs %lu fixed (%.0f %% saved)",
+             (unsigned long)r.reads, (unsigned long)fixed,
+             100.0 * (1.0 - (double)r.reads / (double)fixed));
+    TEST_MESSAGE(line);
+    TEST_ASSERT_LESS_THAN(fixed / 2, r.reads);
+    // Every poll slot is either read or accounted as skipped.
+    TEST_ASSERT_UINT_WITHIN(fixed / 50, fixed, r.reads + r.skipped);
+}
+
+static void test_motor_activity_snaps_back() {
+    LightSensorPair pair(config());
+    replay(pair, 50000);
+    TEST_ASSERT_EQUAL_UINT(SLOW_MS, pair.currentReadIntervalMs());
+    pair.setMotorActive(true);
+    TEST_ASSERT_EQUAL_UINT(FAST_MS, pair.currentReadIntervalMs());
+}
+
+static void test_diff_step_snaps_back() {
+    LightSensorPair pair(config());
+    replay(pair, 50000);
+    TEST_ASSERT_EQUAL_UINT(SLOW_MS, pair.currentReadIntervalMs());
+
+    LightSensorPair::Sample sample;
+    unsigned long t = 50000;
+    for (; t < 50000 + 1000; ++t) {
+        HostPlatform::setMillis(t);
+        setLight(t, 200);
+        pair.tick(t);
+        pair.consumeSample(sample);
+        if (pair.currentReadIntervalMs() == FAST_MS) {
+            break;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT(FAST_MS, pair.currentReadIntervalMs());
+    // Within two of the slowed windows.
+    TEST_ASSERT_LESS_THAN(50000UL + 2UL * 120UL * (SLOW_MS / FAST_MS), t);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_reads_saved_against_fixed_schedule);
+    RUN_TEST(test_motor_activity_snaps_back);
+    RUN_TEST(test_diff_step_snaps_back);
+    return UNITY_END();
+}
@@ -0,0 +1,86 @@
+#include <unity.h>
+
+#include <math.h>
+#include <stdio.h>
+
+#include "drivers/MotorDriver.h"
+#include "drivers/SimulatedPwmOutput.h"
+
+// Forward at 0.5, then reversed: the slack is crossed at takeup_norm for
+// backlash_ms of motor time, then the start torque (kick_norm for
+// kick_duration_ms) meets the load, then the profile carries on.
+static const float TAKEUP = 0.3f;
+static const unsigned long BACKLASH_MS = 200;
+static const float KICK = 0.8f;
+static const unsigned long KICK_MS = 100;
+
+static MotorDriver::Config config(MotorDriver::Profile profile) {
+    return {-1, -1, 20000, 10, 0, 1, 0.8f, 10, KICK, KICK_MS, TAKEUP, BACKLASH_MS,
+            profile, 4.0f, 8.0f, 40.0f};
+}
+
+struct Phases {
+    unsigned long takeup_ms;  // Time spent at -TAKEUP after the reversal
+    unsigned long kick_ms;    // Time spent at -KICK right after it
+};
+
+static Phases reverse(MotorDriver::Profile profile) {
+    SimulatedPwmOutput output(false);
+    MotorDriver motor(config(profile), &output);
+    motor.begin();
+    unsigned long now = 1000;
+    motor.setTargetNormalized(0.5f);
+    for (; now < 3000; now += 10) {
+        motor.tick(now);
+    }
+
+    motor.setTargetNormalized(-0.5f);
+    Phases p = {0, 0};
+    bool kick_seen = false;
+    for (; now < 4000; now += 10) {
+        motor.tick(now);
+        const float applied = motor.getAppliedNorm();
+        if (fabsf(applied + TAKEUP) < 0.001f && !kick_seen) {
+            p.takeup_ms += 10;
+        } else if (fabsf(applied + KICK) < 0.001f && p.takeup_ms > 0) {
+            kick_seen = true;
+            p.kick_ms += 10;
+        }
+    }
+    return p;
+}
+
+static void check(const char* label, MotorDriver::Profile profile) {
+    const Phases p = reverse(profile);
+    char line[96];
+    snprintf(line, sizeof(line), "%s: take-up %lu ms, start torque %lu ms",
+             label, p.takeup_ms, p.kick_ms);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_UINT_WITHIN(10, BACKLASH_MS, p.takeup_ms);
+    TEST_ASSERT_UINT_WITHIN(10, KICK_MS, p.kick_ms);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_exponential_kicks_after_takeup() {
+    check("exponential", MotorDriver::Profile::Exponential);
+}
+
+// The take-up leaves the duty at takeup_norm rather than at standstill, so
+// the profiles never saw a start and skipped the start torque.
+static void test_trapezoidal_kicks_after_takeup() {
+    check("trapezoidal", MotorDriver::Profile::Trapezoidal);
+}
+
+static void test_scurve_kicks_after_takeup() {
+    check("scurve", MotorDriver::Profile::SCurve);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_exponential_kicks_after_takeup);
+    RUN_TEST(test_trapezoidal_kicks_after_takeup);
+    RUN_TEST(test_scurve_kicks_after_takeup);
+    return UNITY_END();
+}
@@ -0,0 +1,91 @@
+#include <unity.h>
+
+#include <math.h>
+#include <stdio.h>
+
+#include "track/DriftFit.h"
+
+// The coordinator adds every new diff while the axes hold still: in Sliding
+// mode that is every 3 ms read, for holds of many minutes.
+static uint32_t noise_state = 1;
+
+static float noise(float amplitude) {
+    noise_state = noise_state * 1103515245UL + 12345UL;
+    return amplitude * ((float)((noise_state >> 8) % 2001U) / 1000.0f - 1.0f);
+}
+
+struct Trace {
+    float slope_1;      // %/s for the first part
+    float slope_2;      // %/s after switch_s
+    float switch_s;
+    float noise;
+};
+
+// Feeds `seconds` of a piecewise-linear diff every `step_ms`.
+static void feed(DriftFit& fit, const Trace& trace, unsigned long step_ms, float seconds) {
+    uint32_t count = 0;
+    float diff = 0.0f;
+    for (unsigned long ms = 1000; ms <= 1000 + (unsigned long)(seconds * 1000.0f); ms += step_ms) {
+        const float t = (float)(ms - 1000) / 1000.0f;
+        diff += ((t < trace.switch_s) ? trace.slope_1 : trace.slope_2) * (float)step_ms / 1000.0f;
+        fit.add(++count, diff + noise(trace.noise), ms);
+    }
+}
+
+void setUp() { noise_state = 1; }
+void tearDown() {}
+
+// Ten minutes of 3 ms reads is 200000 samples; a 16-bit count wrapped after
+// 3.3 minutes and restarted the clock under the old sums.
+static void test_long_sliding_hold_keeps_the_slope() {
+    DriftFit fit;
+    const Trace trace = {0.002f, 0.002f, 0.0f, 0.3f};
+    feed(fit, trace, 3, 600.0f);
+    TEST_ASSERT_GREATER_THAN(65536U, fit.samples());
+    TEST_ASSERT_TRUE(fit.valid(1.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.0002f, 0.002f, fit.slope());
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 1.2f, fit.value());
+}
+
+// A drift that changes mid-hold is followed within a few memory constants,
+// instead of being averaged with the old one for the rest of the hold.
+static void test_forgets_an_old_drift() {
+    DriftFit fit;
+    const Trace trace = {0.01f, -0.004f, 300.0f, 0.3f};
+    feed(fit, trace, 120, 300.0f + 4.0f * DriftFit::DEFAULT_MEMORY_S);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, -0.004f, fit.slope());
+}
+
+// The reported standard error describes the scatter of the slope over
+// independent runs.
+static void test_slope_std_err_matches_scatter() {
+    const Trace trace = {0.005f, 0.005f, 0.0f, 0.5f};
+    static const int RUNS = 40;
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    double se_sum = 0.0;
+    for (int i = 0; i < RUNS; ++i) {
+        DriftFit fit;
+        feed(fit, trace, 120, 600.0f);
+        sum += fit.slope();
+        sum_sq += (double)fit.slope() * fit.slope();
+        se_sum += fit.slopeStdErr();
+    }
+    const double mean = sum / RUNS;
+    const double scatter = sqrt(max(0.0, (sum_sq / RUNS) - (mean * mean)));
+    const double se = se_sum / RUNS;
+    char line[96];
+    snprintf(line, sizeof(line), "slope scatter %.2e %%/s, reported std err %.2e %%/s",
+             scatter, se);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_FLOAT_WITHIN(0.0005f, 0.005f, (float)mean);
+    TEST_ASSERT_FLOAT_WITHIN(0.5 * scatter, scatter, se);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_long_sliding_hold_keeps_the_slope);
+    RUN_TEST(test_forgets_an_old_drift);
+    RUN_TEST(test_slope_std_err_matches_scatter);
+    return UNITY_END();
+}
@@ -0,0 +1,78 @@
+#include <unity.h>
+
+#include <stdio.h>
+
+#include "../TestPlant.h"
+
+// Balanced light, so every window sits inside the deadband and only the
+// feedforward drives: 0.05 deg/s expected against 0.5 deg/s at pwm_min should
+// keep the motor on for a tenth of the time, whatever the window mode.
+static const int PIN_A = 33;
+static const int PIN_B = 35;
+static const unsigned long DURATION_MS = 60000;
+static const float FF_AT_MIN = 0.5f;
+static const float SUN_DEG_PER_S = 0.05f;
+
+struct Result {
+    uint32_t motor_on_ms;
+    uint32_t pulses;
+};
+
+static Result run(LightSensorPair::WindowMode mode) {
+    HostPlatform::setMillis(0);
+    HostPlatform::analogPins()[PIN_A] = 2000;
+    HostPlatform::analogPins()[PIN_B] = 2000;
+    TrackerController::Config tracker_cfg = TestPlant::trackerConfig();
+    tracker_cfg.ff_deg_per_s_at_min = FF_AT_MIN;
+
+    LightSensorPair sensors(TestPlant::sensorConfig(PIN_A, PIN_B, mode));
+    // No smoothing, so motor-on time is the commanded time plus the kick.
+    MotorDriver motor(TestPlant::motorConfig(0.0f, 0.8f, 200));
+    TrackerController tracker(tracker_cfg, sensors, motor);
+    motor.begin();
+    tracker.setFeedforwardRate(SUN_DEG_PER_S);
+
+    for (unsigned long ms = 1; ms <= DURATION_MS; ++ms) {
+        HostPlatform::setMillis(ms);
+        sensors.tick(ms);
+        tracker.tick(ms);
+        motor.tick(ms);
+    }
+    Result r = {motor.motorOnMs(), tracker.feedforwardPulses()};
+    return r;
+}
+
+static void report(const char* label, const Result& r) {
+    char line[128];
+    snprintf(line, sizeof(line), "%s: %lu pulses, motor on %lu ms of %lu",
+             label, (unsigned long)r.pulses, (unsigned long)r.motor_on_ms, DURATION_MS);
+    TEST_MESSAGE(line);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_block_pulse_duty() {
+    const Result r = run(LightSensorPair::WindowMode::Block);
+    report("block", r);
+    TEST_ASSERT_UINT_WITHIN(5, 50, r.pulses);
+    TEST_ASSERT_UINT_WITHIN(1200, 6000, r.motor_on_ms);
+}
+
+// Sliding emits on every read. Stepped per read, the sigma-delta fired every
+// few reads and each one-read pulse started a 200 ms kick: the motor ran
+// nearly all the time.
+static void test_sliding_pulses_once_per_window() {
+    const Result block = run(LightSensorPair::WindowMode::Block);
+    const Result sliding = run(LightSensorPair::WindowMode::Sliding);
+    report("sliding", sliding);
+    TEST_ASSERT_UINT_WITHIN(5, block.pulses, sliding.pulses);
+    TEST_ASSERT_UINT_WITHIN(1200, block.motor_on_ms, sliding.motor_on_ms);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_block_pulse_duty);
+    RUN_TEST(test_sliding_pulses_once_per_window);
+    return UNITY_END();
+}
@@ -0,0 +1,243 @@
+#include <unity.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "drivers/MotorDriver.h"
+#include "drivers/SimulatedPwmOutput.h"
+#include "sensors/LdrResponse.h"
+#include "sensors/LightSensorPair.h"
+#include "sensors/SyntheticSampleSource.h"
+#include "track/HuntingDetector.h"
+#include "util/FixedPoint.h"
+
+// Run under both native envs: each checks its own build of the control path
+// against a float reference computed here, so the Q15 build (native_fixed)
+// is held to the float results within a few LSB.
+typedef LdrResponse::Tables<3300, 700> Tables;
+
+static const float LSB = Q15::PERCENT_PER_LSB;
+
+static uint32_t rng_state = 1;
+
+static uint32_t nextRandom() {
+    rng_state = rng_state * 1103515245UL + 12345UL;
+    return rng_state >> 8;
+}
+
+static uint16_t randomCount(uint16_t lo, uint16_t hi) {
+    return (uint16_t)(lo + (nextRandom() % (uint32_t)(hi - lo)));
+}
+
+void setUp() {
+    rng_state = 1;
+    HostPlatform::setMillis(0);
+}
+void tearDown() {}
+
+static void test_q15_primitives_match_float() {
+    for (int i = 0; i < 20000; ++i) {
+        const int32_t den = (int32_t)(nextRandom() % 200000U) + 1;
+        const int32_t num = (int32_t)(nextRandom() % (uint32_t)den) - (den / 2);
+        TEST_ASSERT_FLOAT_WITHIN(1.0f, (double)num * Q15::ONE / den, Q15::ratio(num, den));
+
+        const int32_t a = (int32_t)(nextRandom() % 65535U) - Q15::MAX;
+        const int32_t b = (int32_t)(nextRandom() % 65535U) - Q15::MAX;
+        TEST_ASSERT_FLOAT_WITHIN(1.0f, (double)a * b / Q15::ONE, Q15::mul(a, b));
+    }
+}
+
+struct Window {
+    double sum_a;
+    double sum_b;
+    unsigned n;
+};
+
+// Float reference of the window diff in the configured domain.
+static float referenceDiff(const Window& w, LightSensorPair::Response response) {
+    if (response == LightSensorPair::Response::Log) {
+        const double diff = ((w.sum_a - w.sum_b) / w.n / LdrResponse::LOG_SCALE) * 50.0;
+        return (float)constrain(diff, -100.0, 100.0);
+    }
+    return (float)(100.0 * (w.sum_a - w.sum_b) / (w.sum_a + w.sum_b));
+}
+
+// Block windows of random light, every diff against the float reference.
+// Counts windows that did not complete or whose Q15 and float diffs disagree.
+static float worstBlockError(LightSensorPair::Response response,
+                             const uint16_t* table,
+                             unsigned* bad) {
+    SyntheticSampleSource<64> source(1000);
+    const LightSensorPair::Config cfg = {
+        0, 1, 3, 40, LightSensorPair::WindowMode::Block, LightSensorPair::Estimator::Mean,
+        20, response, table, 0, 0.0f, 0, false, 0.0f};
+    LightSensorPair pair(cfg, &source);
+    LightSensorPair::Sample sample;
+    float worst = 0.0f;
+    for (int window = 0; window < 500; ++window) {
+        const uint16_t base_a = randomCount(200, 3800);
+        const uint16_t base_b = randomCount(200, 3800);
+        Window w = {0.0, 0.0, 0};
+        for (int i = 0; i < 40; ++i) {
+            const uint16_t a = (uint16_t)(base_a + (nextRandom() % 64U));
+            const uint16_t b = (uint16_t)(base_b + (nextRandom() % 64U));
+            w.sum_a += (table != nullptr) ? table[a] : a;
+            w.sum_b += (table != nullptr) ? table[b] : b;
+            w.n++;
+            source.push(a, b);
+        }
+        pair.tick(0);
+        if (!pair.consumeSample(sample) || !sample.window_complete ||
+            abs(Q15::fromPercent(sample.diff_percent) - sample.diff_q15) > 1) {
+            (*bad)++;
+            continue;
+        }
+        worst = max(worst, fabsf(sample.diff_percent - referenceDiff(w, response)));
+    }
+    return worst;
+}
+
+static void test_raw_diff_matches_float() {
+    unsigned bad = 0;
+    const float worst = worstBlockError(LightSensorPair::Response::Raw, nullptr, &bad);
+    TEST_ASSERT_EQUAL_UINT(0, bad);
+    TEST_ASSERT_LESS_OR_EQUAL(2.0f * LSB, worst);
+}
+
+static void test_log_diff_matches_float() {
+    unsigned bad = 0;
+    const float worst = worstBlockError(LightSensorPair::Response::Log, Tables::LOG, &bad);
+    TEST_ASSERT_EQUAL_UINT(0, bad);
+    TEST_ASSERT_LESS_OR_EQUAL(2.0f * LSB, worst);
+}
+
+// Every Sliding emission, partial windows included.
+static void test_sliding_diff_matches_float() {
+    static const unsigned WINDOW = 40;
+    SyntheticSampleSource<64> source(1000);
+    const LightSensorPair::Config cfg = {
+        0, 1, 3, WINDOW, LightSensorPair::WindowMode::Sliding,
+        LightSensorPair::Estimator::Mean, 20, LightSensorPair::Response::Raw, nullptr,
+        0, 0.0f, 0, false, 0.0f};
+    LightSensorPair pair(cfg, &source);
+    LightSensorPair::Sample sample;
+    uint16_t hist_a[2000];
+    uint16_t hist_b[2000];
+    float worst = 0.0f;
+    for (unsigned i = 0; i < 2000; ++i) {
+        hist_a[i] = randomCount(1000, 3000);
+        hist_b[i] = randomCount(1000, 3000);
+        source.push(hist_a[i], hist_b[i]);
+        pair.tick(0);
+        TEST_ASSERT_TRUE(pair.consumeSample(sample));
+        Window w = {0.0, 0.0, 0};
+        for (unsigned k = (i + 1 > WINDOW) ? (i + 1 - WINDOW) : 0; k <= i; ++k) {
+            w.sum_a += hist_a[k];
+            w.sum_b += hist_b[k];
+            w.n++;
+        }
+        TEST_ASSERT_EQUAL_UINT(w.n, sample.sample_count);
+        const float ref = referenceDiff(w, LightSensorPair::Response::Raw);
+        worst = max(worst, fabsf(sample.diff_percent - ref));
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(2.0f * LSB, worst);
+}
+
+// IIR smoothing and the duty integral against the float recurrence.
+static void test_motor_filter_matches_float() {
+    static const float SMOOTH = 0.8f;
+    const MotorDriver::Config cfg = {
+        -1, -1, 20000, 10, 0, 1, SMOOTH, 10, 0.0f, 0, 0.0f, 0,
+        MotorDriver::Profile::Exponential, 0.0f, 0.0f, 0.0f};
+    SimulatedPwmOutput output(false);
+    MotorDriver motor(cfg, &output);
+    motor.begin();
+
+    float ref = 0.0f;
+    double ref_duty_ms = 0.0;
+    float worst = 0.0f;
+    const float targets[4] = {0.6f, -0.35f, 0.9f, 0.0f};
+    unsigned long now = 1000;
+    for (int step = 0; step < 4; ++step) {
+        motor.setTargetNormalized(targets[step]);
+        for (int i = 0; i < 100; ++i, now += 10) {
+            const float applied_before = ref;
+            motor.tick(now);
+            if (now > 1000) {
+                ref_duty_ms += 10.0 * fabsf(applied_before);
+            }
+            ref += (targets[step] - ref) * (1.0f - SMOOTH);
+            worst = max(worst, fabsf(motor.getAppliedNorm() - ref));
+        }
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(4.0f / Q15::ONE, worst);
+    TEST_ASSERT_INT_WITHIN(2, (int)ref_duty_ms, (int)motor.motorDutyMs());
+}
+
+// Trapezoidal ramp (Q15 per second in the fixed build) against the float
+// recurrence, including a reversal through standstill.
+static void test_motor_profile_matches_float() {
+    static const float ACCEL = 2.0f;
+    static const float DECEL = 5.0f;
+    const MotorDriver::Config cfg = {
+        -1, -1, 20000, 10, 0, 1, 0.8f, 10, 0.0f, 0, 0.0f, 0,
+        MotorDriver::Profile::Trapezoidal, ACCEL, DECEL, 0.0f};
+    SimulatedPwmOutput output(false);
+    MotorDriver motor(cfg, &output);
+    motor.begin();
+
+    float ref = 0.0f;
+    float worst = 0.0f;
+    const float targets[4] = {0.6f, 0.2f, -0.5f, 0.0f};
+    unsigned long now = 1000;
+    motor.tick(now);
+    for (int step = 0; step < 4; ++step) {
+        const float target = targets[step];
+        motor.setTargetNormalized(target);
+        for (int i = 0; i < 60; ++i) {
+            now += 10;
+            motor.tick(now);
+            const float goal = (ref * target < 0.0f) ? 0.0f : target;
+            const bool growing = (ref == 0.0f) || ((ref > 0.0f) == (target > ref));
+            const float move = (growing ? ACCEL : DECEL) * 0.01f;
+            ref = (goal > ref) ? min(ref + move, goal) : max(ref - move, goal);
+            worst = max(worst, fabsf(motor.getAppliedNorm() - ref));
+        }
+    }
+    // Each update's step rounds to an LSB, under half an LSB per update
+    // over a 30-update ramp.
+    TEST_ASSERT_LESS_OR_EQUAL(15.0f / Q15::ONE, worst);
+}
+
+// Boost steps and linear decay of the integer detector against float math.
+static void test_hunting_boost_matches_float() {
+    const HuntingDetector::Config cfg = {true, 2000, 4, 0.5f, 5.0f, 0.02f};
+    HuntingDetector hunting(cfg);
+    // Reversals every 100 ms from 1100 ms: events at 1400 and 1800 ms.
+    for (int i = 0; i <= 8; ++i) {
+        const int32_t target = (i & 1) ? -Q15::fromFloat(0.4f) : Q15::fromFloat(0.4f);
+        hunting.update(target, 0, 1000UL + 100UL * (unsigned long)i);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, hunting.events());
+    TEST_ASSERT_FLOAT_WITHIN(LSB, 0.5f - (0.02f * 0.4f) + 0.5f, hunting.boostPercent());
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.4f, hunting.amplitude());
+
+    // 20 s of idle outputs at 50 ms.
+    for (unsigned long now = 1850; now <= 21800; now += 50) {
+        hunting.update(0, 0, now);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(2.0f * LSB, 0.992f - (0.02f * 20.0f), hunting.boostPercent());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_q15_primitives_match_float);
+    RUN_TEST(test_raw_diff_matches_float);
+    RUN_TEST(test_log_diff_matches_float);
+    RUN_TEST(test_sliding_diff_matches_float);
+    RUN_TEST(test_motor_filter_matches_float);
+    RUN_TEST(test_motor_profile_matches_float);
+    RUN_TEST(test_hunting_boost_matches_float);
+    return UNITY_END();
+}
@@ -0,0 +1,108 @@
+#include <unity.h>
+
+#include <math.h>
+#include <stdio.h>
+
+#include "sensors/LightSensorPair.h"
+
+// Lamp light on a polled pair: DC levels 2000 / 1800 with mains ripple whose
+// depth differs per LDR (their response times differ), read every 3 ms so
+// the ripple aliases into the window mean.
+static const int PIN_A = 33;
+static const int PIN_B = 35;
+static const float DC_A = 2000.0f;
+static const float DC_B = 1800.0f;
+static const float DEPTH_A = 0.15f;
+static const float DEPTH_B = 0.05f;
+
+static LightSensorPair::Config config(unsigned long action_ms, bool rejection) {
+    return {PIN_A, PIN_B, 3, action_ms, LightSensorPair::WindowMode::Block,
+            LightSensorPair::Estimator::Mean, 20, LightSensorPair::Response::Raw,
+            nullptr, 0, 0.0f, 0, rejection, 0.01f};
+}
+
+static float truthDiff() {
+    return 100.0f * (DC_A - DC_B) / (DC_A + DC_B);
+}
+
+struct Run {
+    float worst_error;
+    uint8_t flicker_hz;
+    unsigned windows;
+};
+
+static Run run(unsigned long action_ms, bool rejection, float ripple_hz) {
+    LightSensorPair pair(config(action_ms, rejection));
+    LightSensorPair::Sample sample;
+    Run out = {0.0f, 0, 0};
+    // Start the lamp at an arbitrary phase against the read clock.
+    const float phase = 0.7f;
+    for (unsigned long t = 0; t < 5000; ++t) {
+        HostPlatform::setMillis(t);
+        const float ripple = (ripple_hz > 0.0f)
+            ? sinf(6.28318531f * ripple_hz * (float)t * 1.0e-3f + phase)
+            : 0.0f;
+        HostPlatform::analogPins()[PIN_A] = (int)lroundf(DC_A * (1.0f + DEPTH_A * ripple));
+        HostPlatform::analogPins()[PIN_B] = (int)lroundf(DC_B * (1.0f + DEPTH_B * ripple));
+        pair.tick(t);
+        if (pair.consumeSample(sample) && sample.window_complete) {
+            out.worst_error = max(out.worst_error, fabsf(sample.diff_percent - truthDiff()));
+            out.flicker_hz = sample.flicker_hz;
+            out.windows++;
+        }
+    }
+    return out;
+}
+
+void setUp() { HostPlatform::setMillis(0); }
+void tearDown() {}
+
+static void report(const char* label, const Run& plain, const Run& fitted) {
+    char line[128];
+    snprintf(line, sizeof(line), "%s: worst diff error %.3f %% plain, %.3f %% fitted",
+             label, plain.worst_error, fitted.worst_error);
+    TEST_MESSAGE(line);
+}
+
+static void test_detects_and_removes_100hz() {
+    const Run plain = run(100, false, 100.0f);
+    const Run fitted = run(100, true, 100.0f);
+    report("100 Hz, 100 ms window", plain, fitted);
+    TEST_ASSERT_EQUAL_UINT8(100, fitted.flicker_hz);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.05f, fitted.worst_error);
+    TEST_ASSERT_LESS_THAN_FLOAT(plain.worst_error / 5.0f, fitted.worst_error);
+}
+
+static void test_detects_and_removes_120hz() {
+    const Run plain = run(100, false, 120.0f);
+    const Run fitted = run(100, true, 120.0f);
+    report("120 Hz, 100 ms window", plain, fitted);
+    TEST_ASSERT_EQUAL_UINT8(120, fitted.flicker_hz);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.05f, fitted.worst_error);
+    TEST_ASSERT_LESS_THAN_FLOAT(plain.worst_error / 5.0f, fitted.worst_error);
+}
+
+// A 36 ms window (12 reads) with the fit is steadier than the plain mean.
+static void test_short_window_stays_stable() {
+    const Run plain = run(36, false, 100.0f);
+    const Run fitted = run(36, true, 100.0f);
+    report("100 Hz, 36 ms window", plain, fitted);
+    TEST_ASSERT_GREATER_THAN(100U, fitted.windows);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.05f, fitted.worst_error);
+    TEST_ASSERT_LESS_THAN_FLOAT(plain.worst_error, fitted.worst_error);
+}
+
+static void test_steady_light_left_alone() {
+    const Run fitted = run(100, true, 0.0f);
+    TEST_ASSERT_EQUAL_UINT8(0, fitted.flicker_hz);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.01f, fitted.worst_error);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_detects_and_removes_100hz);
+    RUN_TEST(test_detects_and_removes_120hz);
+    RUN_TEST(test_short_window_stays_stable);
+    RUN_TEST(test_steady_light_left_alone);
+    return UNITY_END();
+}
@@ -0,0 +1,101 @@
+#include <unity.h>
+
+#include <stdio.h>
+
+#include "track/HuntingDetector.h"
+
+// The detector on its own, fed controller outputs directly: four reversals
+// within a second is hunting, each event adds 0.5 % up to 2 %, and the boost
+// bleeds off at 0.1 %/s.
+static const HuntingDetector::Config CFG = {true, 1000, 4, 0.5f, 2.0f, 0.1f};
+static const int32_t TARGET_Q15 = Q15::fromFloat(0.5f);
+// A few Q15 steps of the percent scale.
+static const float TOLERANCE = 0.01f;
+
+// `count` outputs of alternating sign, one every period_ms from start_ms.
+// Returns the time of the last one.
+static unsigned long alternate(HuntingDetector& hunting, unsigned count,
+                               unsigned long start_ms, unsigned long period_ms) {
+    unsigned long now = start_ms;
+    for (unsigned i = 0; i < count; ++i) {
+        now = start_ms + (i * period_ms);
+        hunting.update((i & 1) ? -TARGET_Q15 : TARGET_Q15, 0, now);
+    }
+    return now;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// The first output only sets the sign; the fourth reversal 300 ms after the
+// first raises the boost by one step, the third does not.
+static void test_boost_rises_after_min_reversals() {
+    HuntingDetector hunting(CFG);
+    alternate(hunting, 4, 1000, 100);
+    TEST_ASSERT_EQUAL_UINT32(3, hunting.reversals());
+    TEST_ASSERT_EQUAL_UINT32(0, hunting.events());
+    TEST_ASSERT_FALSE(hunting.isBoosted());
+
+    hunting.update(TARGET_Q15, 0, 1400);
+    TEST_ASSERT_EQUAL_UINT32(1, hunting.events());
+    TEST_ASSERT_FLOAT_WITHIN(TOLERANCE, CFG.boost_step_percent, hunting.boostPercent());
+}
+
+// Reversals 400 ms apart put four of them 1.2 s apart: never hunting.
+static void test_slow_reversals_outside_window() {
+    HuntingDetector hunting(CFG);
+    alternate(hunting, 40, 1000, 400);
+    TEST_ASSERT_EQUAL_UINT32(39, hunting.reversals());
+    TEST_ASSERT_EQUAL_UINT32(0, hunting.events());
+    TEST_ASSERT_FALSE(hunting.isBoosted());
+}
+
+// An event every 400 ms for 40 s: the boost reaches the cap on the fifth and
+// stays there, less the 0.04 % that decays between events.
+static void test_boost_capped_at_max() {
+    HuntingDetector hunting(CFG);
+    float peak = 0.0f;
+    for (unsigned i = 0; i < 401; ++i) {
+        hunting.update((i & 1) ? -TARGET_Q15 : TARGET_Q15, 0, 1000 + (i * 100));
+        peak = max(peak, hunting.boostPercent());
+    }
+    char line[64];
+    snprintf(line, sizeof(line), "%u events, peak boost %.3f %%",
+             (unsigned)hunting.events(), peak);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_EQUAL_UINT32(100, hunting.events());
+    TEST_ASSERT_FLOAT_WITHIN(TOLERANCE, CFG.max_boost_percent, peak);
+    TEST_ASSERT_FLOAT_WITHIN(0.04f + TOLERANCE, CFG.max_boost_percent, hunting.boostPercent());
+}
+
+// Once the axis settles the boost falls at decay_percent_per_s, whether or
+// not the controller drives, and is gone after max / rate seconds.
+static void test_boost_decays_at_configured_rate() {
+    HuntingDetector hunting(CFG);
+    const unsigned long end = alternate(hunting, 21, 1000, 100);
+    TEST_ASSERT_FLOAT_WITHIN(TOLERANCE, CFG.max_boost_percent, hunting.boostPercent());
+    const float start = hunting.boostPercent();
+
+    for (unsigned long now = end + 100; now <= end + 10000; now += 100) {
+        hunting.update(((now / 100) % 20) < 10 ? TARGET_Q15 : 0, 0, now);
+    }
+    const float rate = (start - hunting.boostPercent()) / 10.0f;
+    char line[64];
+    snprintf(line, sizeof(line), "decay %.4f %%/s (configured %.4f)",
+             rate, CFG.decay_percent_per_s);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_FLOAT_WITHIN(TOLERANCE / 10.0f, CFG.decay_percent_per_s, rate);
+
+    hunting.update(0, 0, end + 21000);
+    TEST_ASSERT_FALSE(hunting.isBoosted());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, hunting.boostPercent());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_boost_rises_after_min_reversals);
+    RUN_TEST(test_slow_reversals_outside_window);
+    RUN_TEST(test_boost_capped_at_max);
+    RUN_TEST(test_boost_decays_at_configured_rate);
+    return UNITY_END();
+}
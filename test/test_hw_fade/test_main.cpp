@@ -0,0 +1,168 @@
+#include <unity.h>
+
+#include <chrono>
+#include <stdio.h>
+
+#include "drivers/MotorDriver.h"
+#include "drivers/SimulatedPwmOutput.h"
+
+// smooth 0.85 at 30 ms updates is tau = 185 ms: a 0 -> 0.8 step is a 554 ms
+// fade, and anything the driver writes inside it meets a running fade.
+static const unsigned long UPDATE_MS = 30;
+
+static MotorDriver::Config config() {
+    return {25, 26, 20000, 10, 0, 1, 0.85f, UPDATE_MS, 0.0f, 0, 0.0f, 0,
+            MotorDriver::Profile::Exponential, 2.0f, 20.0f, 400.0f};
+}
+
+static uint32_t rng_state = 1;
+
+static float uniform() {
+    rng_state = rng_state * 1103515245UL + 12345UL;
+    return (float)((rng_state >> 8) % 10001U) / 10000.0f;
+}
+
+void setUp() {
+    HostPlatform::setMillis(1000);
+    rng_state = 1;
+}
+void tearDown() {}
+
+// How long the call made 100 ms into the step took, and when the drive
+// input reached zero after it (0: not within 2 s).
+struct Step {
+    unsigned long call_ms;
+    unsigned long zero_ms;
+};
+
+static Step stallAfterStep(bool holds_calls, bool disable) {
+    SimulatedPwmOutput output(true, holds_calls);
+    MotorDriver motor(config(), &output);
+    motor.begin();
+    motor.setTargetNormalized(0.8f);
+    motor.tick(millis());
+    HostPlatform::advanceMicros(100000UL);
+    const unsigned long start_ms = millis();
+    if (disable) {
+        motor.setEnabled(false);
+    } else {
+        motor.setTargetNormalized(-0.8f);
+        motor.tick(millis());
+    }
+    Step r = {millis() - start_ms, 0};
+    for (unsigned long now = millis(); now < start_ms + 2000; ++now) {
+        HostPlatform::setMillis(now);
+        motor.tick(now);
+        if (output.duty(0) == 0) {
+            r.zero_ms = now - start_ms;
+            break;
+        }
+    }
+    return r;
+}
+
+// A call during the fade waits for it on IDF 4.4; held, it returns at once
+// and lands when the fade ends (the 554 ms step fade started 100 ms earlier).
+static void test_calls_during_a_fade_do_not_block() {
+    const Step disable_wait = stallAfterStep(false, true);
+    const Step reverse_wait = stallAfterStep(false, false);
+    const Step disable_held = stallAfterStep(true, true);
+    const Step reverse_held = stallAfterStep(true, false);
+    char line[128];
+    snprintf(line, sizeof(line),
+             "waiting: disable %lu ms, reversal %lu ms; held: returns at once, zero at %lu ms",
+             disable_wait.call_ms, reverse_wait.call_ms, disable_held.zero_ms);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_GREATER_THAN(400UL, disable_wait.call_ms);
+    TEST_ASSERT_GREATER_THAN(400UL, reverse_wait.call_ms);
+
+    TEST_ASSERT_EQUAL_UINT32(0, disable_held.call_ms);
+    TEST_ASSERT_EQUAL_UINT32(0, reverse_held.call_ms);
+    TEST_ASSERT_UINT32_WITHIN(10, 454, disable_held.zero_ms);
+    TEST_ASSERT_GREATER_THAN(0UL, reverse_held.zero_ms);
+}
+
+struct Run {
+    double motion_s;
+    double calls_per_s;
+    double loop_us_per_s;
+    double blocked_ms_per_s;
+    uint32_t both_driven_ms;
+};
+
+// Ten minutes of loop() at 1 ms with a new target every 0.1-3 s, a third of
+// them stops.
+static Run run(bool has_fade, bool holds_calls) {
+    SimulatedPwmOutput output(has_fade, holds_calls);
+    MotorDriver motor(config(), &output);
+    motor.begin();
+    const unsigned long end_ms = millis() + 600000UL;
+    std::chrono::steady_clock::duration loop_time(0);
+    Run r = {0.0, 0.0, 0.0, 0.0, 0};
+    unsigned long next_target_ms = 0;
+    while (millis() < end_ms) {
+        const unsigned long now = millis();
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (now >= next_target_ms) {
+            const float mag = 0.3f + (0.7f * uniform());
+            const float pick = uniform();
+            motor.setTargetNormalized((pick < 0.33f) ? 0.0f : (pick < 0.67f) ? mag : -mag);
+            next_target_ms = now + 100 + (unsigned long)(2900.0f * uniform());
+        }
+        motor.tick(now);
+        loop_time += std::chrono::steady_clock::now() - start;
+        if (output.duty(0) > 0 && output.duty(1) > 0) {
+            r.both_driven_ms++;
+        }
+        HostPlatform::advanceMicros(1000);
+    }
+    r.motion_s = (double)motor.motorOnMs() / 1000.0;
+    r.calls_per_s = (double)motor.outputWrites() / r.motion_s;
+    r.loop_us_per_s =
+        (double)std::chrono::duration_cast<std::chrono::nanoseconds>(loop_time).count() /
+        1000.0 / r.motion_s;
+    r.blocked_ms_per_s = (double)output.blockedMs() / r.motion_s;
+    return r;
+}
+
+static void report(const char* label, const Run& r) {
+    char line[160];
+    snprintf(line, sizeof(line),
+             "%s: %.0f s moving, %.1f peripheral calls/s, loop() %.1f us/s on host, "
+             "%.0f ms/s blocked, both inputs driven %lu ms",
+             label, r.motion_s, r.calls_per_s, r.loop_us_per_s, r.blocked_ms_per_s,
+             (unsigned long)r.both_driven_ms);
+    TEST_MESSAGE(line);
+}
+
+// Per second of motion: peripheral calls, host time in loop() (the output's
+// calls are simulated, so this is the driver's own work) and time blocked
+// in the IDF calls; software ramp against the fade engine.
+static void test_peripheral_calls_per_second_of_motion() {
+    const Run software = run(false, true);
+    rng_state = 1;
+    HostPlatform::setMillis(1000);
+    const Run held = run(true, true);
+    rng_state = 1;
+    HostPlatform::setMillis(1000);
+    const Run waiting = run(true, false);
+    report("software ramp", software);
+    report("fade, held", held);
+    report("fade, waited", waiting);
+    char line[96];
+    snprintf(line, sizeof(line), "fade engine per second of motion: %.1f fewer peripheral calls",
+             software.calls_per_s - held.calls_per_s);
+    TEST_MESSAGE(line);
+
+    TEST_ASSERT_LESS_THAN_FLOAT((float)(software.calls_per_s / 10.0), (float)held.calls_per_s);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, (float)held.blocked_ms_per_s);
+    TEST_ASSERT_EQUAL_UINT32(0, held.both_driven_ms);
+    TEST_ASSERT_GREATER_THAN_FLOAT(10.0f, (float)waiting.blocked_ms_per_s);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_calls_during_a_fade_do_not_block);
+    RUN_TEST(test_peripheral_calls_per_second_of_motion);
+    return UNITY_END();
+}
@@ -0,0 +1,92 @@
+#include <unity.h>
+
+#include <math.h>
+#include <stdio.h>
+
+#include "../TestPlant.h"
+
+// A parked axis (deadband far above the offset) looking at a fixed 2.5 %
+// diff with +-20 counts of ADC noise per read. The Kalman sigma should
+// describe its real error the same way in Block and Sliding mode.
+static const int PIN_A = 33;
+static const int PIN_B = 35;
+static const int NOISE_COUNTS = 20;
+static const float TRUE_DIFF = 100.0f * (2050.0f - 1950.0f) / 4000.0f;
+
+static TrackerController::Config trackerConfig() {
+    TrackerController::Config cfg = TestPlant::trackerConfig();
+    cfg.diff_deadband = 50.0f;
+    cfg.diff_pwm_threshold = 60.0f;
+    cfg.kalman_enabled = true;
+    cfg.kalman = {8.0f, 0.01f, 0.0001f, 0.0f};
+    cfg.kalman_r_min = 0.000001f;
+    return cfg;
+}
+
+struct Result {
+    float sigma;       // Reported offset sigma at the end
+    float rms_error;   // Measured offset error over the second half
+};
+
+static Result run(LightSensorPair::WindowMode mode) {
+    TestPlant::Noise noise;
+    HostPlatform::setMillis(0);
+    LightSensorPair sensors(TestPlant::sensorConfig(PIN_A, PIN_B, mode));
+    MotorDriver motor(TestPlant::motorConfig(0.0f, 0.0f, 0));
+    TrackerController tracker(trackerConfig(), sensors, motor);
+    motor.begin();
+
+    double sum_sq = 0.0;
+    unsigned windows = 0;
+    for (unsigned long ms = 1; ms <= 120000; ++ms) {
+        HostPlatform::setMillis(ms);
+        HostPlatform::analogPins()[PIN_A] = 2050 + noise.next(NOISE_COUNTS);
+        HostPlatform::analogPins()[PIN_B] = 1950 + noise.next(NOISE_COUNTS);
+        sensors.tick(ms);
+        tracker.tick(ms);
+        motor.tick(ms);
+        if (tracker.hasNewSample()) {
+            tracker.clearNewSample();
+            if (ms > 60000 && tracker.lastSample().window_complete) {
+                const double e = tracker.kalman().offset() - TRUE_DIFF;
+                sum_sq += e * e;
+                windows++;
+            }
+        }
+    }
+    Result r = {tracker.kalman().offsetSigma(), (float)sqrt(sum_sq / windows)};
+    return r;
+}
+
+static void report(const char* label, const Result& r) {
+    char line[128];
+    snprintf(line, sizeof(line), "%s: sigma %.4f %%, measured rms error %.4f %%",
+             label, r.sigma, r.rms_error);
+    TEST_MESSAGE(line);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_block_sigma_matches_error() {
+    const Result r = run(LightSensorPair::WindowMode::Block);
+    report("block", r);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f * r.sigma, r.sigma, r.rms_error);
+}
+
+// Fed every overlapping Sliding emission, sigma came out several times
+// smaller than the real error and the margin it sets collapsed.
+static void test_sliding_sigma_matches_block() {
+    const Result block = run(LightSensorPair::WindowMode::Block);
+    const Result sliding = run(LightSensorPair::WindowMode::Sliding);
+    report("sliding", sliding);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f * sliding.sigma, sliding.sigma, sliding.rms_error);
+    TEST_ASSERT_FLOAT_WITHIN(0.25f * block.sigma, block.sigma, sliding.sigma);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_block_sigma_matches_error);
+    RUN_TEST(test_sliding_sigma_matches_block);
+    return UNITY_END();
+}
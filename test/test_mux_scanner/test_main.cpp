@@ -0,0 +1,119 @@
+#include <unity.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sensors/LightSensorPair.h"
+#include "sensors/MuxScanner.h"
+#include "sensors/SimulatedMuxIo.h"
+
+// Four LDRs behind the mux, bright and dim channels interleaved so that a
+// short settle time reads as crosstalk from the channel scanned before.
+// Ten time constants settle the worst step to well under a count.
+static const float TAU_US = 4.0f;
+static const uint16_t LEVELS[4] = {3000, 600, 2800, 800};
+
+static MuxScanner::Config config(uint16_t settle_us) {
+    return {0x000F, settle_us, 500};
+}
+
+static void setLevels(SimulatedMuxIo& io) {
+    for (uint8_t ch = 0; ch < 4; ++ch) {
+        io.setLevel(ch, LEVELS[ch]);
+    }
+}
+
+// Worst |reading - level| over pairs (a, b) after `ms` of scanning, with the
+// caller servicing the scanner every `poll_us`.
+static int worstError(MuxScanner& scanner, uint8_t a, uint8_t b, uint32_t ms, uint32_t poll_us) {
+    int worst = 0;
+    uint16_t out_a[32];
+    uint16_t out_b[32];
+    for (uint32_t t = 0; t < ms * 1000UL; t += poll_us) {
+        HostPlatform::advanceMicros(poll_us);
+        const size_t n = scanner.readPairs(a, b, out_a, out_b, 32);
+        for (size_t i = 0; i < n; ++i) {
+            worst = max(worst, abs((int)out_a[i] - (int)LEVELS[a]));
+            worst = max(worst, abs((int)out_b[i] - (int)LEVELS[b]));
+        }
+    }
+    return worst;
+}
+
+void setUp() { HostPlatform::setMicros(0); }
+void tearDown() {}
+
+static void test_no_settle_shows_crosstalk() {
+    SimulatedMuxIo io(TAU_US);
+    setLevels(io);
+    MuxScanner scanner(config(0), io);
+    scanner.begin();
+    const int worst = worstError(scanner, 0, 1, 200, 50);
+    char line[96];
+    snprintf(line, sizeof(line), "settle 0 us: worst error %d counts", worst);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_GREATER_THAN(1000, worst);
+}
+
+static void test_settle_time_removes_crosstalk() {
+    SimulatedMuxIo io(TAU_US);
+    setLevels(io);
+    MuxScanner scanner(config(10 * TAU_US), io);
+    scanner.begin();
+    const int worst = worstError(scanner, 0, 1, 200, 50);
+    char line[96];
+    snprintf(line, sizeof(line), "settle 40 us: worst error %d counts", worst);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_LESS_OR_EQUAL(1, worst);
+    // Host settle waits advance the clock too, so at least 100 frames in 200 ms.
+    TEST_ASSERT_GREATER_OR_EQUAL(100U, scanner.frames());
+    TEST_ASSERT_EQUAL_UINT32(0, scanner.framesSkipped());
+}
+
+// The next channel is selected right after each conversion, so only the first
+// conversion of a frame can find the node still moving; within a frame the
+// scanner waits out the remainder of settle_us.
+static void test_pipelined_select_limits_waits() {
+    SimulatedMuxIo io(TAU_US);
+    setLevels(io);
+    MuxScanner scanner(config(20), io);
+    scanner.begin();
+    worstError(scanner, 2, 3, 200, 1000);
+    TEST_ASSERT_EQUAL_UINT32(scanner.frames() * 4, io.conversionCount());
+    TEST_ASSERT_LESS_OR_EQUAL(scanner.frames() * 3, scanner.settleWaits());
+}
+
+static void test_feeds_light_sensor_pair() {
+    SimulatedMuxIo io(TAU_US);
+    setLevels(io);
+    MuxScanner scanner(config(10 * TAU_US), io);
+    const LightSensorPair::Config cfg = {
+        2, 3, 3, 120, LightSensorPair::WindowMode::Block, LightSensorPair::Estimator::Mean,
+        20, LightSensorPair::Response::Raw, nullptr, 0, 0.0f, 0, false, 0.0f};
+    // main's order: the pair exists before the scanner runs.
+    LightSensorPair pair(cfg, &scanner);
+    scanner.begin();
+    pair.begin();
+    LightSensorPair::Sample sample;
+    unsigned windows = 0;
+    for (unsigned long ms = 0; ms < 1000; ++ms) {
+        HostPlatform::advanceMicros(1000);
+        pair.tick(ms);
+        if (pair.consumeSample(sample) && sample.window_complete) {
+            windows++;
+            TEST_ASSERT_EQUAL_UINT(60, sample.sample_count);
+            TEST_ASSERT_FLOAT_WITHIN(0.05f, 100.0f * (2800.0f - 800.0f) / 3600.0f,
+                                     sample.diff_percent);
+        }
+    }
+    TEST_ASSERT_INT_WITHIN(1, 8, (int)windows);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_no_settle_shows_crosstalk);
+    RUN_TEST(test_settle_time_removes_crosstalk);
+    RUN_TEST(test_pipelined_select_limits_waits);
+    RUN_TEST(test_feeds_light_sensor_pair);
+    return UNITY_END();
+}
@@ -0,0 +1,168 @@
+#include <unity.h>
+
+#include <math.h>
+#include <stdio.h>
+
+#include "track/RelayAutoTuner.h"
+
+// The relay experiment on a first-order-plus-dead-time plant, the diff
+// falling as the motor drives toward the sun:
+//   tau dy/dt = -y - K u(t - L)
+// Its relay limit cycle has a closed form. Switching at y = +h, the diff
+// keeps rising for L to a = Kd - (Kd - h) e^(-L/tau), then falls to -h:
+//   Tu = 2 (L + tau ln((Kd + a) / (Kd - h)))
+static const float RELAY = 0.5f;
+static const unsigned long WINDOW_MS = 10;
+static const unsigned long MOTOR_UPDATE_MS = 30;
+static const unsigned long MAX_DEAD_MS = 2000;
+
+struct Plant {
+    float gain;         // % diff per unit drive
+    float tau_s;
+    unsigned long dead_ms;
+};
+
+static RelayAutoTuner::Config tunerConfig(float hysteresis) {
+    return {"autotune", "t", RELAY, hysteresis, 4, 60000, MOTOR_UPDATE_MS};
+}
+
+// Closed-form limit cycle.
+static float cycleAmplitude(const Plant& p, float h) {
+    const float kd = p.gain * RELAY;
+    return kd - ((kd - h) * expf(-(float)p.dead_ms / (1000.0f * p.tau_s)));
+}
+
+static float cyclePeriod(const Plant& p, float h) {
+    const float kd = p.gain * RELAY;
+    const float a = cycleAmplitude(p, h);
+    return 2.0f * (((float)p.dead_ms / 1000.0f) + (p.tau_s * logf((kd + a) / (kd - h))));
+}
+
+// Frequency where the plant's phase reaches -180 deg, and the gain that
+// puts it on the unit circle there: the true ultimate point.
+static void ultimatePoint(const Plant& p, float* ku, float* tu_s) {
+    const double dead_s = (double)p.dead_ms / 1000.0;
+    double lo = 0.0;
+    double hi = PI / dead_s;
+    for (int i = 0; i < 60; ++i) {
+        const double w = (lo + hi) / 2.0;
+        if ((w * dead_s) + atan(w * p.tau_s) < PI) {
+            lo = w;
+        } else {
+            hi = w;
+        }
+    }
+    *ku = (float)(sqrt(1.0 + (lo * p.tau_s * lo * p.tau_s)) / p.gain);
+    *tu_s = (float)(2.0 * PI / lo);
+}
+
+// Euler at 1 ms; the tuner sees the diff every window.
+static RelayAutoTuner::State run(RelayAutoTuner& tuner, const Plant& p) {
+    static float delayed[MAX_DEAD_MS];
+    const unsigned long delay_len = min(p.dead_ms, MAX_DEAD_MS);
+    for (unsigned long i = 0; i < delay_len; ++i) {
+        delayed[i] = 0.0f;
+    }
+    float y = 0.0f;
+    tuner.start(1);
+    for (unsigned long ms = 1; ms <= 120000 && tuner.isRunning(); ++ms) {
+        const unsigned long slot = ms % delay_len;
+        const float u = delayed[slot];
+        delayed[slot] = tuner.output();
+        y += (-y - (p.gain * u)) / (1000.0f * p.tau_s);
+        if ((ms % WINDOW_MS) == 0) {
+            tuner.update(y, ms);
+        }
+    }
+    return tuner.state();
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Amplitude and period land on the closed form, and Ku is the relay's
+// describing-function gain at that amplitude, h included.
+static void test_identifies_limit_cycle() {
+    const Plant plants[2] = {{10.0f, 2.0f, 1000}, {10.0f, 1.0f, 1000}};
+    const float hysteresis[2] = {0.1f, 0.5f};
+    for (const Plant& p : plants) {
+        for (float h : hysteresis) {
+            RelayAutoTuner tuner(tunerConfig(h));
+            TEST_ASSERT_EQUAL(RelayAutoTuner::State::Done, run(tuner, p));
+            RelayAutoTuner::Result r;
+            TEST_ASSERT_TRUE(tuner.result(r));
+
+            const float a = cycleAmplitude(p, h);
+            const float tu = cyclePeriod(p, h);
+            const float ku = (4.0f * RELAY) / (PI * sqrtf((a * a) - (h * h)));
+            char line[128];
+            snprintf(line, sizeof(line),
+                     "tau %.1f s h %.1f %%: a %.3f (%.3f) Tu %.3f s (%.3f) Ku %.4f (%.4f)",
+                     p.tau_s, h, r.amplitude_percent, a, r.tu_s, tu, r.ku, ku);
+            TEST_MESSAGE(line);
+            TEST_ASSERT_FLOAT_WITHIN(0.01f * a, a, r.amplitude_percent);
+            TEST_ASSERT_FLOAT_WITHIN(0.01f * tu, tu, r.tu_s);
+            TEST_ASSERT_FLOAT_WITHIN(0.02f * ku, ku, r.ku);
+        }
+    }
+}
+
+// Against the plant's true ultimate point the period is close; the
+// describing function sees a square wave as its fundamental and reads Ku
+// low, the usual 15-20 % at L/tau 0.5-1.
+static void test_close_to_ultimate_point() {
+    const Plant p = {10.0f, 2.0f, 1000};
+    RelayAutoTuner tuner(tunerConfig(0.1f));
+    TEST_ASSERT_EQUAL(RelayAutoTuner::State::Done, run(tuner, p));
+    RelayAutoTuner::Result r;
+    TEST_ASSERT_TRUE(tuner.result(r));
+    float ku = 0.0f;
+    float tu = 0.0f;
+    ultimatePoint(p, &ku, &tu);
+    char line[96];
+    snprintf(line, sizeof(line), "ultimate Ku %.4f Tu %.3f s, relay Ku %.4f Tu %.3f s",
+             ku, tu, r.ku, r.tu_s);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_FLOAT_WITHIN(0.03f * tu, tu, r.tu_s);
+    TEST_ASSERT_TRUE(r.ku < ku);
+    TEST_ASSERT_FLOAT_WITHIN(0.25f * ku, ku, r.ku);
+}
+
+// Ziegler–Nichols PID from (Ku, Tu), and the deadband, pwm threshold and
+// motor IIR derived from the cycle.
+static void test_ziegler_nichols_gains() {
+    const Plant p = {10.0f, 2.0f, 1000};
+    const float h = 0.5f;
+    RelayAutoTuner tuner(tunerConfig(h));
+    TEST_ASSERT_EQUAL(RelayAutoTuner::State::Done, run(tuner, p));
+    RelayAutoTuner::Result r;
+    TEST_ASSERT_TRUE(tuner.result(r));
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 0.6f * r.ku, r.tuning.pid_kp);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, (0.6f * r.ku) / (r.tu_s / 2.0f), r.tuning.pid_ki);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 0.6f * r.ku * (r.tu_s / 8.0f), r.tuning.pid_kd);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, r.amplitude_percent - h, r.tuning.diff_deadband);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 2.0f * r.amplitude_percent, r.tuning.diff_pwm_threshold);
+    const float tau_s = r.tu_s / 60.0f;
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, expf(-((float)MOTOR_UPDATE_MS / 1000.0f) / tau_s),
+                             r.motor_smooth);
+}
+
+// A plant the relay cannot move never crosses -h: the run times out and
+// gives no result.
+static void test_times_out_without_cycle() {
+    const Plant p = {0.0f, 2.0f, 1000};
+    RelayAutoTuner tuner(tunerConfig(0.1f));
+    TEST_ASSERT_EQUAL(RelayAutoTuner::State::Failed, run(tuner, p));
+    RelayAutoTuner::Result r;
+    TEST_ASSERT_FALSE(tuner.result(r));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_identifies_limit_cycle);
+    RUN_TEST(test_close_to_ultimate_point);
+    RUN_TEST(test_ziegler_nichols_gains);
+    RUN_TEST(test_times_out_without_cycle);
+    return UNITY_END();
+}
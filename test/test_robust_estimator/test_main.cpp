@@ -0,0 +1,110 @@
+#include <unity.h>
+
+#include <chrono>
+#include <stdio.h>
+
+#include "sensors/LightSensorPair.h"
+#include "sensors/SyntheticSampleSource.h"
+
+// Steady light with a PWM-coupling spike on channel A every SPIKE_EVERY reads.
+static const uint16_t LEVEL_A = 2000;
+static const uint16_t LEVEL_B = 1800;
+static const uint16_t SPIKE = 4095;
+static const unsigned SPIKE_EVERY = 16;
+static const uint32_t RATE_HZ = 1000;
+
+typedef SyntheticSampleSource<64> Source;
+
+static LightSensorPair::Config config(LightSensorPair::Estimator estimator,
+                                      LightSensorPair::WindowMode mode) {
+    return {0, 1, 3, 120, mode, estimator, 20, LightSensorPair::Response::Raw,
+            nullptr, 0, 0.0f, 0, false, 0.0f};
+}
+
+static float truthDiff() {
+    return 100.0f * (float)(LEVEL_A - LEVEL_B) / (float)(LEVEL_A + LEVEL_B);
+}
+
+// Feeds `reads` spiky pairs and returns the last completed window's diff.
+static float lastWindowDiff(LightSensorPair::Estimator estimator,
+                            LightSensorPair::WindowMode mode,
+                            unsigned reads) {
+    Source source(RATE_HZ);
+    LightSensorPair pair(config(estimator, mode), &source);
+    LightSensorPair::Sample sample;
+    float diff = 0.0f;
+    for (unsigned i = 0; i < reads; ++i) {
+        source.push((i % SPIKE_EVERY == 0) ? SPIKE : LEVEL_A, LEVEL_B);
+        pair.tick(0);
+        if (pair.consumeSample(sample) && sample.window_complete) {
+            diff = sample.diff_percent;
+        }
+    }
+    return diff;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_mean_is_pulled_by_spikes() {
+    const float diff = lastWindowDiff(LightSensorPair::Estimator::Mean,
+                                      LightSensorPair::WindowMode::Block, 1200);
+    TEST_ASSERT_GREATER_THAN_FLOAT(truthDiff() + 1.0f, diff);
+}
+
+static void test_median_rejects_spikes() {
+    const float block = lastWindowDiff(LightSensorPair::Estimator::Median,
+                                       LightSensorPair::WindowMode::Block, 1200);
+    const float sliding = lastWindowDiff(LightSensorPair::Estimator::Median,
+                                         LightSensorPair::WindowMode::Sliding, 1200);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, truthDiff(), block);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, truthDiff(), sliding);
+}
+
+static void test_trimmed_mean_rejects_spikes() {
+    const float diff = lastWindowDiff(LightSensorPair::Estimator::TrimmedMean,
+                                      LightSensorPair::WindowMode::Sliding, 1200);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, truthDiff(), diff);
+}
+
+static volatile float sink_ = 0.0f;
+
+// Host timing of one read through the Sliding path: the Mean updates two sums,
+// the robust estimators also move both readings through the Fenwick trees.
+static double nsPerRead(LightSensorPair::Estimator estimator) {
+    static const unsigned READS = 200000;
+    Source source(RATE_HZ);
+    LightSensorPair pair(config(estimator, LightSensorPair::WindowMode::Sliding), &source);
+    LightSensorPair::Sample sample;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < READS; ++i) {
+        source.push((uint16_t)(LEVEL_A + (i & 31U)), LEVEL_B);
+        pair.tick(0);
+        if (pair.consumeSample(sample)) {
+            sink_ += sample.diff_percent;
+        }
+    }
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() /
+           (double)READS;
+}
+
+static void test_per_read_cost() {
+    const double mean_ns = nsPerRead(LightSensorPair::Estimator::Mean);
+    const double median_ns = nsPerRead(LightSensorPair::Estimator::Median);
+    const double trimmed_ns = nsPerRead(LightSensorPair::Estimator::TrimmedMean);
+    char line[128];
+    snprintf(line, sizeof(line), "ns/read mean %.0f median %.0f trimmed %.0f (x%.1f, x%.1f)",
+             mean_ns, median_ns, trimmed_ns, median_ns / mean_ns, trimmed_ns / mean_ns);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_GREATER_THAN_FLOAT(0.0f, (float)mean_ns);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_mean_is_pulled_by_spikes);
+    RUN_TEST(test_median_rejects_spikes);
+    RUN_TEST(test_trimmed_mean_rejects_spikes);
+    RUN_TEST(test_per_read_cost);
+    return UNITY_END();
+}
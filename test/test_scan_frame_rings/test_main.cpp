@@ -0,0 +1,101 @@
+#include <unity.h>
+
+#include "sensors/ScanFrameRings.h"
+
+// Two-pin scan: slot 0 carries the pass number, slot 1 the pass number + 1000,
+// so a pair belongs to one pass exactly when b - a == 1000.
+typedef ScanFrameRings<4, 16> Rings;
+
+static Rings rings;
+
+void setUp() { rings.reset(); }
+void tearDown() {}
+
+static void scan(uint16_t pass, bool drop_a, bool drop_b) {
+    if (!drop_a) {
+        rings.push(0, pass);
+    }
+    if (!drop_b) {
+        rings.push(1, (uint16_t)(pass + 1000));
+    }
+}
+
+static size_t drainChecked(size_t* bad) {
+    uint16_t a[32];
+    uint16_t b[32];
+    const size_t n = rings.popPairs(0, 1, a, b, 32);
+    for (size_t i = 0; i < n; ++i) {
+        if (b[i] - a[i] != 1000) {
+            (*bad)++;
+        }
+    }
+    return n;
+}
+
+void test_pairs_in_order() {
+    for (uint16_t p = 0; p < 10; ++p) {
+        scan(p, false, false);
+    }
+    size_t bad = 0;
+    TEST_ASSERT_EQUAL(10, drainChecked(&bad));
+    TEST_ASSERT_EQUAL(0, bad);
+    TEST_ASSERT_EQUAL(0, rings.resyncs());
+}
+
+void test_lost_conversion_costs_one_pass() {
+    size_t bad = 0;
+    size_t pairs = 0;
+    for (uint16_t p = 0; p < 200; ++p) {
+        scan(p, (p % 37) == 5, (p % 23) == 7);
+        if ((p % 6) == 0) {
+            pairs += drainChecked(&bad);
+        }
+    }
+    pairs += drainChecked(&bad);
+    TEST_ASSERT_EQUAL(0, bad);
+    // Passes with a lost conversion on either pin are skipped, no others.
+    size_t lost = 0;
+    for (uint16_t p = 0; p < 200; ++p) {
+        lost += (((p % 37) == 5) || ((p % 23) == 7)) ? 1 : 0;
+    }
+    TEST_ASSERT_EQUAL(200 - lost, pairs);
+}
+
+void test_overrun_on_one_ring_resyncs() {
+    // B loses a conversion, then the reader stalls past ring capacity.
+    for (uint16_t p = 0; p < 40; ++p) {
+        scan(p, false, p == 3);
+    }
+    TEST_ASSERT_GREATER_THAN(0, rings.overruns());
+    size_t bad = 0;
+    const size_t n = drainChecked(&bad);
+    TEST_ASSERT_EQUAL(0, bad);
+    TEST_ASSERT_EQUAL(16, n);
+    for (uint16_t p = 40; p < 50; ++p) {
+        scan(p, false, false);
+    }
+    TEST_ASSERT_EQUAL(10, drainChecked(&bad));
+    TEST_ASSERT_EQUAL(0, bad);
+}
+
+void test_frame_index_wraps() {
+    size_t bad = 0;
+    size_t pairs = 0;
+    for (uint32_t p = 0; p < 70000; ++p) {
+        scan((uint16_t)(p % 1000), false, (p % 1001) == 9);
+        if ((p % 8) == 7) {
+            pairs += drainChecked(&bad);
+        }
+    }
+    TEST_ASSERT_EQUAL(0, bad);
+    TEST_ASSERT_GREATER_THAN(69000, pairs);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_pairs_in_order);
+    RUN_TEST(test_lost_conversion_costs_one_pass);
+    RUN_TEST(test_overrun_on_one_ring_resyncs);
+    RUN_TEST(test_frame_index_wraps);
+    return UNITY_END();
+}
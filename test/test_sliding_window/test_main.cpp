@@ -0,0 +1,81 @@
+#include <unity.h>
+
+#include <stdio.h>
+
+#include "sensors/LightSensorPair.h"
+#include "sensors/SyntheticSampleSource.h"
+
+// Steady light, one read per tick at 1 kHz: a 40 ms action interval is a
+// 40-read window.
+static const uint16_t LEVEL_A = 2000;
+static const uint16_t LEVEL_B = 1800;
+static const uint32_t RATE_HZ = 1000;
+static const unsigned WINDOW = 40;
+static const unsigned READS = 5 * WINDOW;
+
+static LightSensorPair::Config config() {
+    return {0, 1, 3, WINDOW, LightSensorPair::WindowMode::Sliding,
+            LightSensorPair::Estimator::Mean, 20, LightSensorPair::Response::Raw, nullptr,
+            0, 0.0f, 0, false, 0.0f};
+}
+
+void setUp() {}
+void tearDown() {}
+
+// A sample on every read, a completed window every WINDOW reads, and the
+// read count growing to the window and staying there.
+static void test_emits_every_read_completes_every_window() {
+    SyntheticSampleSource<64> source(RATE_HZ);
+    LightSensorPair pair(config(), &source);
+    LightSensorPair::Sample sample;
+    unsigned emitted = 0;
+    unsigned completed = 0;
+    for (unsigned i = 1; i <= READS; ++i) {
+        source.push(LEVEL_A, LEVEL_B);
+        pair.tick(0);
+        TEST_ASSERT_TRUE(pair.consumeSample(sample));
+        emitted++;
+        TEST_ASSERT_EQUAL_UINT(i < WINDOW ? i : WINDOW, sample.sample_count);
+        TEST_ASSERT_EQUAL_UINT(WINDOW, sample.window_size);
+        TEST_ASSERT_EQUAL(i % WINDOW == 0, sample.window_complete);
+        if (sample.window_complete) {
+            completed++;
+        }
+    }
+    char line[64];
+    snprintf(line, sizeof(line), "%u reads: %u samples, %u completed windows",
+             READS, emitted, completed);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_EQUAL_UINT(READS, emitted);
+    TEST_ASSERT_EQUAL_UINT(READS / WINDOW, completed);
+}
+
+// Confidence is the filled fraction of the window and reaches 1 when it
+// fills. The fixed-point build refreshes it on completed windows only.
+static void test_confidence_at_window_fill() {
+    SyntheticSampleSource<64> source(RATE_HZ);
+    LightSensorPair pair(config(), &source);
+    LightSensorPair::Sample sample;
+    for (unsigned i = 1; i <= WINDOW; ++i) {
+        source.push(LEVEL_A, LEVEL_B);
+        pair.tick(0);
+        TEST_ASSERT_TRUE(pair.consumeSample(sample));
+        if (i < WINDOW) {
+            TEST_ASSERT_FALSE(sample.window_complete);
+#if !SATELLITE_FIXED_POINT
+            TEST_ASSERT_FLOAT_WITHIN(0.001f, (float)i / (float)WINDOW, sample.confidence);
+#endif
+        }
+    }
+    TEST_ASSERT_TRUE(sample.window_complete);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, sample.confidence);
+    const float diff = 100.0f * (float)(LEVEL_A - LEVEL_B) / (float)(LEVEL_A + LEVEL_B);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, diff, sample.diff_percent);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_emits_every_read_completes_every_window);
+    RUN_TEST(test_confidence_at_window_fill);
+    return UNITY_END();
+}
@@ -0,0 +1,126 @@
+#include <unity.h>
+
+#include <stdio.h>
+
+#include "drivers/CurrentMonitor.h"
+#include "drivers/MotorDriver.h"
+#include "drivers/PwmOutput.h"
+#include "sensors/SimulatedCurrentSource.h"
+
+// main's current-sense settings on main's 30 ms motor update: the axis runs
+// up to speed, then the rotor jams. Latency is jam to the drive being cut.
+static const unsigned long UPDATE_MS = 30;
+static const unsigned long STALL_MS = 300;
+static const unsigned long JAM_AT_MS = 3000;
+
+static const CurrentMonitor::Config MONITOR_CFG = {2.0f, 0.8f, STALL_MS, 1.5f, 0.5f, 12.0f, 0.5f};
+
+static MotorDriver::Config motorConfig() {
+    return {25, 26, 20000, 10, 0, 1, 0.8f, UPDATE_MS, 0.8f, 200, 0.0f, 0,
+            MotorDriver::Profile::Exponential, 2.0f, 20.0f, 400.0f};
+}
+
+// Hands every duty write to the current model, so the reading MotorDriver
+// takes right after a write sees the new duty, as the winding does.
+class CurrentTap : public PwmOutput {
+public:
+    CurrentTap(SimulatedCurrentSource& source, uint32_t range)
+        : source_(source),
+          range_((float)range) {}
+
+    void setup(uint8_t channel, uint32_t freq_hz, uint8_t res_bits, int pin) override {
+        (void)channel;
+        (void)freq_hz;
+        (void)res_bits;
+        (void)pin;
+    }
+
+    void write(uint8_t channel, uint32_t duty) override {
+        duty_[channel & 1] = (float)duty;
+        source_.setApplied((duty_[0] - duty_[1]) / range_);
+    }
+
+private:
+    SimulatedCurrentSource& source_;
+    float range_;
+    float duty_[2] = {0.0f, 0.0f};
+};
+
+struct Result {
+    long latency_ms;   // -1: never cut
+    uint32_t early;    // Stalls latched before the jam
+};
+
+static Result run(float duty, float noise_amps, bool averages_pwm, unsigned long phase_ms) {
+    HostPlatform::setMillis(1000);
+    const SimulatedCurrentSource::Config source_cfg = {2.0f, 0.15f, 80.0f, noise_amps,
+                                                       averages_pwm};
+    SimulatedCurrentSource source(source_cfg);
+    CurrentMonitor monitor(MONITOR_CFG, source);
+    CurrentTap output(source, 1023);
+    MotorDriver motor(motorConfig(), &output, &monitor);
+    motor.begin();
+    motor.setTargetNormalized(duty);
+
+    Result r = {-1, 0};
+    const unsigned long jam_ms = 1000 + JAM_AT_MS + phase_ms;
+    for (unsigned long now = 1000; now < jam_ms + 2000; ++now) {
+        HostPlatform::setMillis(now);
+        if (now == jam_ms) {
+            r.early = monitor.stalls();
+            source.jam(true);
+        }
+        motor.tick(now);
+        if (now >= jam_ms && motor.stallSign() != 0 && !motor.isDriving()) {
+            r.latency_ms = (long)(now - jam_ms);
+            break;
+        }
+    }
+    return r;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Latency is stall_ms plus at most four updates, at any duty, noise and jam
+// time between updates: the first jammed reading, the filter crossing the
+// threshold, the latch landing on an update and the cut on the next one.
+// The start-up surge never latches.
+static void test_stall_cut_latency() {
+    const float duties[3] = {0.5f, 0.8f, 0.99f};
+    const float noises[2] = {0.05f, 0.3f};
+    long best = 1000000;
+    long worst = 0;
+    for (int averaged = 0; averaged < 2; ++averaged) {
+        for (int d = 0; d < 3; ++d) {
+            for (int n = 0; n < 2; ++n) {
+                long row_best = 1000000;
+                long row_worst = 0;
+                for (unsigned long phase = 0; phase < UPDATE_MS; phase += 3) {
+                    const Result r = run(duties[d], noises[n], averaged != 0, phase);
+                    TEST_ASSERT_EQUAL_UINT32(0, r.early);
+                    TEST_ASSERT_GREATER_OR_EQUAL((long)STALL_MS, r.latency_ms);
+                    row_best = min(row_best, r.latency_ms);
+                    row_worst = max(row_worst, r.latency_ms);
+                }
+                char line[96];
+                snprintf(line, sizeof(line), "%s duty %.2f noise %.2f A: %ld-%ld ms",
+                         averaged ? "averaged" : "in-phase", duties[d], noises[n],
+                         row_best, row_worst);
+                TEST_MESSAGE(line);
+                best = min(best, row_best);
+                worst = max(worst, row_worst);
+            }
+        }
+    }
+    char line[64];
+    snprintf(line, sizeof(line), "all cases %ld-%ld ms", best, worst);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_LESS_OR_EQUAL((long)(STALL_MS + (4 * UPDATE_MS)), worst);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_stall_cut_latency);
+    return UNITY_END();
+}
@@ -0,0 +1,170 @@
+#include <unity.h>
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+
+#include "track/TrackingCoordinator.h"
+#include "track/TrackingUnit.h"
+
+#include "../TestPlant.h"
+
+// One axis on TestPlant configs with PID and hunting on, built once on
+// runtime copies of the configs (BasicTrackingUnit<>) and once on the same
+// values as constexpr template arguments (StaticTrackingUnit), as main builds
+// its axes. The sun sits 4 deg off and the axis is stepped once per ms.
+static const int PIN_A = 32;
+static const int PIN_B = 33;
+static const unsigned long RUN_MS = 20000;
+
+extern constexpr LightSensorPair::Config SENSOR_CFG = {
+    PIN_A, PIN_B, 3, 120, LightSensorPair::WindowMode::Block, LightSensorPair::Estimator::Mean, 20,
+    LightSensorPair::Response::Raw, nullptr, 0, 0.0f, 0, false, 0.0f};
+
+extern constexpr TrackerController::Config TRACKER_CFG = {
+    1.0f, 15.0f, 0.4f, 0.99f, 0, 0.0f, 0, 0.0f, 0, 0.0f,
+    TrackerController::DeadbandMode::Tiered, 3.0f,
+    TrackerController::ControlMode::Pid, 0.06f, 0.02f, 0.01f, 500, 2000, 1.0f,
+    0.0f, false, {8.0f, 0.5f, 0.01f, 6.0f}, 0.01f, 1.0f,
+    {false, 0.5f, 0.3f, 9.0f, 60.0f, 2000, 120000},
+    {false, 0.5f, 0.25f, 3000},
+    {true, 2000, 4, 0.5f, 5.0f, 0.02f}};
+
+extern constexpr MotorDriver::Config MOTOR_CFG = {
+    -1, -1, 20000, 8, 0, 1, 0.5f, 10, 0.8f, 200, 0.0f, 0,
+    MotorDriver::Profile::Exponential, 2.0f, 20.0f, 400.0f};
+
+typedef StaticTrackingUnit<SENSOR_CFG, TRACKER_CFG, MOTOR_CFG> StaticUnit;
+
+static void setPair(double sun, const TestPlant::Axis& axis) {
+    HostPlatform::analogPins()[PIN_A] = TestPlant::pairCount(2000.0, sun - axis.pos, +1);
+    HostPlatform::analogPins()[PIN_B] = TestPlant::pairCount(2000.0, sun - axis.pos, -1);
+}
+
+struct Trace {
+    float applied[RUN_MS];
+    uint32_t windows;
+    uint32_t duty_ms;
+    double final_pos;
+};
+
+static void track(TrackingUnit& unit, Trace& trace) {
+    HostPlatform::setMillis(0);
+    unit.begin();
+    const double sun = 4.0;
+    TestPlant::Axis axis = {0.0, 0.0};
+    TrackingUnit::LogSample log;
+    trace.windows = 0;
+    for (unsigned long ms = 1; ms <= RUN_MS; ++ms) {
+        HostPlatform::setMillis(ms);
+        setPair(sun, axis);
+        unit.tick(ms);
+        if (unit.consumeLog(log)) {
+            trace.windows++;
+        }
+        trace.applied[ms - 1] = unit.appliedNorm();
+        axis.move(unit.appliedNorm());
+    }
+    trace.duty_ms = unit.motorDutyMs();
+    trace.final_pos = axis.pos;
+}
+
+static Trace runtime_trace;
+static Trace static_trace;
+
+void setUp() {}
+void tearDown() {}
+
+// Folding the configs into the code changes no decision: the same duty on
+// every ms, the same windows and the same final position.
+static void test_static_matches_runtime() {
+    BasicTrackingUnit<> runtime_unit(SENSOR_CFG, TRACKER_CFG, MOTOR_CFG);
+    StaticUnit static_unit;
+    track(runtime_unit, runtime_trace);
+    track(static_unit, static_trace);
+    for (unsigned long i = 0; i < RUN_MS; ++i) {
+        TEST_ASSERT_EQUAL_FLOAT(runtime_trace.applied[i], static_trace.applied[i]);
+    }
+    TEST_ASSERT_GREATER_THAN(0U, static_trace.windows);
+    TEST_ASSERT_EQUAL_UINT32(runtime_trace.windows, static_trace.windows);
+    TEST_ASSERT_EQUAL_UINT32(runtime_trace.duty_ms, static_trace.duty_ms);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 4.0f, (float)static_trace.final_pos);
+}
+
+// An axis built without motor pins: no reads, no drive, and to the group a
+// settled axis, so the coordinator blocks on the other axis alone.
+static void test_idle_axis_defers_to_the_other() {
+    IdleTrackingUnit idle;
+    TEST_ASSERT_TRUE(idle.hasDiffSample());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, idle.lastDiffPercent());
+    TEST_ASSERT_TRUE(idle.currentMonitor() == nullptr);
+
+    HostPlatform::setMillis(0);
+    HostPlatform::analogPins()[PIN_A] = 2000;
+    HostPlatform::analogPins()[PIN_B] = 2000;
+    StaticUnit unit;
+    const TrackingCoordinator::Config cfg = {
+        1500, 10000, TrackingCoordinator::Mode::Independent, 300, false, 0.8f, 2.0f, 2000, 120000};
+    TrackingCoordinator coordinator(cfg, unit, idle);
+    unit.begin();
+    idle.begin();
+    coordinator.setEnabled(true);
+    TrackingUnit::LogSample log;
+    for (unsigned long ms = 1; ms <= 5000; ++ms) {
+        HostPlatform::setMillis(ms);
+        coordinator.tick(ms);
+        unit.tick(ms);
+        idle.tick(ms);
+        TEST_ASSERT_FALSE(idle.consumeLog(log));
+        TEST_ASSERT_EQUAL_FLOAT(0.0f, idle.appliedNorm());
+    }
+    TEST_ASSERT_TRUE(coordinator.hasBothDiffs());
+    TEST_ASSERT_TRUE(coordinator.isBlocked());
+    TEST_ASSERT_EQUAL_UINT32(0, idle.diffSamples());
+}
+
+static volatile float sink_ = 0.0f;
+
+// Host timing of a tick, closed loop (plant step included in both).
+static double nsPerTick(TrackingUnit& unit) {
+    static const unsigned long TICKS = 2000000;
+    HostPlatform::setMillis(0);
+    unit.begin();
+    TestPlant::Axis axis = {0.0, 0.0};
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned long ms = 1; ms <= TICKS; ++ms) {
+        HostPlatform::setMillis(ms);
+        setPair(4.0 + 2.0 * sin((double)ms / 60000.0), axis);
+        unit.tick(ms);
+        axis.move(unit.appliedNorm());
+    }
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    sink_ += (float)axis.pos;
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() /
+           (double)TICKS;
+}
+
+static void test_per_tick_cost() {
+    BasicTrackingUnit<> runtime_unit(SENSOR_CFG, TRACKER_CFG, MOTOR_CFG);
+    StaticUnit static_unit;
+    const double runtime_ns = nsPerTick(runtime_unit);
+    const double static_ns = nsPerTick(static_unit);
+    char line[128];
+    snprintf(line, sizeof(line), "ns/tick runtime config %.1f, constexpr config %.1f (%.0f %%)",
+             runtime_ns, static_ns, 100.0 * (static_ns - runtime_ns) / runtime_ns);
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "sizeof runtime unit %u, constexpr unit %u, idle unit %u",
+             (unsigned)sizeof(BasicTrackingUnit<>), (unsigned)sizeof(StaticUnit),
+             (unsigned)sizeof(IdleTrackingUnit));
+    TEST_MESSAGE(line);
+    TEST_ASSERT_LESS_THAN(sizeof(BasicTrackingUnit<>), sizeof(StaticUnit));
+    TEST_ASSERT_GREATER_THAN_FLOAT(0.0f, (float)static_ns);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_static_matches_runtime);
+    RUN_TEST(test_idle_axis_defers_to_the_other);
+    RUN_TEST(test_per_tick_cost);
+    return UNITY_END();
+}
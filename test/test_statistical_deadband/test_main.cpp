@@ -0,0 +1,141 @@
+#include <unity.h>
+
+#include <math.h>
+#include <stdio.h>
+
+#include "../TestPlant.h"
+
+// A parked axis looking at a fixed 1 % diff. In Statistical mode the
+// deadband is sigma_k standard errors of the window's diff, floored at
+// diff_deadband: noise that would move a fixed deadband does not.
+static const int PIN_A = 33;
+static const int PIN_B = 35;
+static const float SIGMA_K = 3.0f;
+static const float FLOOR = 0.5f;
+
+static TrackerController::Config trackerConfig(TrackerController::DeadbandMode mode) {
+    TrackerController::Config cfg = TestPlant::trackerConfig();
+    cfg.diff_deadband = FLOOR;
+    cfg.deadband_mode = mode;
+    cfg.deadband_sigma_k = SIGMA_K;
+    return cfg;
+}
+
+struct Result {
+    unsigned windows;
+    unsigned moved;        // Windows that drove the motor
+    unsigned widened;      // Windows whose deadband was above the floor
+    float worst_error;     // Largest |deadband - expected| in %
+    float mean_deadband;
+};
+
+// 100 s of 40-read windows with +-noise counts on each LDR.
+static Result run(TrackerController::DeadbandMode mode, int noise_counts) {
+    TestPlant::Noise noise;
+    HostPlatform::setMillis(0);
+    LightSensorPair sensors(TestPlant::sensorConfig(PIN_A, PIN_B));
+    MotorDriver motor(TestPlant::motorConfig(0.0f, 0.0f, 0));
+    TrackerController tracker(trackerConfig(mode), sensors, motor);
+    motor.begin();
+
+    Result r = {0, 0, 0, 0.0f, 0.0f};
+    for (unsigned long ms = 1; ms <= 100000; ++ms) {
+        HostPlatform::setMillis(ms);
+        HostPlatform::analogPins()[PIN_A] = 2020 + noise.next(noise_counts);
+        HostPlatform::analogPins()[PIN_B] = 1980 + noise.next(noise_counts);
+        sensors.tick(ms);
+        tracker.tick(ms);
+        motor.tick(ms);
+        if (!tracker.hasNewSample()) {
+            continue;
+        }
+        tracker.clearNewSample();
+        const LightSensorPair::Sample s = tracker.lastSample();
+        const float db = tracker.lastEffectiveDeadband();
+        const float expected =
+            max(FLOOR, SIGMA_K * sqrtf(s.var_diff / (float)s.sample_count));
+        r.windows++;
+        r.moved += (tracker.lastTargetNorm() != 0.0f) ? 1 : 0;
+        r.widened += (db > FLOOR + 0.01f) ? 1 : 0;
+        r.mean_deadband += db;
+        if (mode == TrackerController::DeadbandMode::Statistical) {
+            r.worst_error = max(r.worst_error, fabsf(db - expected));
+        }
+    }
+    r.mean_deadband /= (float)r.windows;
+    return r;
+}
+
+static void report(const char* label, const Result& r) {
+    char line[128];
+    snprintf(line, sizeof(line),
+             "%s: %u windows, moved %u, widened %u, mean deadband %.3f %%, worst error %.4f %%",
+             label, r.windows, r.moved, r.widened, r.mean_deadband, r.worst_error);
+    TEST_MESSAGE(line);
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Every window's deadband is k * sqrt(var_diff / n) of that window, or the
+// floor when that is smaller.
+static void test_deadband_tracks_window_std_error() {
+    const Result r = run(TrackerController::DeadbandMode::Statistical, 400);
+    report("noisy", r);
+    TEST_ASSERT_EQUAL_UINT32(833, r.windows);
+    TEST_ASSERT_EQUAL_UINT32(r.windows, r.widened);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.0f, r.worst_error);
+}
+
+// With quiet sensors the standard error is far below the floor, and the
+// 1 % offset moves the axis every window as a fixed deadband would.
+static void test_quiet_sensors_use_floor() {
+    const Result r = run(TrackerController::DeadbandMode::Statistical, 2);
+    report("quiet", r);
+    TEST_ASSERT_EQUAL_UINT32(0, r.widened);
+    TEST_ASSERT_EQUAL_UINT32(r.windows, r.moved);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, FLOOR, r.mean_deadband);
+}
+
+// Window means scatter about 1.3 % around the 1 % offset. The fixed floor
+// drives on most of them, often the wrong way; three standard errors hold.
+static void test_noise_does_not_move_axis() {
+    const Result tiered = run(TrackerController::DeadbandMode::Tiered, 400);
+    const Result stat = run(TrackerController::DeadbandMode::Statistical, 400);
+    report("tiered", tiered);
+    report("statistical", stat);
+    TEST_ASSERT_GREATER_THAN(tiered.windows / 2, tiered.moved);
+    TEST_ASSERT_LESS_THAN(stat.windows / 20, stat.moved);
+}
+
+// A sliding window's first emission holds one read: no variance, so the
+// deadband is the full scale and nothing moves.
+static void test_single_read_holds() {
+    HostPlatform::setMillis(0);
+    LightSensorPair sensors(TestPlant::sensorConfig(PIN_A, PIN_B,
+                                                    LightSensorPair::WindowMode::Sliding));
+    MotorDriver motor(TestPlant::motorConfig(0.0f, 0.0f, 0));
+    TrackerController tracker(trackerConfig(TrackerController::DeadbandMode::Statistical),
+                              sensors, motor);
+    motor.begin();
+    HostPlatform::analogPins()[PIN_A] = 3000;
+    HostPlatform::analogPins()[PIN_B] = 1000;
+    for (unsigned long ms = 1; !tracker.hasNewSample() && ms < 100; ++ms) {
+        HostPlatform::setMillis(ms);
+        sensors.tick(ms);
+        tracker.tick(ms);
+    }
+    TEST_ASSERT_TRUE(tracker.hasNewSample());
+    TEST_ASSERT_EQUAL_UINT16(1, tracker.lastSample().sample_count);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 100.0f, tracker.lastEffectiveDeadband());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, tracker.lastTargetNorm());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_deadband_tracks_window_std_error);
+    RUN_TEST(test_quiet_sensors_use_floor);
+    RUN_TEST(test_noise_does_not_move_axis);
+    RUN_TEST(test_single_read_holds);
+    return UNITY_END();
+}
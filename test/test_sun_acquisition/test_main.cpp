@@ -0,0 +1,160 @@
+#include <unity.h>
+
+#include <math.h>
+#include <stdio.h>
+
+#include "track/SunAcquisition.h"
+#include "track/TrackingUnit.h"
+#include "track/TravelGuard.h"
+
+#include "../TestPlant.h"
+
+// TestPlant's axis wired as main's V axis: travel 0..90 deg between the
+// endstops (pin 1 at 0 deg). The LDR pair sees the sun within +-40 deg; outside that
+// both read a dark 80 counts, below the tier that makes the deadband 100 %.
+static const int PIN_A = 33;
+static const int PIN_B = 35;
+static const int LIMIT_1 = 5;
+static const int LIMIT_2 = 22;
+static const double TRAVEL_DEG = 90.0;
+static const double FIELD_DEG = 40.0;
+static const unsigned long TIMEOUT_MS = 120000;
+
+static TrackerController::Config trackerConfig() {
+    TrackerController::Config cfg = TestPlant::trackerConfig();
+    cfg.low_light_level_1 = 500;
+    cfg.low_light_deadband_1_percent = 5.0f;
+    cfg.low_light_level_2 = 200;
+    cfg.low_light_deadband_2_percent = 20.0f;
+    cfg.low_light_level_3 = 100;
+    cfg.low_light_deadband_3_percent = 100.0f;
+    return cfg;
+}
+
+struct Result {
+    bool locked;
+    unsigned long time_to_lock_ms;
+    float final_error_deg;
+};
+
+static Result run(double start_deg, double sun_deg, bool search) {
+    HostPlatform::setMillis(0);
+    const TravelGuard::Config guard_cfg = {LIMIT_1, LIMIT_2, true, false, 25, 0.99f, +1, -1};
+    const SunAcquisition::Config acq_cfg = {true, 0.99f, -1, 200, 60000, 900000, 500, TIMEOUT_MS};
+
+    BasicTrackingUnit<> unit(TestPlant::sensorConfig(PIN_A, PIN_B), trackerConfig(),
+                             TestPlant::motorConfig(0.5f, 0.8f, 100));
+    TravelGuard guard(guard_cfg);
+    SunAcquisition acquisition(acq_cfg);
+    unit.begin();
+
+    TestPlant::Axis axis = {start_deg, 0.0};
+    HostPlatform::digitalPins()[LIMIT_1] = 0;
+    HostPlatform::digitalPins()[LIMIT_2] = 0;
+    guard.begin();
+    if (search) {
+        acquisition.start(0);
+        guard.startSweepFromPressedLimit();
+    }
+
+    Result r = {false, 0, 0.0f};
+    const unsigned long end_ms = TIMEOUT_MS + 20000;
+    for (unsigned long ms = 1; ms <= end_ms; ++ms) {
+        HostPlatform::setMillis(ms);
+        const double err = sun_deg - axis.pos;
+        const bool seen = fabs(err) < FIELD_DEG;
+        const double level = seen ? 3000.0 * (1.0 - fabs(err) / FIELD_DEG) + 80.0 : 80.0;
+        HostPlatform::analogPins()[PIN_A] = TestPlant::pairCount(level, seen ? err : 0.0, +1);
+        HostPlatform::analogPins()[PIN_B] = TestPlant::pairCount(level, seen ? err : 0.0, -1);
+        HostPlatform::digitalPins()[LIMIT_1] = (axis.pos <= 0.0) ? 1 : 0;
+        HostPlatform::digitalPins()[LIMIT_2] = (axis.pos >= TRAVEL_DEG) ? 1 : 0;
+
+        // The V-axis part of main's loop.
+        guard.tick(ms);
+        const bool sweep_active = guard.isSweepActive();
+        const float sweep_norm = sweep_active ? guard.sweepTargetNorm() : 0.0f;
+        acquisition.tick(ms, sweep_active, sweep_norm, unit.appliedNorm());
+        const bool acquiring = acquisition.isActive();
+        if (sweep_active) {
+            unit.setTargetOverride(sweep_norm);
+        } else if (acquiring) {
+            unit.setTargetOverride(acquisition.targetNorm());
+        } else {
+            unit.clearTargetOverride();
+        }
+        if (sweep_active || acquiring) {
+            unit.setMotorOverride(true);
+        }
+        unit.tick(ms);
+        TrackingUnit::LogSample log;
+        if (unit.consumeLog(log)) {
+            acquisition.addWindow(log.avg_a, log.avg_b,
+                                  fabsf(log.diff_percent) <= unit.lastEffectiveDeadband(), ms);
+        }
+
+        axis.move(unit.appliedNorm());
+        if (axis.pos < 0.0 || axis.pos > TRAVEL_DEG) {
+            axis.pos = constrain(axis.pos, 0.0, TRAVEL_DEG);
+            axis.speed = 0.0;
+        }
+    }
+    r.locked = search ? acquisition.isLocked() : (fabs(sun_deg - axis.pos) < 1.0);
+    r.time_to_lock_ms = acquisition.timeToLockMs();
+    r.final_error_deg = (float)fabs(sun_deg - axis.pos);
+    return r;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_without_search_axis_stays_lost() {
+    const Result r = run(10.0, 75.0, false);
+    TEST_ASSERT_FALSE(r.locked);
+    TEST_ASSERT_GREATER_THAN_FLOAT(60.0f, r.final_error_deg);
+}
+
+// Benchmark over starts and sun positions across the travel, the sun both
+// inside and outside the field at the start.
+static void test_time_to_lock_benchmark() {
+    static const double STARTS[3] = {5.0, 45.0, 85.0};
+    static const double SUNS[4] = {10.0, 35.0, 60.0, 80.0};
+    unsigned long worst_ms = 0;
+    unsigned long total_ms = 0;
+    float worst_error = 0.0f;
+    unsigned locked = 0;
+    unsigned cases = 0;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            const Result r = run(STARTS[i], SUNS[j], true);
+            cases++;
+            if (!r.locked) {
+                char line[96];
+                snprintf(line, sizeof(line), "start %.0f deg, sun %.0f deg: no lock",
+                         STARTS[i], SUNS[j]);
+                TEST_MESSAGE(line);
+                continue;
+            }
+            locked++;
+            worst_ms = max(worst_ms, r.time_to_lock_ms);
+            total_ms += r.time_to_lock_ms;
+            worst_error = max(worst_error, r.final_error_deg);
+        }
+    }
+    char line[160];
+    snprintf(line, sizeof(line),
+             "%u/%u locked, time-to-lock mean %.1f s, worst %.1f s, final error worst %.2f deg",
+             locked, cases, (locked > 0) ? (double)total_ms / locked / 1000.0 : 0.0,
+             (double)worst_ms / 1000.0, worst_error);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_EQUAL_UINT(cases, locked);
+    // Seek plus one full sweep and the way back, at about 5.9 deg/s.
+    TEST_ASSERT_LESS_THAN(60000UL, worst_ms);
+    TEST_ASSERT_LESS_THAN_FLOAT(1.0f, worst_error);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_without_search_axis_stays_lost);
+    RUN_TEST(test_time_to_lock_benchmark);
+    return UNITY_END();
+}
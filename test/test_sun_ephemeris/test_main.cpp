@@ -0,0 +1,161 @@
+#include <unity.h>
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+
+#include "track/SunEphemeris.h"
+
+// SunEphemeris against the full NOAA solar calculator (Meeus, in double,
+// ~0.01 deg), over daylight at several latitudes from 2024 to 2030.
+static const double PI_D = 3.14159265358979;
+static const time_t START_UTC = 1704067200; // 2024-01-01
+static const int YEARS = 7;
+
+struct Site {
+    const char* name;
+    float latitude_deg;
+    float longitude_deg;
+};
+
+static const Site SITES[] = {
+    {"Tromso", 69.65f, 18.96f},
+    {"Berlin", 52.52f, 13.40f},
+    {"Phoenix", 33.45f, -112.07f},
+    {"Quito", -0.18f, -78.47f},
+    {"Sydney", -33.87f, 151.21f},
+};
+
+static double rad(double deg) { return deg * PI_D / 180.0; }
+static double deg(double r) { return r * 180.0 / PI_D; }
+
+// NOAA spreadsheet equations, no refraction.
+static SunEphemeris::Position reference(const Site& site, time_t utc) {
+    const double jd = ((double)utc / 86400.0) + 2440587.5;
+    const double t = (jd - 2451545.0) / 36525.0;
+    const double l0 = fmod(280.46646 + (t * (36000.76983 + (t * 0.0003032))), 360.0);
+    const double m = 357.52911 + (t * (35999.05029 - (0.0001537 * t)));
+    const double e = 0.016708634 - (t * (0.000042037 + (0.0000001267 * t)));
+    const double c = (sin(rad(m)) * (1.914602 - (t * (0.004817 + (0.000014 * t)))))
+                   + (sin(rad(2.0 * m)) * (0.019993 - (0.000101 * t)))
+                   + (sin(rad(3.0 * m)) * 0.000289);
+    const double omega = 125.04 - (1934.136 * t);
+    const double lambda = l0 + c - 0.00569 - (0.00478 * sin(rad(omega)));
+    const double eps0 =
+        23.0 + ((26.0 + ((21.448 - (t * (46.815 + (t * (0.00059 - (t * 0.001813)))))) / 60.0))
+                / 60.0);
+    const double eps = eps0 + (0.00256 * cos(rad(omega)));
+    const double decl = asin(sin(rad(eps)) * sin(rad(lambda)));
+    const double y = tan(rad(eps / 2.0)) * tan(rad(eps / 2.0));
+    const double eot_min = 4.0 * deg((y * sin(rad(2.0 * l0))) - (2.0 * e * sin(rad(m)))
+                                     + (4.0 * e * y * sin(rad(m)) * cos(rad(2.0 * l0)))
+                                     - (0.5 * y * y * sin(rad(4.0 * l0)))
+                                     - (1.25 * e * e * sin(rad(2.0 * m))));
+
+    const double minutes = (double)(utc % 86400) / 60.0;
+    const double ha = rad(((minutes + eot_min + (4.0 * site.longitude_deg)) / 4.0) - 180.0);
+    const double lat = rad(site.latitude_deg);
+    SunEphemeris::Position p;
+    p.elevation_deg =
+        (float)deg(asin((sin(lat) * sin(decl)) + (cos(lat) * cos(decl) * cos(ha))));
+    p.azimuth_deg = (float)fmod(
+        deg(atan2(sin(ha), (cos(ha) * sin(lat)) - (tan(decl) * cos(lat)))) + 540.0, 360.0);
+    return p;
+}
+
+static float azimuthError(float a, float b) {
+    const float d = fabsf(a - b);
+    return (d > 180.0f) ? (360.0f - d) : d;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Every 17 minutes of daylight (a step that walks through the day) over
+// seven years. Azimuth error is scaled by cos(elevation), the angle it
+// makes on the sky; near the zenith raw azimuth swings fast, and float asin
+// loses a few hundredths of elevation.
+static void test_position_matches_reference() {
+    float worst_el = 0.0f;
+    float worst_az = 0.0f;
+    for (const Site& site : SITES) {
+        const SunEphemeris::Config cfg = {site.latitude_deg, site.longitude_deg};
+        SunEphemeris ephemeris(cfg);
+        float site_el = 0.0f;
+        float site_az = 0.0f;
+        unsigned points = 0;
+        for (time_t utc = START_UTC; utc < START_UTC + (YEARS * 365L * 86400L); utc += 17 * 60) {
+            const SunEphemeris::Position ref = reference(site, utc);
+            if (ref.elevation_deg < 0.0f) {
+                continue;
+            }
+            const SunEphemeris::Position p = ephemeris.position(utc);
+            site_el = fmaxf(site_el, fabsf(p.elevation_deg - ref.elevation_deg));
+            site_az = fmaxf(site_az, azimuthError(p.azimuth_deg, ref.azimuth_deg) *
+                                       cosf(ref.elevation_deg * (float)PI_D / 180.0f));
+            points++;
+        }
+        char line[96];
+        snprintf(line, sizeof(line), "%s: %u points, worst elevation %.3f deg, azimuth %.3f deg",
+                 site.name, points, site_el, site_az);
+        TEST_MESSAGE(line);
+        worst_el = fmaxf(worst_el, site_el);
+        worst_az = fmaxf(worst_az, site_az);
+    }
+    TEST_ASSERT_LESS_THAN_FLOAT(0.1f, worst_el);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.05f, worst_az);
+}
+
+// Rates from the forward difference match the reference's over a minute.
+static void test_rates_match_reference() {
+    const Site& site = SITES[1];
+    const SunEphemeris::Config cfg = {site.latitude_deg, site.longitude_deg};
+    SunEphemeris ephemeris(cfg);
+    const time_t noonish = 1781006400; // 2026-06-09 12:00 UTC
+    for (time_t utc = noonish - (4 * 3600); utc <= noonish + (4 * 3600); utc += 3600) {
+        const SunEphemeris::Rates r = ephemeris.rates(utc);
+        const SunEphemeris::Position a = reference(site, utc);
+        const SunEphemeris::Position b = reference(site, utc + 60);
+        TEST_ASSERT_FLOAT_WITHIN(0.0002f, (b.elevation_deg - a.elevation_deg) / 60.0f,
+                                 r.elevation_deg_per_s);
+        TEST_ASSERT_FLOAT_WITHIN(0.0002f, (b.azimuth_deg - a.azimuth_deg) / 60.0f,
+                                 r.azimuth_deg_per_s);
+    }
+}
+
+// Per-call cost on the host: once per second for a day, the day terms
+// refilled once; and every call on a new day, refilling each time.
+static void test_call_cost() {
+    const SunEphemeris::Config cfg = {SITES[1].latitude_deg, SITES[1].longitude_deg};
+    SunEphemeris ephemeris(cfg);
+    const time_t day = 1781049600; // 2026-06-10
+    float sink = 0.0f;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (time_t utc = day; utc < day + 86400; ++utc) {
+        sink += ephemeris.position(utc).elevation_deg;
+    }
+    const auto mid = std::chrono::steady_clock::now();
+    for (int i = 0; i < 20000; ++i) {
+        sink += ephemeris.position(day + ((time_t)i * 86400) + 43200).elevation_deg;
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const double same_day_ns =
+        (double)std::chrono::duration_cast<std::chrono::nanoseconds>(mid - start).count() / 86400.0;
+    const double new_day_ns =
+        (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - mid).count() / 20000.0;
+    char line[128];
+    snprintf(line, sizeof(line), "position(): %.0f ns/call within a day, %.0f ns/call on a new day",
+             same_day_ns, new_day_ns);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_TRUE(isfinite(sink));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_position_matches_reference);
+    RUN_TEST(test_rates_match_reference);
+    RUN_TEST(test_call_cost);
+    return UNITY_END();
+}
@@ -0,0 +1,132 @@
+#include <unity.h>
+
+#include <chrono>
+#include <stdio.h>
+
+#include "track/TrackingCoordinator.h"
+#include "track/TrackingGroup.h"
+
+#include "../TestPlant.h"
+
+// A row of axes on balanced light, every one inside its deadband: the group
+// holds, blocks and keeps extending the blocks, which is its steady state
+// through most of a clear day.
+static const unsigned long TICKS = 2000000;
+
+template <size_t N>
+struct Rig {
+    TrackingUnit* units[N];
+
+    Rig() {
+        HostPlatform::setMillis(0);
+        for (size_t i = 0; i < N; i++) {
+            HostPlatform::analogPins()[2 * i] = 2000;
+            HostPlatform::analogPins()[2 * i + 1] = 2000;
+            units[i] = new BasicTrackingUnit<>(TestPlant::sensorConfig(2 * (int)i, 2 * (int)i + 1),
+                                               TestPlant::trackerConfig(),
+                                               TestPlant::motorConfig(0.5f, 0.8f, 200));
+            units[i]->begin();
+        }
+        // One window each, so every axis has a diff.
+        for (unsigned long ms = 1; ms <= 200; ++ms) {
+            HostPlatform::setMillis(ms);
+            for (size_t i = 0; i < N; i++) {
+                units[i]->tick(ms);
+            }
+        }
+    }
+
+    ~Rig() {
+        for (size_t i = 0; i < N; i++) {
+            delete units[i];
+        }
+    }
+};
+
+template <size_t N>
+static typename TrackingGroup<N>::Config groupConfig(typename TrackingGroup<N>::Policy policy) {
+    return {policy, 1500, 10000, true, 0.8f, 2.0f, 2000, 120000, 500};
+}
+
+struct Bench {
+    double ns_per_tick;
+    size_t blocked;
+};
+
+template <size_t N>
+static Bench bench(typename TrackingGroup<N>::Policy policy) {
+    Rig<N> rig;
+    TrackingGroup<N> group(groupConfig<N>(policy), rig.units);
+    group.setEnabled(true);
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned long t = 0; t < TICKS; ++t) {
+        group.tick(1000 + t);
+    }
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    Bench out = {(double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() /
+                     (double)TICKS,
+                 group.blockedCount()};
+    return out;
+}
+
+template <size_t N>
+static Bench row(const char* label, typename TrackingGroup<N>::Policy policy) {
+    const Bench b = bench<N>(policy);
+    char line[96];
+    snprintf(line, sizeof(line), "%s N=%2u: %6.1f ns/tick, %5.2f ns/axis",
+             label, (unsigned)N, b.ns_per_tick, b.ns_per_tick / (double)N);
+    TEST_MESSAGE(line);
+    return b;
+}
+
+void setUp() {}
+void tearDown() {}
+
+template <size_t N>
+static typename TrackingGroup<N>::Policy policy(bool staggered) {
+    return staggered ? TrackingGroup<N>::Policy::Staggered : TrackingGroup<N>::Policy::AllInDeadband;
+}
+
+// Per-axis cost at 16 axes stays within twice that at 2.
+static void scaling(const char* label, bool staggered) {
+    const Bench b2 = row<2>(label, policy<2>(staggered));
+    const Bench b4 = row<4>(label, policy<4>(staggered));
+    const Bench b8 = row<8>(label, policy<8>(staggered));
+    const Bench b16 = row<16>(label, policy<16>(staggered));
+    TEST_ASSERT_EQUAL_UINT(2, b2.blocked);
+    TEST_ASSERT_EQUAL_UINT(4, b4.blocked);
+    TEST_ASSERT_EQUAL_UINT(8, b8.blocked);
+    TEST_ASSERT_EQUAL_UINT(16, b16.blocked);
+    TEST_ASSERT_LESS_THAN_FLOAT((float)b2.ns_per_tick, (float)(b16.ns_per_tick / 16.0));
+}
+
+static void test_all_in_deadband_scales_linearly() { scaling("all-in-deadband", false); }
+
+static void test_staggered_scales_linearly() { scaling("staggered", true); }
+
+// The coordinator is the two-axis group: the same block decisions.
+static void test_coordinator_matches_group() {
+    Rig<2> rig_group;
+    TrackingGroup<2> group(groupConfig<2>(TrackingGroup<2>::Policy::AllInDeadband), rig_group.units);
+    Rig<2> rig_coord;
+    const TrackingCoordinator::Config cfg = {
+        1500, 10000, TrackingCoordinator::Mode::Independent, 300, true, 0.8f, 2.0f, 2000, 120000};
+    TrackingCoordinator coordinator(cfg, *rig_coord.units[0], *rig_coord.units[1]);
+    group.setEnabled(true);
+    coordinator.setEnabled(true);
+    for (unsigned long ms = 1000; ms < 60000; ++ms) {
+        group.tick(ms);
+        coordinator.tick(ms);
+        TEST_ASSERT_EQUAL(group.isBlocked(0), coordinator.isBlocked());
+    }
+    TEST_ASSERT_GREATER_THAN(0U, coordinator.blocks());
+    TEST_ASSERT_EQUAL_UINT32(group.blocks(), coordinator.blocks());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_all_in_deadband_scales_linearly);
+    RUN_TEST(test_staggered_scales_linearly);
+    RUN_TEST(test_coordinator_matches_group);
+    return UNITY_END();
+}
@@ -0,0 +1,114 @@
+#include <unity.h>
+
+#include <math.h>
+#include <stdio.h>
+
+#include "../TestPlant.h"
+
+// Host replay of a cloudy ten minutes on one BangBang axis of TestPlant. Every 40 s a cloud dims the sky to 30 % for 8 s; its
+// edge reaches LDR A 400 ms before B and leaves it 400 ms later, and the
+// broken light under it adds +-10 % of per-read flutter, so the diff swings
+// while the sun itself only moves 0.02 deg/s. Reads carry +-5 counts of ADC
+// noise.
+static const int PIN_A = 33;
+static const int PIN_B = 35;
+static const unsigned long DURATION_MS = 600000;
+static const unsigned long CLOUD_PERIOD_MS = 40000;
+static const unsigned long CLOUD_START_MS = 20000;
+static const unsigned long CLOUD_MS = 8000;
+static const unsigned long EDGE_LAG_MS = 400;
+static const unsigned CLOUDS = (DURATION_MS - CLOUD_START_MS) / CLOUD_PERIOD_MS + 1;
+
+// Sky factor under a cloud whose edge reaches this LDR `lag_ms` late.
+static float cloud(TestPlant::Noise& noise, unsigned long ms, unsigned long lag_ms) {
+    if (ms < CLOUD_START_MS + lag_ms) {
+        return 1.0f;
+    }
+    const unsigned long phase = (ms - CLOUD_START_MS - lag_ms) % CLOUD_PERIOD_MS;
+    return (phase < CLOUD_MS) ? 0.3f * (1.0f + (float)noise.next(100) / 1000.0f) : 1.0f;
+}
+
+struct Result {
+    uint32_t motor_on_ms;
+    uint32_t saved_ms;
+    uint32_t events;
+    float worst_clear_error_deg;
+};
+
+static Result run(bool hold) {
+    TestPlant::Noise noise;
+    HostPlatform::setMillis(0);
+    TrackerController::Config tracker_cfg = TestPlant::trackerConfig();
+    tracker_cfg.transient.enabled = hold;
+    LightSensorPair sensors(TestPlant::sensorConfig(PIN_A, PIN_B));
+    MotorDriver motor(TestPlant::motorConfig(0.0f, 0.8f, 100));
+    TrackerController tracker(tracker_cfg, sensors, motor);
+    motor.begin();
+
+    double sun = 0.0;
+    TestPlant::Axis axis = {0.0, 0.0};
+    Result r = {0, 0, 0, 0.0f};
+    for (unsigned long ms = 1; ms <= DURATION_MS; ++ms) {
+        HostPlatform::setMillis(ms);
+        sun += 0.02 / 1000.0;
+        const float sky_a = cloud(noise, ms, 0);
+        const float sky_b = cloud(noise, ms, EDGE_LAG_MS);
+        HostPlatform::analogPins()[PIN_A] =
+            TestPlant::pairCount(2000.0 * sky_a, sun - axis.pos, +1) + noise.next(5);
+        HostPlatform::analogPins()[PIN_B] =
+            TestPlant::pairCount(2000.0 * sky_b, sun - axis.pos, -1) + noise.next(5);
+
+        sensors.setMotorActive(motor.isDriving());
+        sensors.tick(ms);
+        tracker.tick(ms);
+        motor.tick(ms);
+
+        axis.move(motor.getAppliedNorm());
+
+        // Clear sky, 5 s after a cloud has gone: the axis must be on the sun.
+        const unsigned long phase = (ms >= CLOUD_START_MS) ? (ms - CLOUD_START_MS) % CLOUD_PERIOD_MS : 0;
+        if (ms > CLOUD_START_MS && phase > CLOUD_MS + EDGE_LAG_MS + 5000) {
+            r.worst_clear_error_deg = max(r.worst_clear_error_deg, (float)fabs(sun - axis.pos));
+        }
+    }
+    r.motor_on_ms = motor.motorOnMs();
+    r.saved_ms = tracker.transientSavedMotorMs();
+    r.events = tracker.transientEvents();
+    return r;
+}
+
+static void report(const char* label, const Result& r) {
+    char line[160];
+    snprintf(line, sizeof(line),
+             "%s: motor on %lu ms, saved %lu ms, %lu events, clear-sky worst %.2f deg",
+             label, (unsigned long)r.motor_on_ms, (unsigned long)r.saved_ms,
+             (unsigned long)r.events, r.worst_clear_error_deg);
+    TEST_MESSAGE(line);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_clouds_are_held() {
+    const Result chase = run(false);
+    const Result held = run(true);
+    report("chasing", chase);
+    report("holding", held);
+    TEST_ASSERT_EQUAL_UINT32(CLOUDS, held.events);
+    TEST_ASSERT_GREATER_THAN(0U, held.saved_ms);
+    TEST_ASSERT_LESS_THAN(chase.motor_on_ms / 2, held.motor_on_ms);
+}
+
+// A fresh window after each event: the axis is back within the lock band
+// 5 s after every cloud.
+static void test_tracking_resumes_after_hold() {
+    const Result held = run(true);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.6f, held.worst_clear_error_deg);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_clouds_are_held);
+    RUN_TEST(test_tracking_resumes_after_hold);
+    return UNITY_END();
+}
@@ -0,0 +1,149 @@
+#include <unity.h>
+
+#include <math.h>
+#include <stdio.h>
+
+#include "track/TrackingCoordinator.h"
+#include "track/TrackingUnit.h"
+
+#include "../TestPlant.h"
+
+// H and V axes on TestPlant (2 % diff per degree, 6 deg/s at full duty,
+// 0.3 dead zone, 100 ms speed lag), BangBang, a
+// diagonal step of 6 deg H by 2.5 deg V. The pwm threshold is above both
+// component diffs, so either axis drives at pwm_min and a kick shows up as
+// duty at kick_norm.
+static const int PIN_HA = 32;
+static const int PIN_HB = 33;
+static const int PIN_VA = 34;
+static const int PIN_VB = 35;
+static const float KICK = 0.8f;
+static const unsigned long KICK_MS = 200;
+static const unsigned long VECTOR_PERIOD_MS = 300;
+
+static TrackerController::Config trackerConfig() {
+    TrackerController::Config cfg = TestPlant::trackerConfig();
+    cfg.diff_pwm_threshold = 40.0f;
+    cfg.hunting.enabled = true;
+    return cfg;
+}
+
+static MotorDriver::Config motorConfig() {
+    return TestPlant::motorConfig(0.5f, KICK, KICK_MS);
+}
+
+static void setPair(int pin_a, int pin_b, double sun, const TestPlant::Axis& axis) {
+    HostPlatform::analogPins()[pin_a] = TestPlant::pairCount(2000.0, sun - axis.pos, +1);
+    HostPlatform::analogPins()[pin_b] = TestPlant::pairCount(2000.0, sun - axis.pos, -1);
+}
+
+struct Result {
+    unsigned long converge_ms;
+    uint32_t kick_ms_v;
+    uint32_t duty_ms;
+    float final_error_deg;
+};
+
+static Result run(TrackingCoordinator::Mode mode) {
+    HostPlatform::setMillis(0);
+    BasicTrackingUnit<> unit_h(TestPlant::sensorConfig(PIN_HA, PIN_HB), trackerConfig(), motorConfig());
+    BasicTrackingUnit<> unit_v(TestPlant::sensorConfig(PIN_VA, PIN_VB), trackerConfig(), motorConfig());
+    const TrackingCoordinator::Config cfg = {
+        1500, 10000, mode, VECTOR_PERIOD_MS, false, 0.8f, 2.0f, 2000, 120000};
+    TrackingCoordinator coordinator(cfg, unit_h, unit_v);
+    unit_h.begin();
+    unit_v.begin();
+    coordinator.setEnabled(true);
+
+    const double sun_h = 6.0;
+    const double sun_v = 2.5;
+    TestPlant::Axis h = {0.0, 0.0};
+    TestPlant::Axis v = {0.0, 0.0};
+    Result r = {0, 0, 0, 0.0f};
+    for (unsigned long ms = 1; ms <= 20000; ++ms) {
+        HostPlatform::setMillis(ms);
+        setPair(PIN_HA, PIN_HB, sun_h, h);
+        setPair(PIN_VA, PIN_VB, sun_v, v);
+        coordinator.tick(ms);
+        if (!coordinator.ownsTargets()) {
+            unit_h.clearTargetOverride();
+            unit_v.clearTargetOverride();
+        }
+        unit_h.tick(ms);
+        unit_v.tick(ms);
+        h.move(unit_h.appliedNorm());
+        v.move(unit_v.appliedNorm());
+
+        if (fabsf(unit_v.appliedNorm()) >= KICK - 0.001f) {
+            r.kick_ms_v++;
+        }
+        const double err = sqrt(((sun_h - h.pos) * (sun_h - h.pos)) +
+                                ((sun_v - v.pos) * (sun_v - v.pos)));
+        if (err > 0.5) {
+            r.converge_ms = ms;
+        }
+        r.final_error_deg = (float)err;
+    }
+    r.duty_ms = unit_h.motorDutyMs() + unit_v.motorDutyMs();
+    return r;
+}
+
+static void report(const char* label, const Result& r) {
+    char line[160];
+    snprintf(line, sizeof(line),
+             "%s: converged %lu ms, duty %lu ms, V at kick %lu ms, final %.2f deg",
+             label, r.converge_ms, (unsigned long)r.duty_ms, (unsigned long)r.kick_ms_v,
+             r.final_error_deg);
+    TEST_MESSAGE(line);
+}
+
+void setUp() {}
+void tearDown() {}
+
+// The minor axis is switched on every vector period. Each on-phase used to
+// start its own kick, so V spent its whole on-time at kick_norm.
+static void test_minor_axis_kicks_once() {
+    const Result independent = run(TrackingCoordinator::Mode::Independent);
+    const Result vector = run(TrackingCoordinator::Mode::Vector);
+    report("independent", independent);
+    report("vector", vector);
+    TEST_ASSERT_LESS_OR_EQUAL(KICK_MS + 20, vector.kick_ms_v);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.5f, vector.final_error_deg);
+    TEST_ASSERT_LESS_OR_EQUAL(independent.duty_ms + independent.duty_ms / 5, vector.duty_ms);
+}
+
+// The logged target and the command hunting/backlash see are what the
+// motor was given, not the controller's own choice.
+static void test_override_is_the_reported_command() {
+    HostPlatform::setMillis(0);
+    HostPlatform::analogPins()[PIN_HA] = 2000;
+    HostPlatform::analogPins()[PIN_HB] = 2000;
+    BasicTrackingUnit<> unit(TestPlant::sensorConfig(PIN_HA, PIN_HB), trackerConfig(), motorConfig());
+    unit.begin();
+    unit.setTargetOverride(0.5f);
+    TrackingUnit::LogSample log;
+    unsigned windows = 0;
+    for (unsigned long ms = 1; ms <= 1000; ++ms) {
+        HostPlatform::setMillis(ms);
+        unit.tick(ms);
+        if (unit.consumeLog(log)) {
+            windows++;
+            TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.5f, log.target_norm);
+        }
+    }
+    TEST_ASSERT_GREATER_THAN(0U, windows);
+    unit.clearTargetOverride();
+    for (unsigned long ms = 1001; ms <= 1200; ++ms) {
+        HostPlatform::setMillis(ms);
+        unit.tick(ms);
+    }
+    TEST_ASSERT_TRUE(unit.consumeLog(log));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, log.target_norm);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_minor_axis_kicks_once);
+    RUN_TEST(test_override_is_the_reported_command);
+    return UNITY_END();
+}